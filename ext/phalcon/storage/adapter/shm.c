@@ -0,0 +1,1056 @@
+/**
+ * This file is part of the Phalcon.
+ *
+ * (c) Phalcon Team <team@phalcon.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php.h"
+#include "php_phalcon.h"
+
+#ifndef PHP_WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * The table lives in a file mapped with MAP_SHARED by every process using it:
+ *
+ *   header | buckets | pages
+ *
+ * A key hashes to one bucket of PHALCON_SHM_SLOTS slots (open addressing
+ * inside the bucket) and never leaves it, so every operation on a key only
+ * touches one bucket. Each bucket has a sequence lock: writers make it odd
+ * while they change the bucket, readers copy what they need without taking
+ * any lock and retry when the sequence changed meanwhile.
+ *
+ * Keys and values are stored together in chunks handed out by a slab
+ * allocator: pages of PHALCON_SHM_PAGE bytes are split in chunks of one size
+ * class (64 bytes to one page, in powers of two) the first time the class
+ * needs memory, and freed chunks go back to the free list of their class.
+ *
+ * When a bucket is full, or a class has no free chunk and no page is left,
+ * an item is evicted with the CLOCK algorithm: reads set the referenced bit
+ * of an item, the hand clears it and evicts the first item found without it.
+ * Expired items are always evicted first. A class without any item to evict
+ * takes a page from another class, evicting the items stored in it.
+ *
+ * Locks are spin locks with a bounded number of attempts. A lock word holds
+ * the pid of its owner next to the sequence, so once the attempts are spent
+ * a lock held by a process that does not exist anymore is taken over. The
+ * slots of a bucket taken over are emptied, as the dead process may have
+ * left them half written. The allocator writes the free lists in an order
+ * where a process dying at any point only loses chunks, which come back when
+ * their page is given to another class, so its lock is taken over as is.
+ * Every process using a file must see the pids of the others, i.e. run in
+ * the same pid namespace.
+ */
+
+#define PHALCON_SHM_MAGIC     0x4D534850 /* "PHSM" */
+#define PHALCON_SHM_VERSION   2
+#define PHALCON_SHM_SLOTS     8
+#define PHALCON_SHM_CLASSES   15
+#define PHALCON_SHM_MIN_CHUNK 64
+#define PHALCON_SHM_PAGE      (PHALCON_SHM_MIN_CHUNK << (PHALCON_SHM_CLASSES - 1))
+#define PHALCON_SHM_MIN_SIZE  (4 * PHALCON_SHM_PAGE)
+#define PHALCON_SHM_BUCKET_BYTES 4096
+#define PHALCON_SHM_MAPPINGS  16
+#define PHALCON_SHM_SPINS     100000
+
+#define PHALCON_SHM_STRING    0
+#define PHALCON_SHM_LONG      1
+
+/* Lock words: sequence in the low 32 bits, pid of the owner in the high ones */
+#define PHALCON_SHM_SEQ(word)      ((uint32_t) (word))
+#define PHALCON_SHM_OWNER(word)    ((pid_t) ((word) >> 32))
+#define PHALCON_SHM_WORD(seq, pid) (((uint64_t) (uint32_t) (pid) << 32) | (uint32_t) (seq))
+
+#ifndef PHP_WIN32
+
+typedef struct _phalcon_shm_slot {
+	uint64_t hash;       /* 0 when the slot is empty */
+	uint64_t offset;     /* chunk with the key followed by the value */
+	int64_t  expires;    /* unix timestamp */
+	uint32_t key_len;
+	uint32_t value_len;
+	uint8_t  type;       /* PHALCON_SHM_STRING or PHALCON_SHM_LONG */
+	uint8_t  cls;        /* size class of the chunk */
+	uint8_t  referenced; /* CLOCK bit, set by the readers */
+	uint8_t  padding[5];
+} phalcon_shm_slot;
+
+typedef struct _phalcon_shm_bucket {
+	uint64_t seq;        /* sequence lock, odd while a writer holds it */
+	uint32_t hand;       /* CLOCK hand of the slots */
+	uint32_t padding;
+	phalcon_shm_slot slots[PHALCON_SHM_SLOTS];
+} phalcon_shm_bucket;
+
+typedef struct _phalcon_shm_header {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t size;
+	uint64_t buckets;
+	uint64_t classes;    /* offset of the size class of every page */
+	uint64_t arena;      /* offset of the first page */
+	uint64_t next_page;  /* offset of the first page not split yet */
+	uint64_t free_list[PHALCON_SHM_CLASSES];
+	uint64_t lock;       /* allocator lock, odd while held */
+	uint32_t clock;      /* CLOCK hand of the buckets, for the allocator */
+	uint32_t page_hand;  /* next page given to another class */
+} phalcon_shm_header;
+
+typedef struct _phalcon_shm_mapping {
+	char          *path;
+	unsigned char *base;
+	size_t         size;
+} phalcon_shm_mapping;
+
+/* Mappings of this process, a handle is an index in this array */
+static phalcon_shm_mapping phalcon_shm_mappings[PHALCON_SHM_MAPPINGS];
+static uint32_t phalcon_shm_mappings_count = 0;
+static uint64_t phalcon_shm_mappings_lock = 0;
+
+static inline void phalcon_shm_relax(unsigned long spins)
+{
+	if ((spins & 63) == 63) {
+		sched_yield();
+	}
+}
+
+static int phalcon_shm_trylock(uint64_t *seq)
+{
+	uint64_t current = __atomic_load_n(seq, __ATOMIC_RELAXED);
+
+	if (current & 1) {
+		return 0;
+	}
+
+	if (!__atomic_compare_exchange_n(seq, &current, PHALCON_SHM_WORD(PHALCON_SHM_SEQ(current) + 1, getpid()), 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		return 0;
+	}
+
+	/* The odd sequence must be visible before the changes */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	return 1;
+}
+
+/**
+ * Takes over a lock whose owner died. The sequence stays odd, the new owner
+ * releases it as usual
+ */
+static int phalcon_shm_steal(uint64_t *seq)
+{
+	uint64_t current = __atomic_load_n(seq, __ATOMIC_RELAXED);
+	pid_t owner = PHALCON_SHM_OWNER(current);
+
+	if (!(current & 1) || owner <= 0 || owner == getpid()) {
+		return 0;
+	}
+
+	if (kill(owner, 0) == 0 || errno != ESRCH) {
+		return 0;
+	}
+
+	if (!__atomic_compare_exchange_n(seq, &current, PHALCON_SHM_WORD(PHALCON_SHM_SEQ(current), getpid()), 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+		return 0;
+	}
+
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	return 1;
+}
+
+/**
+ * Returns 1 when the lock is acquired, 2 when it is taken over from a dead
+ * process and 0 when it is still held after the attempts
+ */
+static int phalcon_shm_lock(uint64_t *seq)
+{
+	unsigned long spins;
+
+	for (spins = 0; spins < PHALCON_SHM_SPINS; spins++) {
+		if (phalcon_shm_trylock(seq)) {
+			return 1;
+		}
+		phalcon_shm_relax(spins);
+	}
+
+	return phalcon_shm_steal(seq) ? 2 : 0;
+}
+
+static inline void phalcon_shm_unlock(uint64_t *seq)
+{
+	__atomic_store_n(seq, PHALCON_SHM_WORD(PHALCON_SHM_SEQ(*seq) + 1, 0), __ATOMIC_RELEASE);
+}
+
+/**
+ * Locks a bucket, emptying its slots when the lock is taken over: their
+ * chunks are lost until their page is given to another class
+ */
+static int phalcon_shm_bucket_lock(phalcon_shm_bucket *bucket)
+{
+	int i;
+
+	switch (phalcon_shm_lock(&bucket->seq)) {
+		case 1:
+			return 1;
+
+		case 2:
+			for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+				bucket->slots[i].hash = 0;
+			}
+			return 1;
+	}
+
+	return 0;
+}
+
+static phalcon_shm_mapping *phalcon_shm_mapping_get(zval *handle)
+{
+	if (Z_TYPE_P(handle) != IS_LONG || Z_LVAL_P(handle) < 0) {
+		return NULL;
+	}
+
+	if (Z_LVAL_P(handle) >= (zend_long) __atomic_load_n(&phalcon_shm_mappings_count, __ATOMIC_ACQUIRE)) {
+		return NULL;
+	}
+
+	return &phalcon_shm_mappings[Z_LVAL_P(handle)];
+}
+
+static inline uint64_t phalcon_shm_hash(zend_string *key)
+{
+	uint64_t hash = (uint64_t) zend_inline_hash_func(ZSTR_VAL(key), ZSTR_LEN(key));
+
+	/* 0 marks the empty slots */
+	return hash ? hash : 1;
+}
+
+static inline phalcon_shm_bucket *phalcon_shm_bucket_get(phalcon_shm_mapping *mapping, uint64_t hash)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	phalcon_shm_bucket *buckets = (phalcon_shm_bucket *) (mapping->base + sizeof(phalcon_shm_header));
+
+	return &buckets[hash % header->buckets];
+}
+
+static inline size_t phalcon_shm_chunk_size(uint8_t cls)
+{
+	return (size_t) PHALCON_SHM_MIN_CHUNK << cls;
+}
+
+static uint8_t phalcon_shm_class(size_t length)
+{
+	uint8_t cls = 0;
+
+	while (phalcon_shm_chunk_size(cls) < length) {
+		cls++;
+	}
+
+	return cls;
+}
+
+/**
+ * Checks that a slot copied without the lock points to a chunk of the arena,
+ * so reading it cannot go outside the mapping
+ */
+static int phalcon_shm_slot_valid(phalcon_shm_mapping *mapping, phalcon_shm_slot *slot)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	uint64_t length = (uint64_t) slot->key_len + slot->value_len;
+
+	if (slot->cls >= PHALCON_SHM_CLASSES || length > phalcon_shm_chunk_size(slot->cls)) {
+		return 0;
+	}
+
+	return slot->offset >= header->arena && slot->offset + length <= mapping->size;
+}
+
+static int phalcon_shm_slot_matches(phalcon_shm_mapping *mapping, phalcon_shm_slot *slot, uint64_t hash, zend_string *key)
+{
+	if (slot->hash != hash || slot->key_len != ZSTR_LEN(key)) {
+		return 0;
+	}
+
+	if (!phalcon_shm_slot_valid(mapping, slot)) {
+		return 0;
+	}
+
+	return memcmp(mapping->base + slot->offset, ZSTR_VAL(key), ZSTR_LEN(key)) == 0;
+}
+
+static phalcon_shm_slot *phalcon_shm_find(phalcon_shm_mapping *mapping, phalcon_shm_bucket *bucket, uint64_t hash, zend_string *key)
+{
+	int i;
+
+	for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+		if (phalcon_shm_slot_matches(mapping, &bucket->slots[i], hash, key)) {
+			return &bucket->slots[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Returns a chunk to the free list of its class. The allocator lock must be
+ * held. The slot is emptied first, so a chunk is never both used and free
+ */
+static void phalcon_shm_free(phalcon_shm_mapping *mapping, phalcon_shm_slot *slot)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+
+	slot->hash = 0;
+
+	*((uint64_t *) (mapping->base + slot->offset)) = header->free_list[slot->cls];
+	header->free_list[slot->cls] = slot->offset;
+}
+
+/**
+ * Evicts an item of a class from the buckets other than the one being
+ * written, moving the CLOCK hand of the buckets. The allocator lock must be
+ * held, so the buckets are only tried, never waited for
+ */
+static int phalcon_shm_evict(phalcon_shm_mapping *mapping, uint8_t cls, phalcon_shm_bucket *owner)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	phalcon_shm_bucket *buckets = (phalcon_shm_bucket *) (mapping->base + sizeof(phalcon_shm_header));
+	phalcon_shm_bucket *bucket;
+	phalcon_shm_slot *slot;
+	uint64_t visited;
+	int64_t now = (int64_t) time(NULL);
+	int i, evicted = 0;
+
+	for (visited = 0; visited < 2 * header->buckets && !evicted; visited++) {
+		bucket = &buckets[header->clock % header->buckets];
+		header->clock = (uint32_t) ((header->clock + 1) % header->buckets);
+
+		if (bucket == owner || !phalcon_shm_trylock(&bucket->seq)) {
+			continue;
+		}
+
+		for (i = 0; i < PHALCON_SHM_SLOTS && !evicted; i++) {
+			slot = &bucket->slots[i];
+			if (!slot->hash || slot->cls != cls) {
+				continue;
+			}
+
+			if (slot->expires < now || !__atomic_load_n(&slot->referenced, __ATOMIC_RELAXED)) {
+				phalcon_shm_free(mapping, slot);
+				evicted = 1;
+			} else {
+				__atomic_store_n(&slot->referenced, 0, __ATOMIC_RELAXED);
+			}
+		}
+
+		phalcon_shm_unlock(&bucket->seq);
+	}
+
+	return evicted;
+}
+
+/**
+ * Splits a page in chunks of a class. The allocator lock must be held. The
+ * class of the page is set first, so the chunks already in the free list
+ * are found when the page is given to another class
+ */
+static void phalcon_shm_split(phalcon_shm_mapping *mapping, uint64_t page, uint8_t cls)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	size_t chunk = phalcon_shm_chunk_size(cls);
+	uint64_t offset;
+
+	mapping->base[header->classes + (page - header->arena) / PHALCON_SHM_PAGE] = cls;
+
+	for (offset = page + PHALCON_SHM_PAGE - chunk; ; offset -= chunk) {
+		*((uint64_t *) (mapping->base + offset)) = header->free_list[cls];
+		header->free_list[cls] = offset;
+		if (offset == page) {
+			break;
+		}
+	}
+}
+
+/**
+ * Gives a page of another class to a class, evicting the items stored in the
+ * page. Gives up if a bucket is busy: the items already evicted stay free
+ * chunks of their class. The allocator lock must be held, so no chunk of the
+ * page can be handed out meanwhile
+ */
+static int phalcon_shm_reassign(phalcon_shm_mapping *mapping, uint8_t cls, phalcon_shm_bucket *owner)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	phalcon_shm_bucket *buckets = (phalcon_shm_bucket *) (mapping->base + sizeof(phalcon_shm_header));
+	phalcon_shm_slot *slot;
+	uint64_t pages = (header->next_page - header->arena) / PHALCON_SHM_PAGE;
+	uint64_t b, page, *link;
+	uint8_t old;
+	int i;
+
+	if (!pages) {
+		return 0;
+	}
+
+	page = header->arena + (header->page_hand % pages) * PHALCON_SHM_PAGE;
+	old  = mapping->base[header->classes + (page - header->arena) / PHALCON_SHM_PAGE];
+
+	header->page_hand = (uint32_t) ((header->page_hand + 1) % pages);
+
+	if (old == cls) {
+		return 0;
+	}
+
+	for (b = 0; b < header->buckets; b++) {
+		/* The caller holds its own bucket */
+		if (&buckets[b] != owner && !phalcon_shm_trylock(&buckets[b].seq)) {
+			return 0;
+		}
+
+		for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+			slot = &buckets[b].slots[i];
+			if (slot->hash && slot->offset >= page && slot->offset < page + PHALCON_SHM_PAGE) {
+				phalcon_shm_free(mapping, slot);
+			}
+		}
+
+		if (&buckets[b] != owner) {
+			phalcon_shm_unlock(&buckets[b].seq);
+		}
+	}
+
+	/* Every chunk of the page is free now, take them out of the old class */
+	link = &header->free_list[old];
+	while (*link) {
+		if (*link >= page && *link < page + PHALCON_SHM_PAGE) {
+			*link = *((uint64_t *) (mapping->base + *link));
+		} else {
+			link = (uint64_t *) (mapping->base + *link);
+		}
+	}
+
+	phalcon_shm_split(mapping, page, cls);
+
+	return 1;
+}
+
+/**
+ * Returns the offset of a free chunk of a class, or 0 if there is no memory
+ * left. The allocator lock must be held
+ */
+static uint64_t phalcon_shm_alloc(phalcon_shm_mapping *mapping, uint8_t cls, phalcon_shm_bucket *owner)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	uint64_t offset;
+
+	if (!header->free_list[cls]) {
+		if (header->next_page + PHALCON_SHM_PAGE <= header->size) {
+			/* Never split twice, even if this process dies while splitting */
+			offset = header->next_page;
+			header->next_page += PHALCON_SHM_PAGE;
+			phalcon_shm_split(mapping, offset, cls);
+		} else if (!phalcon_shm_evict(mapping, cls, owner) && !phalcon_shm_reassign(mapping, cls, owner)) {
+			return 0;
+		}
+	}
+
+	offset = header->free_list[cls];
+	header->free_list[cls] = *((uint64_t *) (mapping->base + offset));
+
+	return offset;
+}
+
+/**
+ * Returns the slot receiving a new key: an empty one, an expired one or the
+ * one chosen by the CLOCK hand of the bucket. The bucket lock must be held
+ */
+static phalcon_shm_slot *phalcon_shm_victim(phalcon_shm_bucket *bucket, int64_t now)
+{
+	phalcon_shm_slot *slot;
+	int i;
+
+	for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+		if (!bucket->slots[i].hash) {
+			return &bucket->slots[i];
+		}
+	}
+
+	for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+		if (bucket->slots[i].expires < now) {
+			return &bucket->slots[i];
+		}
+	}
+
+	for (i = 0; i < 2 * PHALCON_SHM_SLOTS; i++) {
+		slot = &bucket->slots[bucket->hand];
+		bucket->hand = (bucket->hand + 1) % PHALCON_SHM_SLOTS;
+
+		if (!__atomic_load_n(&slot->referenced, __ATOMIC_RELAXED)) {
+			return slot;
+		}
+
+		__atomic_store_n(&slot->referenced, 0, __ATOMIC_RELAXED);
+	}
+
+	return &bucket->slots[bucket->hand];
+}
+
+static int phalcon_shm_store(phalcon_shm_mapping *mapping, zend_string *key, zval *value, zend_long ttl, int only_missing)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	phalcon_shm_bucket *bucket;
+	phalcon_shm_slot *slot;
+	const char *data;
+	size_t value_len;
+	uint64_t hash, offset;
+	int64_t now = (int64_t) time(NULL);
+	zend_long lval;
+	uint8_t type, cls;
+
+	if (Z_TYPE_P(value) == IS_LONG) {
+		lval      = Z_LVAL_P(value);
+		data      = (const char *) &lval;
+		value_len = sizeof(zend_long);
+		type      = PHALCON_SHM_LONG;
+	} else if (Z_TYPE_P(value) == IS_STRING) {
+		data      = Z_STRVAL_P(value);
+		value_len = Z_STRLEN_P(value);
+		type      = PHALCON_SHM_STRING;
+	} else {
+		return 0;
+	}
+
+	if (ZSTR_LEN(key) + value_len > PHALCON_SHM_PAGE) {
+		return 0;
+	}
+
+	cls    = phalcon_shm_class(ZSTR_LEN(key) + value_len);
+	hash   = phalcon_shm_hash(key);
+	bucket = phalcon_shm_bucket_get(mapping, hash);
+
+	if (!phalcon_shm_bucket_lock(bucket)) {
+		return 0;
+	}
+
+	slot = phalcon_shm_find(mapping, bucket, hash, key);
+
+	if (slot && only_missing && slot->expires >= now) {
+		phalcon_shm_unlock(&bucket->seq);
+		return 0;
+	}
+
+	if (!slot) {
+		slot = phalcon_shm_victim(bucket, now);
+	}
+
+	if (slot->hash && slot->cls == cls) {
+		offset = slot->offset;
+	} else {
+		if (!phalcon_shm_lock(&header->lock)) {
+			phalcon_shm_unlock(&bucket->seq);
+			return 0;
+		}
+
+		if (slot->hash) {
+			phalcon_shm_free(mapping, slot);
+		}
+
+		offset = phalcon_shm_alloc(mapping, cls, bucket);
+
+		phalcon_shm_unlock(&header->lock);
+
+		if (!offset) {
+			phalcon_shm_unlock(&bucket->seq);
+			return 0;
+		}
+	}
+
+	memcpy(mapping->base + offset, ZSTR_VAL(key), ZSTR_LEN(key));
+	memcpy(mapping->base + offset + ZSTR_LEN(key), data, value_len);
+
+	slot->hash       = hash;
+	slot->offset     = offset;
+	slot->expires    = now + ttl;
+	slot->key_len    = (uint32_t) ZSTR_LEN(key);
+	slot->value_len  = (uint32_t) value_len;
+	slot->type       = type;
+	slot->cls        = cls;
+	slot->referenced = 1;
+
+	phalcon_shm_unlock(&bucket->seq);
+
+	return 1;
+}
+
+/**
+ * Reads a key without locking. The value is copied to return_value when
+ * requested. Returns 1 if the key exists and is not expired
+ */
+static int phalcon_shm_read(phalcon_shm_mapping *mapping, zend_string *key, zval *return_value)
+{
+	phalcon_shm_bucket *bucket;
+	phalcon_shm_slot copy, *slot;
+	zend_string *str;
+	zend_long lval;
+	uint64_t hash = phalcon_shm_hash(key);
+	uint64_t before, after;
+	unsigned long spins;
+	int64_t now = (int64_t) time(NULL);
+	int i, found;
+
+	bucket = phalcon_shm_bucket_get(mapping, hash);
+
+	for (spins = 0; spins < PHALCON_SHM_SPINS; spins++) {
+		before = __atomic_load_n(&bucket->seq, __ATOMIC_ACQUIRE);
+		if (before & 1) {
+			phalcon_shm_relax(spins);
+			continue;
+		}
+
+		found = 0;
+		slot  = NULL;
+		str   = NULL;
+
+		for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+			memcpy(&copy, &bucket->slots[i], sizeof(phalcon_shm_slot));
+			if (phalcon_shm_slot_matches(mapping, &copy, hash, key)) {
+				slot  = &bucket->slots[i];
+				found = copy.expires >= now;
+				break;
+			}
+		}
+
+		if (found && return_value) {
+			if (copy.type == PHALCON_SHM_LONG && copy.value_len == sizeof(zend_long)) {
+				memcpy(&lval, mapping->base + copy.offset + copy.key_len, sizeof(zend_long));
+			} else {
+				str = zend_string_alloc(copy.value_len, 0);
+				memcpy(ZSTR_VAL(str), mapping->base + copy.offset + copy.key_len, copy.value_len);
+				ZSTR_VAL(str)[copy.value_len] = '\0';
+			}
+		}
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		after = __atomic_load_n(&bucket->seq, __ATOMIC_RELAXED);
+
+		if (before != after) {
+			if (str) {
+				zend_string_free(str);
+			}
+			continue;
+		}
+
+		if (found) {
+			if (!copy.referenced) {
+				__atomic_store_n(&slot->referenced, 1, __ATOMIC_RELAXED);
+			}
+
+			if (return_value) {
+				if (str) {
+					RETVAL_STR(str);
+				} else {
+					RETVAL_LONG(lval);
+				}
+			}
+		}
+
+		return found;
+	}
+
+	return 0;
+}
+
+static void phalcon_shm_init(phalcon_shm_mapping *mapping)
+{
+	phalcon_shm_header *header = (phalcon_shm_header *) mapping->base;
+	uint64_t buckets = mapping->size / PHALCON_SHM_BUCKET_BYTES;
+	uint64_t classes = sizeof(phalcon_shm_header) + buckets * sizeof(phalcon_shm_bucket);
+	uint64_t arena = classes + mapping->size / PHALCON_SHM_PAGE;
+
+	header->magic     = PHALCON_SHM_MAGIC;
+	header->version   = PHALCON_SHM_VERSION;
+	header->size      = mapping->size;
+	header->buckets   = buckets;
+	header->classes   = classes;
+	header->arena     = (arena + PHALCON_SHM_MIN_CHUNK - 1) & ~((uint64_t) PHALCON_SHM_MIN_CHUNK - 1);
+	header->next_page = header->arena;
+}
+
+#endif
+
+/**
+ * Maps a file, creating and initializing it if needed, and returns the handle
+ * used by the other functions. A file already initialized keeps its size
+ */
+void phalcon_shm_open(zval *return_value, zval *file, zval *size)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping;
+	phalcon_shm_header header;
+	struct stat info;
+	unsigned char *base;
+	size_t length;
+	uint32_t i;
+	int fd, initialize = 0;
+
+	if (Z_TYPE_P(file) != IS_STRING || Z_TYPE_P(size) != IS_LONG) {
+		RETURN_FALSE;
+	}
+
+	if (!phalcon_shm_lock(&phalcon_shm_mappings_lock)) {
+		RETURN_FALSE;
+	}
+
+	for (i = 0; i < phalcon_shm_mappings_count; i++) {
+		if (strcmp(phalcon_shm_mappings[i].path, Z_STRVAL_P(file)) == 0) {
+			phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+			RETURN_LONG(i);
+		}
+	}
+
+	if (phalcon_shm_mappings_count == PHALCON_SHM_MAPPINGS) {
+		phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+		RETURN_FALSE;
+	}
+
+	fd = open(Z_STRVAL_P(file), O_RDWR | O_CREAT, 0600);
+	if (fd < 0) {
+		phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+		RETURN_FALSE;
+	}
+
+	/* Only one process initializes the file */
+	if (flock(fd, LOCK_EX) != 0 || fstat(fd, &info) != 0) {
+		close(fd);
+		phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+		RETURN_FALSE;
+	}
+
+	length = (size_t) info.st_size;
+
+	if (length < sizeof(phalcon_shm_header)
+		|| pread(fd, &header, sizeof(phalcon_shm_header), 0) != sizeof(phalcon_shm_header)
+		|| header.magic != PHALCON_SHM_MAGIC
+		|| header.version != PHALCON_SHM_VERSION
+		|| header.size != length
+	) {
+		length     = (size_t) Z_LVAL_P(size);
+		initialize = 1;
+
+		/* Truncating to 0 first zeroes the buckets of an invalid file */
+		if (Z_LVAL_P(size) < PHALCON_SHM_MIN_SIZE || ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t) length) != 0) {
+			flock(fd, LOCK_UN);
+			close(fd);
+			phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+			RETURN_FALSE;
+		}
+	}
+
+	base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	if (base == MAP_FAILED) {
+		flock(fd, LOCK_UN);
+		close(fd);
+		phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+		RETURN_FALSE;
+	}
+
+	mapping       = &phalcon_shm_mappings[phalcon_shm_mappings_count];
+	mapping->path = pestrdup(Z_STRVAL_P(file), 1);
+	mapping->base = base;
+	mapping->size = length;
+
+	if (initialize) {
+		phalcon_shm_init(mapping);
+	}
+
+	flock(fd, LOCK_UN);
+	close(fd);
+
+	i = phalcon_shm_mappings_count;
+	__atomic_store_n(&phalcon_shm_mappings_count, i + 1, __ATOMIC_RELEASE);
+
+	phalcon_shm_unlock(&phalcon_shm_mappings_lock);
+
+	RETURN_LONG(i);
+#endif
+}
+
+/**
+ * Stores a value only if the key does not exist or expired
+ */
+void phalcon_shm_add(zval *return_value, zval *handle, zval *key, zval *value, zval *ttl)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+
+	if (!mapping || Z_TYPE_P(key) != IS_STRING || Z_TYPE_P(ttl) != IS_LONG) {
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(phalcon_shm_store(mapping, Z_STR_P(key), value, Z_LVAL_P(ttl), 1));
+#endif
+}
+
+/**
+ * Deletes the keys starting with a prefix, or all the keys if the prefix is
+ * empty
+ */
+void phalcon_shm_clear(zval *return_value, zval *handle, zval *prefix)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+	phalcon_shm_header *header;
+	phalcon_shm_bucket *buckets;
+	phalcon_shm_slot *slot;
+	uint64_t b;
+	int i, result = 1;
+
+	if (!mapping || Z_TYPE_P(prefix) != IS_STRING) {
+		RETURN_FALSE;
+	}
+
+	header  = (phalcon_shm_header *) mapping->base;
+	buckets = (phalcon_shm_bucket *) (mapping->base + sizeof(phalcon_shm_header));
+
+	for (b = 0; b < header->buckets; b++) {
+		if (!phalcon_shm_bucket_lock(&buckets[b])) {
+			result = 0;
+			continue;
+		}
+
+		for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+			slot = &buckets[b].slots[i];
+			if (!slot->hash || slot->key_len < Z_STRLEN_P(prefix)) {
+				continue;
+			}
+
+			if (memcmp(mapping->base + slot->offset, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix)) != 0) {
+				continue;
+			}
+
+			if (!phalcon_shm_lock(&header->lock)) {
+				result = 0;
+				break;
+			}
+
+			phalcon_shm_free(mapping, slot);
+			phalcon_shm_unlock(&header->lock);
+		}
+
+		phalcon_shm_unlock(&buckets[b].seq);
+	}
+
+	RETURN_BOOL(result);
+#endif
+}
+
+/**
+ * Deletes a key. Returns false if it did not exist or expired
+ */
+void phalcon_shm_delete(zval *return_value, zval *handle, zval *key)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+	phalcon_shm_header *header;
+	phalcon_shm_bucket *bucket;
+	phalcon_shm_slot *slot;
+	uint64_t hash;
+	int result = 0;
+
+	if (!mapping || Z_TYPE_P(key) != IS_STRING) {
+		RETURN_FALSE;
+	}
+
+	header = (phalcon_shm_header *) mapping->base;
+	hash   = phalcon_shm_hash(Z_STR_P(key));
+	bucket = phalcon_shm_bucket_get(mapping, hash);
+
+	if (!phalcon_shm_bucket_lock(bucket)) {
+		RETURN_FALSE;
+	}
+
+	slot = phalcon_shm_find(mapping, bucket, hash, Z_STR_P(key));
+
+	if (slot && phalcon_shm_lock(&header->lock)) {
+		result = slot->expires >= (int64_t) time(NULL);
+
+		phalcon_shm_free(mapping, slot);
+		phalcon_shm_unlock(&header->lock);
+	}
+
+	phalcon_shm_unlock(&bucket->seq);
+
+	RETURN_BOOL(result);
+#endif
+}
+
+/**
+ * Returns the value of a key, a string or an integer, or null if it does not
+ * exist or expired
+ */
+void phalcon_shm_get(zval *return_value, zval *handle, zval *key)
+{
+#ifdef PHP_WIN32
+	RETURN_NULL();
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+
+	if (!mapping || Z_TYPE_P(key) != IS_STRING) {
+		RETURN_NULL();
+	}
+
+	if (!phalcon_shm_read(mapping, Z_STR_P(key), return_value)) {
+		RETURN_NULL();
+	}
+#endif
+}
+
+/**
+ * Checks if a key exists and is not expired
+ */
+void phalcon_shm_has(zval *return_value, zval *handle, zval *key)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+
+	if (!mapping || Z_TYPE_P(key) != IS_STRING) {
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(phalcon_shm_read(mapping, Z_STR_P(key), NULL));
+#endif
+}
+
+/**
+ * Adds a number to an integer value while holding the bucket lock and returns
+ * the result, or false if the key does not exist, expired or is not an
+ * integer
+ */
+void phalcon_shm_increment(zval *return_value, zval *handle, zval *key, zval *step)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+	phalcon_shm_bucket *bucket;
+	phalcon_shm_slot *slot;
+	uint64_t hash;
+	zend_long lval;
+
+	if (!mapping || Z_TYPE_P(key) != IS_STRING || Z_TYPE_P(step) != IS_LONG) {
+		RETURN_FALSE;
+	}
+
+	hash   = phalcon_shm_hash(Z_STR_P(key));
+	bucket = phalcon_shm_bucket_get(mapping, hash);
+
+	if (!phalcon_shm_bucket_lock(bucket)) {
+		RETURN_FALSE;
+	}
+
+	slot = phalcon_shm_find(mapping, bucket, hash, Z_STR_P(key));
+
+	if (!slot || slot->type != PHALCON_SHM_LONG || slot->expires < (int64_t) time(NULL)) {
+		phalcon_shm_unlock(&bucket->seq);
+		RETURN_FALSE;
+	}
+
+	memcpy(&lval, mapping->base + slot->offset + slot->key_len, sizeof(zend_long));
+	lval += Z_LVAL_P(step);
+	memcpy(mapping->base + slot->offset + slot->key_len, &lval, sizeof(zend_long));
+
+	phalcon_shm_unlock(&bucket->seq);
+
+	RETURN_LONG(lval);
+#endif
+}
+
+/**
+ * Returns the keys starting with a prefix that are not expired
+ */
+void phalcon_shm_keys(zval *return_value, zval *handle, zval *prefix)
+{
+#ifdef PHP_WIN32
+	array_init(return_value);
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+	phalcon_shm_header *header;
+	phalcon_shm_bucket *buckets;
+	phalcon_shm_slot *slot;
+	int64_t now = (int64_t) time(NULL);
+	uint64_t b;
+	int i;
+
+	array_init(return_value);
+
+	if (!mapping || Z_TYPE_P(prefix) != IS_STRING) {
+		return;
+	}
+
+	header  = (phalcon_shm_header *) mapping->base;
+	buckets = (phalcon_shm_bucket *) (mapping->base + sizeof(phalcon_shm_header));
+
+	for (b = 0; b < header->buckets; b++) {
+		if (!phalcon_shm_bucket_lock(&buckets[b])) {
+			continue;
+		}
+
+		for (i = 0; i < PHALCON_SHM_SLOTS; i++) {
+			slot = &buckets[b].slots[i];
+			if (!slot->hash || slot->expires < now || slot->key_len < Z_STRLEN_P(prefix)) {
+				continue;
+			}
+
+			if (memcmp(mapping->base + slot->offset, Z_STRVAL_P(prefix), Z_STRLEN_P(prefix)) == 0) {
+				add_next_index_stringl(return_value, (const char *) mapping->base + slot->offset, slot->key_len);
+			}
+		}
+
+		phalcon_shm_unlock(&buckets[b].seq);
+	}
+#endif
+}
+
+/**
+ * Stores a value, a string or an integer
+ */
+void phalcon_shm_set(zval *return_value, zval *handle, zval *key, zval *value, zval *ttl)
+{
+#ifdef PHP_WIN32
+	RETURN_FALSE;
+#else
+	phalcon_shm_mapping *mapping = phalcon_shm_mapping_get(handle);
+
+	if (!mapping || Z_TYPE_P(key) != IS_STRING || Z_TYPE_P(ttl) != IS_LONG) {
+		RETURN_FALSE;
+	}
+
+	RETURN_BOOL(phalcon_shm_store(mapping, Z_STR_P(key), value, Z_LVAL_P(ttl), 0));
+#endif
+}
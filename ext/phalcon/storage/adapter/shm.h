@@ -0,0 +1,26 @@
+/**
+ * This file is part of the Phalcon.
+ *
+ * (c) Phalcon Team <team@phalcon.com>
+ *
+ * For the full copyright and license information, please view the LICENSE
+ * file that was distributed with this source code.
+ */
+
+#ifndef PHALCON_STORAGE_ADAPTER_SHM_H
+#define PHALCON_STORAGE_ADAPTER_SHM_H
+
+#include <Zend/zend.h>
+
+/* Shared memory hash table used by Phalcon\Storage\Adapter\Shm */
+void phalcon_shm_open(zval *return_value, zval *file, zval *size);
+void phalcon_shm_add(zval *return_value, zval *handle, zval *key, zval *value, zval *ttl);
+void phalcon_shm_clear(zval *return_value, zval *handle, zval *prefix);
+void phalcon_shm_delete(zval *return_value, zval *handle, zval *key);
+void phalcon_shm_get(zval *return_value, zval *handle, zval *key);
+void phalcon_shm_has(zval *return_value, zval *handle, zval *key);
+void phalcon_shm_increment(zval *return_value, zval *handle, zval *key, zval *step);
+void phalcon_shm_keys(zval *return_value, zval *handle, zval *prefix);
+void phalcon_shm_set(zval *return_value, zval *handle, zval *key, zval *value, zval *ttl);
+
+#endif /* PHALCON_STORAGE_ADAPTER_SHM_H */
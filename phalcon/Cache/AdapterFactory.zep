@@ -45,7 +45,9 @@ class AdapterFactory
             "libmemcached" : "\\Phalcon\\Cache\\Adapter\\Libmemcached",
             "memory"       : "\\Phalcon\\Cache\\Adapter\\Memory",
             "redis"        : "\\Phalcon\\Cache\\Adapter\\Redis",
-            "stream"       : "\\Phalcon\\Cache\\Adapter\\Stream"
+            "shm"          : "\\Phalcon\\Cache\\Adapter\\Shm",
+            "stream"       : "\\Phalcon\\Cache\\Adapter\\Stream",
+            "tiered"       : "\\Phalcon\\Cache\\Adapter\\Tiered"
         ];
 
         let adapters = array_merge(adapters, services);
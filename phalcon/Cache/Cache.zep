@@ -80,19 +80,9 @@ class Cache implements CacheInterface
      */
     public function deleteMultiple(var keys) -> bool
     {
-        var key, result;
-
-        this->checkKeys(keys);
-
-        let result = true;
-
-        for key in keys {
-            if !this->adapter->delete(key) {
-                let result = false;
-            }
-        }
-
-        return result;
+        return this->adapter->deleteMultiple(
+            this->getCheckedKeys(keys)
+        );
     }
 
     /**
@@ -127,17 +117,10 @@ class Cache implements CacheInterface
      */
     public function getMultiple(var keys, var defaultValue = null) -> var
     {
-        var element;
-        array results;
-
-        this->checkKeys(keys);
-
-        let results = [];
-        for element in keys {
-            let results[element] = this->get(element, defaultValue);
-        }
-
-        return results;
+        return this->adapter->getMultiple(
+            this->getCheckedKeys(keys),
+            defaultValue
+        );
     }
 
     /**
@@ -157,6 +140,134 @@ class Cache implements CacheInterface
         return this->adapter->has(key);
     }
 
+    /**
+     * Returns the value stored for a key, computing and storing it with the
+     * callback when it is missing or expired.
+     *
+     * Only one caller computes the value: the others serve the previous
+     * (stale) value if there is one, or wait for the new value. The value
+     * may also be recomputed a bit before it expires, with a probability
+     * that grows as the expiry gets closer and with the time the callback
+     * took (XFetch), so that hot keys are refreshed before everybody misses.
+     *
+     *<code>
+     * $robots = $cache->remember(
+     *     "robots",
+     *     300,
+     *     function () {
+     *         return Robots::find()->toArray();
+     *     },
+     *     [
+     *         "stale" => 60,
+     *     ]
+     * );
+     *</code>
+     *
+     * Options:
+     * - beta: Weight of the early recomputation, 0 disables it (1.0)
+     * - lockTtl: Seconds the computing lock is held at most (10)
+     * - stale: Seconds an expired value is kept to be served while it is
+     *   recomputed (0)
+     * - wait: Milliseconds to wait for the value computed by another caller
+     *   before computing it (1000)
+     *
+     * The value is stored as it is under the key, so get() returns it. The
+     * compute time and the expiry are stored under the key with a "-meta"
+     * suffix; a value stored with set() has none and is returned as is.
+     *
+     * @param string                 $key      The key of the item
+     * @param null|int|\DateInterval $ttl      The TTL of the computed value
+     * @param callable               $callback Returns the value to store
+     * @param array                  $options
+     *
+     * @return mixed
+     *
+     * @throws Phalcon\Cache\Exception\InvalidArgumentException
+     *   MUST be thrown if the $key string is not a legal value.
+     */
+    public function remember(var key, var ttl, var callback, array! options = []) -> var
+    {
+        var beta, exception, lockKey, lockTtl, meta, metaKey, missing, stale,
+            value, values, wait;
+        int waited;
+
+        this->checkKey(key);
+
+        if unlikely !is_callable(callback) {
+            throw new InvalidArgumentException("The callback is not callable");
+        }
+
+        if !fetch beta, options["beta"] {
+            let beta = 1.0;
+        }
+
+        if !fetch lockTtl, options["lockTtl"] {
+            let lockTtl = 10;
+        }
+
+        if !fetch stale, options["stale"] {
+            let stale = 0;
+        }
+
+        if !fetch wait, options["wait"] {
+            let wait = 1000;
+        }
+
+        let metaKey = key . "-meta",
+            missing = new \stdClass(),
+            values  = this->adapter->getMultiple([key, metaKey], missing),
+            value   = values[key],
+            meta    = values[metaKey];
+
+        /**
+         * A value without meta data has been stored with set()
+         */
+        if value !== missing {
+            if typeof meta != "array" || !this->shouldRecompute(meta, beta) {
+                return value;
+            }
+        }
+
+        let lockKey = key . "-lock";
+
+        if this->adapter->add(lockKey, 1, lockTtl) {
+            try {
+                let value = this->computeRememberEntry(key, ttl, stale, callback);
+            } catch \Throwable, exception {
+                this->adapter->delete(lockKey);
+
+                throw exception;
+            }
+
+            this->adapter->delete(lockKey);
+
+            return value;
+        }
+
+        /**
+         * Another caller is computing the value: serve the stored one if it
+         * is still there (early recomputation or stale value)
+         */
+        if value !== missing {
+            return value;
+        }
+
+        let waited = 0;
+
+        while waited < wait {
+            usleep(25000);
+
+            let waited += 25,
+                value = this->adapter->get(key, missing);
+
+            if value !== missing {
+                return value;
+            }
+        }
+
+        return this->computeRememberEntry(key, ttl, stale, callback);
+    }
+
     /**
      * Persists data in the cache, uniquely referenced by a key with an optional expiration TTL time.
      *
@@ -195,18 +306,19 @@ class Cache implements CacheInterface
     public function setMultiple(var values, var ttl = null) -> bool
     {
         var key, value;
-        bool result;
+        array items;
 
         this->checkKeys(values);
 
-        let result = true;
+        let items = [];
+
         for key, value in values {
-            if !this->set(key, value, ttl) {
-                let result = false;
-            }
+            this->checkKey(key);
+
+            let items[key] = value;
         }
 
-        return result;
+        return this->adapter->setMultiple(items, ttl);
     }
 
     /**
@@ -234,4 +346,102 @@ class Cache implements CacheInterface
             );
         }
     }
+
+    /**
+     * Calls the callback and stores its value, and the time it took with its
+     * expiry time as meta data
+     */
+    protected function computeRememberEntry(var key, var ttl, var stale, var callback) -> var
+    {
+        var dateTime, delta, expires, lifetime, start, value;
+
+        let start = microtime(true),
+            value = call_user_func(callback),
+            delta = microtime(true) - start;
+
+        if ttl === null {
+            /**
+             * The adapter lifetime applies, there is no early recomputation
+             */
+            let expires  = 0,
+                lifetime = null;
+        } else {
+            if typeof ttl === "object" && ttl instanceof \DateInterval {
+                let dateTime = new \DateTime("@0"),
+                    lifetime = dateTime->add(ttl)->getTimestamp();
+            } else {
+                let lifetime = (int) ttl;
+            }
+
+            let expires  = microtime(true) + lifetime,
+                lifetime = lifetime + (int) stale;
+        }
+
+        this->adapter->setMultiple(
+            [
+                key           : value,
+                key . "-meta" : [
+                    "delta"   : delta,
+                    "expires" : expires
+                ]
+            ],
+            lifetime
+        );
+
+        return value;
+    }
+
+    /**
+     * Checks a list of keys and returns them as an array, so that the adapter
+     * can process them in one operation
+     */
+    protected function getCheckedKeys(var keys) -> array
+    {
+        var key;
+        array results;
+
+        this->checkKeys(keys);
+
+        let results = [];
+
+        for key in keys {
+            this->checkKey(key);
+
+            let results[] = key;
+        }
+
+        return results;
+    }
+
+    /**
+     * Decides from its meta data if a value stored by remember() has to be
+     * computed again. It is always the case once it expired; before that, the
+     * probability grows as the expiry gets closer, weighted by the time the
+     * value took to compute
+     */
+    protected function shouldRecompute(array! meta, var beta) -> bool
+    {
+        var delta, expires;
+        double random;
+
+        if !fetch expires, meta["expires"] {
+            return false;
+        }
+
+        if !fetch delta, meta["delta"] {
+            return false;
+        }
+
+        if expires == 0 {
+            return false;
+        }
+
+        if beta <= 0 {
+            return microtime(true) >= expires;
+        }
+
+        let random = (double) mt_rand(1, mt_getrandmax()) / mt_getrandmax();
+
+        return microtime(true) - delta * beta * log(random) >= expires;
+    }
 }
@@ -380,6 +380,31 @@ abstract class Adapter implements AdapterInterface, EventsAwareInterface
         return referenceObjects;
     }
 
+    /**
+     * Returns the Phalcon\Db\Column objects of every table in a schema,
+     * indexed by table name. Adapters able to describe a whole schema in a
+     * single query override this method
+     *
+     *<code>
+     * print_r(
+     *     $connection->describeSchemaColumns("blog")
+     * );
+     *</code>
+     */
+    public function describeSchemaColumns(string schema = null) -> array
+    {
+        var table;
+        array columns;
+
+        let columns = [];
+
+        for table in this->listTables(schema) {
+            let columns[table] = this->{"describeColumns"}(table, schema);
+        }
+
+        return columns;
+    }
+
     /**
      * Drops a column from a table
      */
@@ -266,6 +266,11 @@ abstract class Pdo extends Adapter
             unset descriptor["dialectClass"];
         }
 
+        // The result buffer size is not a dsn setting either.
+        if isset descriptor["resultBuffer"] {
+            unset descriptor["resultBuffer"];
+        }
+
         /**
          * Check if the developer has defined custom options or create one from
          * scratch
@@ -712,7 +717,7 @@ abstract class Pdo extends Adapter
      */
     public function query(string! sqlStatement, var bindParams = null, var bindTypes = null) -> <ResultInterface> | bool
     {
-        var eventsManager, pdo, statement, params, types;
+        var eventsManager, pdo, statement, params, types, result, bufferSize;
 
         let eventsManager = <ManagerInterface> this->eventsManager;
 
@@ -753,13 +758,24 @@ abstract class Pdo extends Adapter
                 eventsManager->fire("db:afterQuery", this);
             }
 
-            return new ResultPdo(
+            let result = new ResultPdo(
                 this,
                 statement,
                 sqlStatement,
                 bindParams,
                 bindTypes
             );
+
+            /**
+             * Enable the client-side row buffer if requested in the descriptor
+             */
+            if fetch bufferSize, this->descriptor["resultBuffer"] {
+                if bufferSize > 0 {
+                    result->useBuffer(bufferSize);
+                }
+            }
+
+            return result;
         }
 
         return statement;
@@ -81,6 +81,174 @@ class Mysql extends PdoAdapter
      * </code>
      */
     public function describeColumns(string table, string schema = null) -> <ColumnInterface[]>
+    {
+        return this->describeFields(
+            this->fetchAll(
+                this->dialect->describeColumns(table, schema),
+                Db::FETCH_NUM
+            )
+        );
+    }
+
+    /**
+     * Lists table indexes
+     *
+     * <code>
+     * print_r(
+     *     $connection->describeIndexes("robots_parts")
+     * );
+     * </code>
+     */
+    public function describeIndexes(string! table, string! schema = null) -> <IndexInterface[]>
+    {
+        var indexes, index, keyName, indexType, indexObjects, columns, name;
+
+        let indexes = [];
+
+        for index in this->fetchAll(this->dialect->describeIndexes(table, schema), Db::FETCH_ASSOC) {
+            let keyName = index["Key_name"];
+            let indexType = index["Index_type"];
+
+            if !isset indexes[keyName] {
+                let indexes[keyName] = [];
+            }
+
+            if !isset indexes[keyName]["columns"] {
+                let columns = [];
+            } else {
+                let columns = indexes[keyName]["columns"];
+            }
+
+            let columns[] = index["Column_name"];
+            let indexes[keyName]["columns"] = columns;
+
+            if keyName == "PRIMARY" {
+                let indexes[keyName]["type"] = "PRIMARY";
+            } elseif indexType == "FULLTEXT" {
+                let indexes[keyName]["type"] = "FULLTEXT";
+            } elseif index["Non_unique"] == 0 {
+                let indexes[keyName]["type"] = "UNIQUE";
+            } else {
+                let indexes[keyName]["type"] = null;
+            }
+        }
+
+        let indexObjects = [];
+
+        for name, index in indexes {
+            let indexObjects[name] = new Index(
+                name,
+                index["columns"],
+                index["type"]
+            );
+        }
+
+        return indexObjects;
+    }
+
+    /**
+     * Lists table references
+     *
+     *<code>
+     * print_r(
+     *     $connection->describeReferences("robots_parts")
+     * );
+     *</code>
+     */
+    public function describeReferences(string! table, string! schema = null) -> <ReferenceInterface[]>
+    {
+        var references, reference, arrayReference, constraintName,
+            referenceObjects, name, referencedSchema, referencedTable, columns,
+            referencedColumns, referenceUpdate, referenceDelete;
+
+        let references = [];
+
+        for reference in this->fetchAll(this->dialect->describeReferences(table, schema), Db::FETCH_NUM) {
+
+            let constraintName = reference[2];
+
+            if !isset references[constraintName] {
+                let referencedSchema  = reference[3];
+                let referencedTable   = reference[4];
+                let referenceUpdate   = reference[6];
+                let referenceDelete   = reference[7];
+                let columns           = [];
+                let referencedColumns = [];
+            } else {
+                let referencedSchema  = references[constraintName]["referencedSchema"];
+                let referencedTable   = references[constraintName]["referencedTable"];
+                let columns           = references[constraintName]["columns"];
+                let referencedColumns = references[constraintName]["referencedColumns"];
+                let referenceUpdate   = references[constraintName]["onUpdate"];
+                let referenceDelete   = references[constraintName]["onDelete"];
+            }
+
+            let columns[] = reference[1],
+                referencedColumns[] = reference[5];
+
+            let references[constraintName] = [
+                "referencedSchema"  : referencedSchema,
+                "referencedTable"   : referencedTable,
+                "columns"           : columns,
+                "referencedColumns" : referencedColumns,
+                "onUpdate"          : referenceUpdate,
+                "onDelete"          : referenceDelete
+            ];
+        }
+
+        let referenceObjects = [];
+        for name, arrayReference in references {
+            let referenceObjects[name] = new Reference(
+                name,
+                [
+                    "referencedSchema"  : arrayReference["referencedSchema"],
+                    "referencedTable"   : arrayReference["referencedTable"],
+                    "columns"           : arrayReference["columns"],
+                    "referencedColumns" : arrayReference["referencedColumns"],
+                    "onUpdate"          : arrayReference["onUpdate"],
+                    "onDelete"          : arrayReference["onDelete"]
+                ]
+            );
+        }
+
+        return referenceObjects;
+    }
+
+    /**
+     * Returns the Phalcon\Db\Column objects of every table in a schema,
+     * indexed by table name. All tables are described with a single query
+     *
+     * <code>
+     * print_r(
+     *     $connection->describeSchemaColumns()
+     * );
+     * </code>
+     */
+    public function describeSchemaColumns(string schema = null) -> array
+    {
+        var row, table, fields;
+        array tables, columns;
+
+        let tables = [],
+            columns = [];
+
+        for row in this->fetchAll(this->dialect->describeSchemaColumns(schema), Db::FETCH_NUM) {
+            let table = row[0],
+                tables[table][] = array_slice(row, 1);
+        }
+
+        for table, fields in tables {
+            let columns[table] = this->describeFields(fields);
+        }
+
+        return columns;
+    }
+
+    /**
+     * Converts the rows returned by the describe queries into
+     * Phalcon\Db\Column objects
+     */
+    protected function describeFields(array fields) -> <ColumnInterface[]>
     {
         var columns, columnType, field, oldColumn, sizePattern, matches,
             matchOne, matchTwo, columnName;
@@ -92,12 +260,10 @@ class Mysql extends PdoAdapter
         let columns = [];
 
         /**
-         * Get the SQL to describe a table
-         * We're using FETCH_NUM to fetch the columns
-         * Get the describe
+         * The fields are fetched using FETCH_NUM
          * Field Indexes: 0:name, 1:type, 2:not null, 3:key, 4:default, 5:extra
          */
-        for field in this->fetchAll(this->dialect->describeColumns(table, schema), Db::FETCH_NUM) {
+        for field in fields {
 
             /**
              * By default the bind types is two
@@ -442,130 +608,6 @@ class Mysql extends PdoAdapter
         return columns;
     }
 
-    /**
-     * Lists table indexes
-     *
-     * <code>
-     * print_r(
-     *     $connection->describeIndexes("robots_parts")
-     * );
-     * </code>
-     */
-    public function describeIndexes(string! table, string! schema = null) -> <IndexInterface[]>
-    {
-        var indexes, index, keyName, indexType, indexObjects, columns, name;
-
-        let indexes = [];
-
-        for index in this->fetchAll(this->dialect->describeIndexes(table, schema), Db::FETCH_ASSOC) {
-            let keyName = index["Key_name"];
-            let indexType = index["Index_type"];
-
-            if !isset indexes[keyName] {
-                let indexes[keyName] = [];
-            }
-
-            if !isset indexes[keyName]["columns"] {
-                let columns = [];
-            } else {
-                let columns = indexes[keyName]["columns"];
-            }
-
-            let columns[] = index["Column_name"];
-            let indexes[keyName]["columns"] = columns;
-
-            if keyName == "PRIMARY" {
-                let indexes[keyName]["type"] = "PRIMARY";
-            } elseif indexType == "FULLTEXT" {
-                let indexes[keyName]["type"] = "FULLTEXT";
-            } elseif index["Non_unique"] == 0 {
-                let indexes[keyName]["type"] = "UNIQUE";
-            } else {
-                let indexes[keyName]["type"] = null;
-            }
-        }
-
-        let indexObjects = [];
-
-        for name, index in indexes {
-            let indexObjects[name] = new Index(
-                name,
-                index["columns"],
-                index["type"]
-            );
-        }
-
-        return indexObjects;
-    }
-
-    /**
-     * Lists table references
-     *
-     *<code>
-     * print_r(
-     *     $connection->describeReferences("robots_parts")
-     * );
-     *</code>
-     */
-    public function describeReferences(string! table, string! schema = null) -> <ReferenceInterface[]>
-    {
-        var references, reference, arrayReference, constraintName,
-            referenceObjects, name, referencedSchema, referencedTable, columns,
-            referencedColumns, referenceUpdate, referenceDelete;
-
-        let references = [];
-
-        for reference in this->fetchAll(this->dialect->describeReferences(table, schema), Db::FETCH_NUM) {
-
-            let constraintName = reference[2];
-
-            if !isset references[constraintName] {
-                let referencedSchema  = reference[3];
-                let referencedTable   = reference[4];
-                let referenceUpdate   = reference[6];
-                let referenceDelete   = reference[7];
-                let columns           = [];
-                let referencedColumns = [];
-            } else {
-                let referencedSchema  = references[constraintName]["referencedSchema"];
-                let referencedTable   = references[constraintName]["referencedTable"];
-                let columns           = references[constraintName]["columns"];
-                let referencedColumns = references[constraintName]["referencedColumns"];
-                let referenceUpdate   = references[constraintName]["onUpdate"];
-                let referenceDelete   = references[constraintName]["onDelete"];
-            }
-
-            let columns[] = reference[1],
-                referencedColumns[] = reference[5];
-
-            let references[constraintName] = [
-                "referencedSchema"  : referencedSchema,
-                "referencedTable"   : referencedTable,
-                "columns"           : columns,
-                "referencedColumns" : referencedColumns,
-                "onUpdate"          : referenceUpdate,
-                "onDelete"          : referenceDelete
-            ];
-        }
-
-        let referenceObjects = [];
-        for name, arrayReference in references {
-            let referenceObjects[name] = new Reference(
-                name,
-                [
-                    "referencedSchema"  : arrayReference["referencedSchema"],
-                    "referencedTable"   : arrayReference["referencedTable"],
-                    "columns"           : arrayReference["columns"],
-                    "referencedColumns" : arrayReference["referencedColumns"],
-                    "onUpdate"          : arrayReference["onUpdate"],
-                    "onDelete"          : arrayReference["onDelete"]
-                ]
-            );
-        }
-
-        return referenceObjects;
-    }
-
     /**
      * Returns PDO adapter DSN defaults as a key-value map.
      */
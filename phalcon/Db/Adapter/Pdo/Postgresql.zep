@@ -148,7 +148,203 @@ class Postgresql extends PdoAdapter
      */
     public function describeColumns(string table, string schema = null) -> <ColumnInterface[]>
     {
-        var columns, columnType, fields, field, definition, oldColumn,
+        return this->describeFields(
+            this->fetchAll(
+                this->dialect->describeColumns(table, schema),
+                Db::FETCH_NUM
+            )
+        );
+    }
+
+    /**
+     * Lists table references
+     *
+     *<code>
+     * print_r(
+     *     $connection->describeReferences("robots_parts")
+     * );
+     *</code>
+     */
+    public function describeReferences(string! table, string! schema = null) -> <ReferenceInterface[]>
+    {
+        var references, reference, arrayReference, constraintName,
+            referenceObjects, name, referencedSchema, referencedTable, columns,
+            referencedColumns, referenceUpdate, referenceDelete;
+
+        let references = [];
+
+        for reference in this->fetchAll(this->dialect->describeReferences(table, schema), Db::FETCH_NUM) {
+            let constraintName = reference[2];
+
+            if !isset references[constraintName] {
+                let referencedSchema  = reference[3];
+                let referencedTable   = reference[4];
+                let referenceUpdate   = reference[6];
+                let referenceDelete   = reference[7];
+                let columns           = [];
+                let referencedColumns = [];
+            } else {
+                let referencedSchema  = references[constraintName]["referencedSchema"];
+                let referencedTable   = references[constraintName]["referencedTable"];
+                let columns           = references[constraintName]["columns"];
+                let referencedColumns = references[constraintName]["referencedColumns"];
+                let referenceUpdate   = references[constraintName]["onUpdate"];
+                let referenceDelete   = references[constraintName]["onDelete"];
+            }
+
+            let columns[] = reference[1],
+                referencedColumns[] = reference[5];
+
+            let references[constraintName] = [
+                "referencedSchema"  : referencedSchema,
+                "referencedTable"   : referencedTable,
+                "columns"           : columns,
+                "referencedColumns" : referencedColumns,
+                "onUpdate"          : referenceUpdate,
+                "onDelete"          : referenceDelete
+            ];
+        }
+
+        let referenceObjects = [];
+
+        for name, arrayReference in references {
+            let referenceObjects[name] = new Reference(
+                name,
+                [
+                    "referencedSchema"  : arrayReference["referencedSchema"],
+                    "referencedTable"   : arrayReference["referencedTable"],
+                    "columns"           : arrayReference["columns"],
+                    "referencedColumns" : arrayReference["referencedColumns"],
+                    "onUpdate"          : arrayReference["onUpdate"],
+                    "onDelete"          : arrayReference["onDelete"]
+                ]
+            );
+        }
+
+        return referenceObjects;
+    }
+
+    /**
+     * Returns the Phalcon\Db\Column objects of every table in a schema,
+     * indexed by table name. All tables are described with a single query
+     *
+     * <code>
+     * print_r(
+     *     $connection->describeSchemaColumns()
+     * );
+     * </code>
+     */
+    public function describeSchemaColumns(string schema = null) -> array
+    {
+        var row, table, fields;
+        array tables, columns;
+
+        let tables = [],
+            columns = [];
+
+        for row in this->fetchAll(this->dialect->describeSchemaColumns(schema), Db::FETCH_NUM) {
+            let table = row[0],
+                tables[table][] = array_slice(row, 1);
+        }
+
+        for table, fields in tables {
+            let columns[table] = this->describeFields(fields);
+        }
+
+        return columns;
+    }
+
+    /**
+     * Returns the default identity value to be inserted in an identity column
+     *
+     *<code>
+     * // Inserting a new robot with a valid default value for the column 'id'
+     * $success = $connection->insert(
+     *     "robots",
+     *     [
+     *         $connection->getDefaultIdValue(),
+     *         "Astro Boy",
+     *         1952,
+     *     ],
+     *     [
+     *         "id",
+     *         "name",
+     *         "year",
+     *     ]
+     * );
+     *</code>
+     */
+    public function getDefaultIdValue() -> <RawValue>
+    {
+        return new RawValue("DEFAULT");
+    }
+
+    /**
+     * Modifies a table column based on a definition
+     */
+    public function modifyColumn(string! tableName, string! schemaName, <ColumnInterface> column, <ColumnInterface> currentColumn = null) -> bool
+    {
+        var sql, queries, query, exception;
+
+        let sql = this->dialect->modifyColumn(
+            tableName,
+            schemaName,
+            column,
+            currentColumn
+        );
+
+        let queries = explode(";",sql);
+
+        if count(queries) > 1 {
+            try {
+                this->{"begin"}();
+
+                for query in queries {
+                    if empty query {
+                        continue;
+                    }
+
+                    this->{"query"}(query . ";");
+                }
+
+                return this->{"commit"}();
+            } catch \Throwable, exception {
+                this->{"rollback"}();
+
+                throw exception;
+            }
+        } else {
+            return !empty sql ? this->{"execute"}(queries[0] . ";") : true;
+        }
+
+        return true;
+    }
+
+    /**
+     * Check whether the database system requires a sequence to produce
+     * auto-numeric values
+     */
+    public function supportSequences() -> bool
+    {
+        return true;
+    }
+
+    /**
+     * Check whether the database system requires an explicit value for identity
+     * columns
+     */
+    public function useExplicitIdValue() -> bool
+    {
+        return true;
+    }
+
+    /**
+     * Converts the rows returned by the describe queries into
+     * Phalcon\Db\Column objects
+     */
+    protected function describeFields(array fields) -> <ColumnInterface[]>
+    {
+        var columns, columnType, field, definition, oldColumn,
             columnName, charSize, numericSize, numericScale;
 
         let oldColumn = null, columns = [];
@@ -158,11 +354,6 @@ class Postgresql extends PdoAdapter
          * 0:name, 1:type, 2:size, 3:numericsize, 4: numericscale, 5: null,
          * 6: key, 7: extra, 8: position, 9 default
          */
-        let fields = this->fetchAll(
-            this->dialect->describeColumns(table, schema),
-            Db::FETCH_NUM
-        );
-
         for field in fields {
 
             /**
@@ -520,158 +711,6 @@ class Postgresql extends PdoAdapter
         return columns;
     }
 
-    /**
-     * Lists table references
-     *
-     *<code>
-     * print_r(
-     *     $connection->describeReferences("robots_parts")
-     * );
-     *</code>
-     */
-    public function describeReferences(string! table, string! schema = null) -> <ReferenceInterface[]>
-    {
-        var references, reference, arrayReference, constraintName,
-            referenceObjects, name, referencedSchema, referencedTable, columns,
-            referencedColumns, referenceUpdate, referenceDelete;
-
-        let references = [];
-
-        for reference in this->fetchAll(this->dialect->describeReferences(table, schema), Db::FETCH_NUM) {
-            let constraintName = reference[2];
-
-            if !isset references[constraintName] {
-                let referencedSchema  = reference[3];
-                let referencedTable   = reference[4];
-                let referenceUpdate   = reference[6];
-                let referenceDelete   = reference[7];
-                let columns           = [];
-                let referencedColumns = [];
-            } else {
-                let referencedSchema  = references[constraintName]["referencedSchema"];
-                let referencedTable   = references[constraintName]["referencedTable"];
-                let columns           = references[constraintName]["columns"];
-                let referencedColumns = references[constraintName]["referencedColumns"];
-                let referenceUpdate   = references[constraintName]["onUpdate"];
-                let referenceDelete   = references[constraintName]["onDelete"];
-            }
-
-            let columns[] = reference[1],
-                referencedColumns[] = reference[5];
-
-            let references[constraintName] = [
-                "referencedSchema"  : referencedSchema,
-                "referencedTable"   : referencedTable,
-                "columns"           : columns,
-                "referencedColumns" : referencedColumns,
-                "onUpdate"          : referenceUpdate,
-                "onDelete"          : referenceDelete
-            ];
-        }
-
-        let referenceObjects = [];
-
-        for name, arrayReference in references {
-            let referenceObjects[name] = new Reference(
-                name,
-                [
-                    "referencedSchema"  : arrayReference["referencedSchema"],
-                    "referencedTable"   : arrayReference["referencedTable"],
-                    "columns"           : arrayReference["columns"],
-                    "referencedColumns" : arrayReference["referencedColumns"],
-                    "onUpdate"          : arrayReference["onUpdate"],
-                    "onDelete"          : arrayReference["onDelete"]
-                ]
-            );
-        }
-
-        return referenceObjects;
-    }
-
-    /**
-     * Returns the default identity value to be inserted in an identity column
-     *
-     *<code>
-     * // Inserting a new robot with a valid default value for the column 'id'
-     * $success = $connection->insert(
-     *     "robots",
-     *     [
-     *         $connection->getDefaultIdValue(),
-     *         "Astro Boy",
-     *         1952,
-     *     ],
-     *     [
-     *         "id",
-     *         "name",
-     *         "year",
-     *     ]
-     * );
-     *</code>
-     */
-    public function getDefaultIdValue() -> <RawValue>
-    {
-        return new RawValue("DEFAULT");
-    }
-
-    /**
-     * Modifies a table column based on a definition
-     */
-    public function modifyColumn(string! tableName, string! schemaName, <ColumnInterface> column, <ColumnInterface> currentColumn = null) -> bool
-    {
-        var sql, queries, query, exception;
-
-        let sql = this->dialect->modifyColumn(
-            tableName,
-            schemaName,
-            column,
-            currentColumn
-        );
-
-        let queries = explode(";",sql);
-
-        if count(queries) > 1 {
-            try {
-                this->{"begin"}();
-
-                for query in queries {
-                    if empty query {
-                        continue;
-                    }
-
-                    this->{"query"}(query . ";");
-                }
-
-                return this->{"commit"}();
-            } catch \Throwable, exception {
-                this->{"rollback"}();
-
-                throw exception;
-            }
-        } else {
-            return !empty sql ? this->{"execute"}(queries[0] . ";") : true;
-        }
-
-        return true;
-    }
-
-    /**
-     * Check whether the database system requires a sequence to produce
-     * auto-numeric values
-     */
-    public function supportSequences() -> bool
-    {
-        return true;
-    }
-
-    /**
-     * Check whether the database system requires an explicit value for identity
-     * columns
-     */
-    public function useExplicitIdValue() -> bool
-    {
-        return true;
-    }
-
     /**
      * Returns PDO adapter DSN defaults as a key-value map.
      */
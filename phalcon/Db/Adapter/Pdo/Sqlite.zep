@@ -92,7 +92,206 @@ class Sqlite extends PdoAdapter
      */
     public function describeColumns(string! table, string! schema = null) -> <ColumnInterface[]>
     {
-        var columns, columnType, fields, field, definition, oldColumn,
+        return this->describeFields(
+            this->fetchAll(
+                this->dialect->describeColumns(table, schema),
+                Db::FETCH_NUM
+            )
+        );
+    }
+
+    /**
+     * Lists table indexes
+     *
+     * <code>
+     * print_r(
+     *     $connection->describeIndexes("robots_parts")
+     * );
+     * </code>
+     */
+    public function describeIndexes(string! table, string! schema = null) -> <IndexInterface[]>
+    {
+        var indexes, index, keyName, indexObjects, name, columns,
+            describeIndexes, describeIndex, indexSql;
+
+        let indexes = [];
+
+        for index in this->fetchAll(this->dialect->describeIndexes(table, schema), Db::FETCH_ASSOC) {
+            let keyName = index["name"];
+
+            if !isset indexes[keyName] {
+                let indexes[keyName] = [];
+            }
+
+            if !isset indexes[keyName]["columns"] {
+                let columns = [];
+            } else {
+                let columns = indexes[keyName]["columns"];
+            }
+
+            let describeIndexes = this->fetchAll(
+                this->dialect->describeIndex(keyName),
+                Db::FETCH_ASSOC
+            );
+
+            for describeIndex in describeIndexes {
+                let columns[] = describeIndex["name"];
+            }
+
+            let indexes[keyName]["columns"] = columns;
+
+            let indexSql = this->fetchColumn(
+                this->dialect->listIndexesSql(table, schema, keyName)
+            );
+
+            if index["unique"] {
+                if preg_match("# UNIQUE #i", indexSql) {
+                    let indexes[keyName]["type"] = "UNIQUE";
+                } else {
+                    let indexes[keyName]["type"] = "PRIMARY";
+                }
+            } else {
+                let indexes[keyName]["type"] = null;
+            }
+        }
+
+        let indexObjects = [];
+
+        for name, index in indexes {
+            let indexObjects[name] = new Index(
+                name,
+                index["columns"],
+                index["type"]
+            );
+        }
+
+        return indexObjects;
+    }
+
+    /**
+     * Lists table references
+     */
+    public function describeReferences(string! table, string! schema = null) -> <ReferenceInterface[]>
+    {
+        var references, reference, arrayReference, constraintName,
+            referenceObjects, name, referencedSchema, referencedTable, columns,
+            referencedColumns, number;
+
+        let references = [];
+
+        for number, reference in this->fetchAll(this->dialect->describeReferences(table, schema), Db::FETCH_NUM) {
+            let constraintName = "foreign_key_" . number;
+
+            if !isset references[constraintName] {
+                let referencedSchema = null;
+                let referencedTable = reference[2];
+                let columns = [];
+                let referencedColumns = [];
+            } else {
+                let referencedSchema = references[constraintName]["referencedSchema"];
+                let referencedTable = references[constraintName]["referencedTable"];
+                let columns = references[constraintName]["columns"];
+                let referencedColumns = references[constraintName]["referencedColumns"];
+            }
+
+            let columns[] = reference[3],
+                referencedColumns[] = reference[4];
+
+            let references[constraintName] = [
+                "referencedSchema"  : referencedSchema,
+                "referencedTable"   : referencedTable,
+                "columns"           : columns,
+                "referencedColumns" : referencedColumns
+            ];
+        }
+
+        let referenceObjects = [];
+
+        for name, arrayReference in references {
+            let referenceObjects[name] = new Reference(
+                name,
+                [
+                    "referencedSchema"  : arrayReference["referencedSchema"],
+                    "referencedTable"   : arrayReference["referencedTable"],
+                    "columns"           : arrayReference["columns"],
+                    "referencedColumns" : arrayReference["referencedColumns"]
+                ]
+            );
+        }
+
+        return referenceObjects;
+    }
+
+    /**
+     * Returns the Phalcon\Db\Column objects of every table in a schema,
+     * indexed by table name. All tables are described with a single query
+     *
+     * <code>
+     * print_r(
+     *     $connection->describeSchemaColumns()
+     * );
+     * </code>
+     */
+    public function describeSchemaColumns(string schema = null) -> array
+    {
+        var row, table, fields;
+        array tables, columns;
+
+        let tables = [],
+            columns = [];
+
+        for row in this->fetchAll(this->dialect->describeSchemaColumns(schema), Db::FETCH_NUM) {
+            let table = row[0],
+                tables[table][] = array_slice(row, 1);
+        }
+
+        for table, fields in tables {
+            let columns[table] = this->describeFields(fields);
+        }
+
+        return columns;
+    }
+
+    /**
+     * Returns the default value to make the RBDM use the default value declared
+     * in the table definition
+     *
+     *<code>
+     * // Inserting a new robot with a valid default value for the column 'year'
+     * $success = $connection->insert(
+     *     "robots",
+     *     [
+     *         "Astro Boy",
+     *         $connection->getDefaultValue(),
+     *     ],
+     *     [
+     *         "name",
+     *         "year",
+     *     ]
+     * );
+     *</code>
+     */
+    public function getDefaultValue() -> <RawValue>
+    {
+        return new RawValue("NULL");
+    }
+
+    /**
+     * Check whether the database system requires an explicit value for identity
+     * columns
+     */
+    public function useExplicitIdValue() -> bool
+    {
+        return true;
+    }
+
+    /**
+     * Converts the rows returned by the describe queries into
+     * Phalcon\Db\Column objects
+     */
+    protected function describeFields(array fields) -> <ColumnInterface[]>
+    {
+        var columns, columnType, field, definition, oldColumn,
             sizePattern, matches, matchOne, matchTwo, columnName;
 
         let oldColumn = null,
@@ -103,11 +302,6 @@ class Sqlite extends PdoAdapter
         /**
          * We're using FETCH_NUM to fetch the columns
          */
-        let fields = this->fetchAll(
-            this->dialect->describeColumns(table, schema),
-            Db::FETCH_NUM
-        );
-
         for field in fields {
 
             /**
@@ -308,161 +502,6 @@ class Sqlite extends PdoAdapter
         return columns;
     }
 
-    /**
-     * Lists table indexes
-     *
-     * <code>
-     * print_r(
-     *     $connection->describeIndexes("robots_parts")
-     * );
-     * </code>
-     */
-    public function describeIndexes(string! table, string! schema = null) -> <IndexInterface[]>
-    {
-        var indexes, index, keyName, indexObjects, name, columns,
-            describeIndexes, describeIndex, indexSql;
-
-        let indexes = [];
-
-        for index in this->fetchAll(this->dialect->describeIndexes(table, schema), Db::FETCH_ASSOC) {
-            let keyName = index["name"];
-
-            if !isset indexes[keyName] {
-                let indexes[keyName] = [];
-            }
-
-            if !isset indexes[keyName]["columns"] {
-                let columns = [];
-            } else {
-                let columns = indexes[keyName]["columns"];
-            }
-
-            let describeIndexes = this->fetchAll(
-                this->dialect->describeIndex(keyName),
-                Db::FETCH_ASSOC
-            );
-
-            for describeIndex in describeIndexes {
-                let columns[] = describeIndex["name"];
-            }
-
-            let indexes[keyName]["columns"] = columns;
-
-            let indexSql = this->fetchColumn(
-                this->dialect->listIndexesSql(table, schema, keyName)
-            );
-
-            if index["unique"] {
-                if preg_match("# UNIQUE #i", indexSql) {
-                    let indexes[keyName]["type"] = "UNIQUE";
-                } else {
-                    let indexes[keyName]["type"] = "PRIMARY";
-                }
-            } else {
-                let indexes[keyName]["type"] = null;
-            }
-        }
-
-        let indexObjects = [];
-
-        for name, index in indexes {
-            let indexObjects[name] = new Index(
-                name,
-                index["columns"],
-                index["type"]
-            );
-        }
-
-        return indexObjects;
-    }
-
-    /**
-     * Lists table references
-     */
-    public function describeReferences(string! table, string! schema = null) -> <ReferenceInterface[]>
-    {
-        var references, reference, arrayReference, constraintName,
-            referenceObjects, name, referencedSchema, referencedTable, columns,
-            referencedColumns, number;
-
-        let references = [];
-
-        for number, reference in this->fetchAll(this->dialect->describeReferences(table, schema), Db::FETCH_NUM) {
-            let constraintName = "foreign_key_" . number;
-
-            if !isset references[constraintName] {
-                let referencedSchema = null;
-                let referencedTable = reference[2];
-                let columns = [];
-                let referencedColumns = [];
-            } else {
-                let referencedSchema = references[constraintName]["referencedSchema"];
-                let referencedTable = references[constraintName]["referencedTable"];
-                let columns = references[constraintName]["columns"];
-                let referencedColumns = references[constraintName]["referencedColumns"];
-            }
-
-            let columns[] = reference[3],
-                referencedColumns[] = reference[4];
-
-            let references[constraintName] = [
-                "referencedSchema"  : referencedSchema,
-                "referencedTable"   : referencedTable,
-                "columns"           : columns,
-                "referencedColumns" : referencedColumns
-            ];
-        }
-
-        let referenceObjects = [];
-
-        for name, arrayReference in references {
-            let referenceObjects[name] = new Reference(
-                name,
-                [
-                    "referencedSchema"  : arrayReference["referencedSchema"],
-                    "referencedTable"   : arrayReference["referencedTable"],
-                    "columns"           : arrayReference["columns"],
-                    "referencedColumns" : arrayReference["referencedColumns"]
-                ]
-            );
-        }
-
-        return referenceObjects;
-    }
-
-    /**
-     * Returns the default value to make the RBDM use the default value declared
-     * in the table definition
-     *
-     *<code>
-     * // Inserting a new robot with a valid default value for the column 'year'
-     * $success = $connection->insert(
-     *     "robots",
-     *     [
-     *         "Astro Boy",
-     *         $connection->getDefaultValue(),
-     *     ],
-     *     [
-     *         "name",
-     *         "year",
-     *     ]
-     * );
-     *</code>
-     */
-    public function getDefaultValue() -> <RawValue>
-    {
-        return new RawValue("NULL");
-    }
-
-    /**
-     * Check whether the database system requires an explicit value for identity
-     * columns
-     */
-    public function useExplicitIdValue() -> bool
-    {
-        return true;
-    }
-
     /**
      * Returns PDO adapter DSN defaults as a key-value map.
      */
@@ -104,6 +104,12 @@ interface AdapterInterface
      */
     public function describeReferences(string! table, string schema = null) -> <ReferenceInterface[]>;
 
+    /**
+     * Returns the Phalcon\Db\Column objects of every table in a schema,
+     * indexed by table name
+     */
+    public function describeSchemaColumns(string schema = null) -> array;
+
     /**
      * Drops a column from a table
      */
@@ -305,6 +305,24 @@ class Mysql extends Dialect
         return sql;
     }
 
+    /**
+     * Generates SQL to describe the columns of every table in a schema. Every
+     * row starts with the table name followed by the same fields returned by
+     * describeColumns()
+     */
+    public function describeSchemaColumns(string schema = null) -> string
+    {
+        var sql = "SELECT TABLE_NAME, COLUMN_NAME, COLUMN_TYPE, IS_NULLABLE, COLUMN_KEY, COLUMN_DEFAULT, EXTRA FROM INFORMATION_SCHEMA.COLUMNS WHERE ";
+
+        if schema {
+            let sql .= "TABLE_SCHEMA = '" . schema . "'";
+        } else {
+            let sql .= "TABLE_SCHEMA = DATABASE()";
+        }
+
+        return sql . " ORDER BY TABLE_NAME, ORDINAL_POSITION";
+    }
+
     /**
      * Generates SQL to delete a column from a table
      */
@@ -282,6 +282,16 @@ class Sqlite extends Dialect
         return "PRAGMA foreign_key_list('" . table . "')";
     }
 
+    /**
+     * Generates SQL to describe the columns of every table in a schema. Every
+     * row starts with the table name followed by the same fields returned by
+     * describeColumns()
+     */
+    public function describeSchemaColumns(string schema = null) -> string
+    {
+        return "SELECT m.name, p.cid, p.name, p.type, p.\"notnull\", p.dflt_value, p.pk FROM sqlite_master AS m JOIN pragma_table_info(m.name) AS p WHERE m.type = 'table' AND m.name NOT LIKE 'sqlite_%' ORDER BY m.name, p.cid";
+    }
+
     /**
      * Generates SQL to delete a column from a table
      */
@@ -73,6 +73,11 @@ interface DialectInterface
      */
     public function describeReferences(string! table, string schema = null) -> string;
 
+    /**
+     * Generates SQL to describe the columns of every table in a schema
+     */
+    public function describeSchemaColumns(string schema = null) -> string;
+
     /**
      * Generates SQL to delete a column from a table
      */
@@ -0,0 +1,379 @@
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Db\Result;
+
+use Phalcon\Db;
+use Phalcon\Db\Exception;
+use Phalcon\Db\ResultInterface;
+
+/**
+ * Phalcon\Db\Result\Packed
+ *
+ * Resultset internals backed by a compact binary representation of the rows,
+ * used to store resultsets in the cache. The column names are stored once in a
+ * dictionary, followed by a table of row offsets and the typed, packed values
+ * of every row. Rows are only decoded when they are fetched, so reading a few
+ * rows of a big cached resultset costs proportionally to those rows.
+ *
+ * <code>
+ * $packed = \Phalcon\Db\Result\Packed::pack(
+ *     $connection->fetchAll("SELECT * FROM robots")
+ * );
+ *
+ * $result = new \Phalcon\Db\Result\Packed($packed);
+ *
+ * $result->dataSeek(2);
+ *
+ * print_r($result->fetch());
+ * </code>
+ */
+class Packed implements ResultInterface
+{
+    const FORMAT_SIGNATURE = "PHPK1";
+
+    const TYPE_FALSE = 6;
+    const TYPE_FLOAT = 2;
+    const TYPE_INTEGER = 1;
+    const TYPE_NULL = 0;
+    const TYPE_SERIALIZED = 7;
+    const TYPE_SHORT_STRING = 4;
+    const TYPE_STRING = 3;
+    const TYPE_TRUE = 5;
+
+    /**
+     * Column dictionary
+     *
+     * @var array
+     */
+    protected columns = [];
+
+    /**
+     * Packed rows
+     *
+     * @var string
+     */
+    protected data;
+
+    /**
+     * Position where the row data starts
+     *
+     * @var int
+     */
+    protected dataStart = 0;
+
+    /**
+     * Active fetch mode
+     */
+    protected fetchMode = Db::FETCH_ASSOC;
+
+    /**
+     * Position where the table of row offsets starts
+     *
+     * @var int
+     */
+    protected offsetsStart = 0;
+
+    /**
+     * Position of the next row to be fetched
+     *
+     * @var int
+     */
+    protected pointer = 0;
+
+    /**
+     * Number of packed rows
+     *
+     * @var int
+     */
+    protected rowCount = 0;
+
+    /**
+     * Phalcon\Db\Result\Packed constructor
+     *
+     * Only the header and the column dictionary are decoded here
+     */
+    public function __construct(string! data) -> void
+    {
+        var header, length;
+        int offset, columnCount, i;
+
+        if unlikely substr(data, 0, 5) !== self::FORMAT_SIGNATURE {
+            throw new Exception("Invalid packed resultset");
+        }
+
+        let header = unpack("N", data, 5),
+            columnCount = (int) header[1],
+            offset = 9,
+            i = 0;
+
+        while i < columnCount {
+            let header = unpack("n", data, offset),
+                length = header[1],
+                this->columns[] = substr(data, offset + 2, length),
+                offset = offset + 2 + length,
+                i++;
+        }
+
+        let header = unpack("N", data, offset);
+
+        let this->data = data,
+            this->rowCount = (int) header[1],
+            this->offsetsStart = offset + 4,
+            this->dataStart = offset + 4 + this->rowCount * 4;
+    }
+
+    /**
+     * Moves internal resultset cursor to another position letting us to fetch a
+     * certain row. Packed rows can be accessed randomly
+     */
+    public function dataSeek(long number) -> void
+    {
+        let this->pointer = number;
+    }
+
+    /**
+     * Moves the cursor back to the first row
+     */
+    public function execute() -> bool
+    {
+        let this->pointer = 0;
+
+        return true;
+    }
+
+    /**
+     * Decodes the row at the cursor position, or returns FALSE if there are no
+     * more rows. This method is affected by the active fetch flag set using
+     * `Phalcon\Db\Result\Packed::setFetchMode()`
+     */
+    public function $fetch()
+    {
+        var row;
+
+        if this->pointer >= this->rowCount {
+            return false;
+        }
+
+        let row = this->decodeRow(this->pointer);
+
+        let this->pointer++;
+
+        return row;
+    }
+
+    /**
+     * Returns an array with the remaining rows
+     */
+    public function fetchAll() -> array
+    {
+        var row;
+        array rows;
+
+        let rows = [];
+
+        loop {
+            let row = this->$fetch();
+
+            if row === false {
+                break;
+            }
+
+            let rows[] = row;
+        }
+
+        return rows;
+    }
+
+    /**
+     * Decodes the row at the cursor position, or returns FALSE if there are no
+     * more rows
+     */
+    public function fetchArray()
+    {
+        return this->$fetch();
+    }
+
+    /**
+     * Packed results don't have an internal PDO statement
+     */
+    public function getInternalResult()
+    {
+        return null;
+    }
+
+    /**
+     * Gets number of rows in the packed resultset
+     */
+    public function numRows() -> int
+    {
+        return this->rowCount;
+    }
+
+    /**
+     * Packs an array of rows. All rows are expected to have the keys of the
+     * first one
+     */
+    public static function pack(array! rows) -> string
+    {
+        var row, columns, column, value, offsets, body, header;
+        int length;
+
+        let columns = [],
+            offsets = "",
+            body = "";
+
+        for row in rows {
+            let columns = array_keys(row);
+
+            break;
+        }
+
+        let header = self::FORMAT_SIGNATURE . pack("N", count(columns));
+
+        for column in columns {
+            let header .= pack("n", strlen(column)) . column;
+        }
+
+        let header .= pack("N", count(rows));
+
+        for row in rows {
+            let offsets .= pack("N", strlen(body));
+
+            for column in columns {
+                if !fetch value, row[column] {
+                    let value = null;
+                }
+
+                if value === null {
+                    let body .= chr(self::TYPE_NULL);
+                } elseif typeof value == "string" {
+                    let length = strlen(value);
+
+                    if length < 256 {
+                        let body .= chr(self::TYPE_SHORT_STRING) . chr(length) . value;
+                    } else {
+                        let body .= chr(self::TYPE_STRING) . pack("N", length) . value;
+                    }
+                } elseif typeof value == "integer" {
+                    let body .= chr(self::TYPE_INTEGER) . pack("J", value);
+                } elseif typeof value == "double" {
+                    let body .= chr(self::TYPE_FLOAT) . pack("E", value);
+                } elseif value === true {
+                    let body .= chr(self::TYPE_TRUE);
+                } elseif value === false {
+                    let body .= chr(self::TYPE_FALSE);
+                } else {
+                    let value = serialize(value),
+                        body .= chr(self::TYPE_SERIALIZED) . pack("N", strlen(value)) . value;
+                }
+            }
+        }
+
+        return header . offsets . body;
+    }
+
+    /**
+     * Changes the fetching mode affecting Phalcon\Db\Result\Packed::fetch().
+     * Db::FETCH_ASSOC, Db::FETCH_NUM, Db::FETCH_BOTH and Db::FETCH_OBJ are
+     * supported
+     */
+    public function setFetchMode(int fetchMode) -> bool
+    {
+        if fetchMode != Db::FETCH_ASSOC && fetchMode != Db::FETCH_NUM && fetchMode != Db::FETCH_BOTH && fetchMode != Db::FETCH_OBJ {
+            return false;
+        }
+
+        let this->fetchMode = fetchMode;
+
+        return true;
+    }
+
+    /**
+     * Decodes a row by its position
+     */
+    protected function decodeRow(int position)
+    {
+        var data, column, header, value, row;
+        int offset, type, length;
+
+        let data = this->data,
+            header = unpack("N", data, this->offsetsStart + position * 4),
+            offset = this->dataStart + (int) header[1],
+            row = [];
+
+        for column in this->columns {
+            let header = unpack("C", data, offset),
+                type = (int) header[1],
+                offset++;
+
+            switch type {
+                case self::TYPE_NULL:
+                    let value = null;
+                    break;
+
+                case self::TYPE_SHORT_STRING:
+                    let header = unpack("C", data, offset),
+                        length = (int) header[1],
+                        value = substr(data, offset + 1, length),
+                        offset = offset + 1 + length;
+                    break;
+
+                case self::TYPE_INTEGER:
+                    let header = unpack("J", data, offset),
+                        value = header[1],
+                        offset = offset + 8;
+                    break;
+
+                case self::TYPE_FLOAT:
+                    let header = unpack("E", data, offset),
+                        value = header[1],
+                        offset = offset + 8;
+                    break;
+
+                case self::TYPE_TRUE:
+                    let value = true;
+                    break;
+
+                case self::TYPE_FALSE:
+                    let value = false;
+                    break;
+
+                case self::TYPE_SERIALIZED:
+                    let header = unpack("N", data, offset),
+                        length = (int) header[1],
+                        value = unserialize(substr(data, offset + 4, length)),
+                        offset = offset + 4 + length;
+                    break;
+
+                default:
+                    let header = unpack("N", data, offset),
+                        length = (int) header[1],
+                        value = substr(data, offset + 4, length),
+                        offset = offset + 4 + length;
+                    break;
+            }
+
+            let row[column] = value;
+        }
+
+        switch this->fetchMode {
+            case Db::FETCH_NUM:
+                return array_values(row);
+
+            case Db::FETCH_BOTH:
+                return array_merge(row, array_values(row));
+
+            case Db::FETCH_OBJ:
+                return (object) row;
+        }
+
+        return row;
+    }
+}
@@ -40,6 +40,55 @@ class Pdo implements ResultInterface
 
     protected bindTypes;
 
+    /**
+     * Rows kept in memory by the client-side buffer
+     *
+     * @var array
+     */
+    protected buffer = [];
+
+    /**
+     * Whether the underlying statement has been fully read into the buffer
+     *
+     * @var bool
+     */
+    protected bufferComplete = false;
+
+    /**
+     * Number of rows stored in the buffer (memory + spill)
+     *
+     * @var int
+     */
+    protected bufferCount = 0;
+
+    /**
+     * Offsets and lengths of the rows written to the spill stream
+     *
+     * @var array
+     */
+    protected bufferOffsets = [];
+
+    /**
+     * Position of the next row to be returned from the buffer
+     *
+     * @var int
+     */
+    protected bufferPointer = 0;
+
+    /**
+     * Maximum number of rows kept in memory. Zero disables the buffer
+     *
+     * @var int
+     */
+    protected bufferSize = 0;
+
+    /**
+     * Temporary stream receiving the rows that do not fit in memory
+     *
+     * @var resource
+     */
+    protected bufferSpill;
+
     protected connection;
 
     /**
@@ -101,6 +150,19 @@ class Pdo implements ResultInterface
         var connection, pdo, sqlStatement, bindParams, statement;
         long n;
 
+        /**
+         * Buffered results are served without touching the database
+         */
+        if this->bufferSize > 0 {
+            while this->bufferCount < number && !this->bufferComplete {
+                this->bufferNext();
+            }
+
+            let this->bufferPointer = number;
+
+            return;
+        }
+
         let connection = this->connection,
             pdo = connection->getInternalHandler(),
             sqlStatement = this->sqlStatement,
@@ -143,6 +205,15 @@ class Pdo implements ResultInterface
      */
     public function execute() -> bool
     {
+        /**
+         * Buffered results are replayed from the beginning of the buffer
+         */
+        if this->bufferSize > 0 {
+            let this->bufferPointer = 0;
+
+            return true;
+        }
+
         return this->pdoStatement->execute();
     }
 
@@ -165,6 +236,10 @@ class Pdo implements ResultInterface
      */
     public function $fetch(var fetchStyle = null, var cursorOrientation = null, var cursorOffset = null)
     {
+        if this->bufferSize > 0 {
+            return this->bufferFetch();
+        }
+
         return this->pdoStatement->$fetch(
             fetchStyle,
             cursorOrientation,
@@ -187,7 +262,27 @@ class Pdo implements ResultInterface
      */
     public function fetchAll(var fetchStyle = null, var fetchArgument = null, var ctorArgs = null) -> array
     {
-        var pdoStatement;
+        var pdoStatement, row;
+        array rows;
+
+        /**
+         * Buffered results always use the active fetch mode
+         */
+        if this->bufferSize > 0 {
+            let rows = [];
+
+            loop {
+                let row = this->bufferFetch();
+
+                if row === false {
+                    break;
+                }
+
+                let rows[] = row;
+            }
+
+            return rows;
+        }
 
         let pdoStatement = this->pdoStatement;
 
@@ -230,6 +325,10 @@ class Pdo implements ResultInterface
      */
     public function fetchArray()
     {
+        if this->bufferSize > 0 {
+            return this->bufferFetch();
+        }
+
         return this->pdoStatement->$fetch();
     }
 
@@ -271,6 +370,18 @@ class Pdo implements ResultInterface
                     rowCount = pdoStatement->rowCount();
             }
 
+            /**
+             * With the buffer enabled the remaining rows are read into it
+             * instead of running an extra COUNT(*) query
+             */
+            if rowCount === false && this->bufferSize > 0 {
+                while !this->bufferComplete {
+                    this->bufferNext();
+                }
+
+                let rowCount = this->bufferCount;
+            }
+
             /**
              * We should get the count using a new statement :(
              */
@@ -340,7 +451,7 @@ class Pdo implements ResultInterface
      */
     public function setFetchMode(int fetchMode, var colNoOrClassNameOrObject = null, var ctorargs = null) -> bool
     {
-        var pdoStatement;
+        var pdoStatement, pointer;
 
         let pdoStatement = this->pdoStatement;
 
@@ -360,6 +471,159 @@ class Pdo implements ResultInterface
 
         let this->fetchMode = fetchMode;
 
+        /**
+         * Rows already buffered were fetched with the previous mode: the
+         * statement is executed again and the rows up to the current position
+         * are buffered with the new one
+         */
+        if this->bufferCount > 0 {
+            let pointer = this->bufferPointer;
+
+            this->bufferReset();
+
+            if !pdoStatement->execute() {
+                return false;
+            }
+
+            this->dataSeek(pointer);
+        }
+
         return true;
     }
+
+    /**
+     * Enables an optional client-side buffer for the resultset. The first
+     * `size` rows are kept in memory, the rest are serialized to a temporary
+     * stream (`php://temp`, which is moved to a file on disk once it grows
+     * over `spillMemory` bytes). Backward seeks, `numRows()` and repeated
+     * iterations are then served from the buffer without re-running the SQL
+     * statement.
+     *
+     * The buffer must be enabled before any row is fetched. Buffered fetches
+     * always use the active fetch mode: changing it once rows are buffered
+     * executes the statement again to buffer them with the new mode.
+     *
+     *<code>
+     * $result = $connection->query("SELECT * FROM robots ORDER BY name");
+     *
+     * $result->useBuffer(500);
+     *
+     * // No COUNT(*) query on SQLite
+     * echo $result->numRows();
+     *
+     * // No re-execution of the query
+     * $result->dataSeek(0);
+     *</code>
+     */
+    public function useBuffer(int size = 1000, int spillMemory = 2097152) -> <ResultInterface>
+    {
+        this->bufferReset();
+
+        let this->bufferSize = size;
+
+        if size > 0 && typeof this->bufferSpill != "resource" {
+            let this->bufferSpill = fopen(
+                "php://temp/maxmemory:" . spillMemory,
+                "w+b"
+            );
+        }
+
+        return this;
+    }
+
+    /**
+     * Returns the row at the buffer pointer, reading a new row from the
+     * statement when the pointer reached the end of the buffer
+     */
+    protected function bufferFetch()
+    {
+        var row;
+
+        if this->bufferPointer < this->bufferCount {
+            let row = this->bufferRead(this->bufferPointer);
+        } else {
+            let row = this->bufferNext();
+        }
+
+        if row !== false {
+            let this->bufferPointer++;
+        }
+
+        return row;
+    }
+
+    /**
+     * Reads the next row from the statement and appends it to the buffer
+     */
+    protected function bufferNext()
+    {
+        var row, data, spill;
+
+        if this->bufferComplete {
+            return false;
+        }
+
+        let row = this->pdoStatement->$fetch();
+
+        if row === false {
+            let this->bufferComplete = true;
+
+            return false;
+        }
+
+        if this->bufferCount < this->bufferSize {
+            let this->buffer[] = row;
+        } else {
+            let spill = this->bufferSpill,
+                data = serialize(row);
+
+            fseek(spill, 0, SEEK_END);
+
+            let this->bufferOffsets[] = [ftell(spill), strlen(data)];
+
+            fwrite(spill, data);
+        }
+
+        let this->bufferCount++;
+
+        return row;
+    }
+
+    /**
+     * Returns a buffered row by its position
+     */
+    protected function bufferRead(int position)
+    {
+        var spill, offset;
+
+        if position < this->bufferSize {
+            return this->buffer[position];
+        }
+
+        let spill = this->bufferSpill,
+            offset = this->bufferOffsets[position - this->bufferSize];
+
+        fseek(spill, offset[0]);
+
+        return unserialize(
+            fread(spill, offset[1])
+        );
+    }
+
+    /**
+     * Releases the buffered rows. Rows that were already fetched are no
+     * longer reachable without re-executing the statement
+     */
+    protected function bufferReset() -> void
+    {
+        if typeof this->bufferSpill == "resource" {
+            ftruncate(this->bufferSpill, 0);
+        }
+
+        let this->buffer = [],
+            this->bufferComplete = false,
+            this->bufferCount = 0,
+            this->bufferOffsets = [],
+            this->bufferPointer = 0;
+    }
 }
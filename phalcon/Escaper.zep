@@ -151,6 +151,14 @@ class Escaper implements EscaperInterface
         return rawurlencode(url);
     }
 
+    /**
+     * Returns whether existing entities are encoded again by the escaper
+     */
+    public function getDoubleEncode() -> bool
+    {
+        return this->doubleEncode;
+    }
+
     /**
      * Returns the internal encoding used by the escaper
      */
@@ -159,6 +167,14 @@ class Escaper implements EscaperInterface
         return this->encoding;
     }
 
+    /**
+     * Returns the HTML quoting type used by the escaper for htmlspecialchars
+     */
+    public function getHtmlQuoteType() -> int
+    {
+        return this->htmlQuoteType;
+    }
+
     /**
      * Utility to normalize a string's encoding to UTF-32.
      */
@@ -1579,6 +1579,15 @@ abstract class Model implements EntityInterface, ModelInterface, ResultInterface
         return changed;
     }
 
+    /**
+     * Returns the related records assigned through the relation aliases and
+     * not saved yet, by lowercased alias
+     */
+    public function getDirtyRelated() -> array
+    {
+        return this->dirtyRelated;
+    }
+
     /**
      * Returns one of the DIRTY_STATE_* constants telling if the record exists
      * in the database or not
@@ -2751,7 +2760,8 @@ abstract class Model implements EntityInterface, ModelInterface, ResultInterface
             exceptionOnFailedSave, phqlLiterals, virtualForeignKeys,
             lateStateBinding, castOnHydrate, ignoreUnknownColumns,
             updateSnapshotOnSave, disableAssignSetters,
-            caseInsensitiveColumnMap, prefetchRecords, lastInsertId;
+            caseInsensitiveColumnMap, prefetchRecords, lastInsertId,
+            resultsetPacking;
 
         /**
          * Enables/Disables globally the internal events
@@ -2839,6 +2849,13 @@ abstract class Model implements EntityInterface, ModelInterface, ResultInterface
         if fetch lastInsertId, options["castLastInsertIdToInt"] {
             globals_set("orm.cast_last_insert_id_to_int", lastInsertId);
         }
+
+        /**
+         * Enables/Disables the compact binary format for cached resultsets
+         */
+        if fetch resultsetPacking, options["resultsetPacking"] {
+            globals_set("orm.resultset_packing", resultsetPacking);
+        }
     }
 
     /**
@@ -704,6 +704,111 @@ abstract class MetaData implements InjectionAwareInterface, MetaDataInterface
         let this->strategy = strategy;
     }
 
+    /**
+     * Loads the meta-data and column maps of many models in a single pass and
+     * stores them in the adapter. When the introspection strategy is used, the
+     * columns of all the tables sharing a connection and schema are described
+     * with a single query instead of one query per model
+     *
+     *<code>
+     * $metaData->warmup(
+     *     [
+     *         Robots::class,
+     *         RobotsParts::class,
+     *         new Parts(),
+     *     ]
+     * );
+     *</code>
+     */
+    public function warmup(array models) -> void
+    {
+        var model, source, schema, strategy, connection, groupKey, group,
+            tables, columns, modelMetadata, entry;
+        string key;
+        array groups;
+
+        let strategy = this->getStrategy(),
+            groups = [];
+
+        for model in models {
+            if typeof model == "string" {
+                let model = new {model}();
+            }
+
+            if unlikely typeof model != "object" || !(model instanceof ModelInterface) {
+                throw new Exception(
+                    "Models passed to warmup() must be class names or instances of Phalcon\\Mvc\\ModelInterface"
+                );
+            }
+
+            let source = model->getSource(),
+                schema = model->getSchema(),
+                key = get_class_lower(model) . "-" . schema . source;
+
+            /**
+             * Models already in memory or in the adapter, or models using their
+             * own metaData() method don't need introspection
+             */
+            if !isset this->metaData[key] {
+                let modelMetadata = this->{"read"}("meta-" . key);
+
+                if modelMetadata !== null {
+                    let this->metaData[key] = modelMetadata;
+                }
+            }
+
+            if isset this->metaData[key] || !(strategy instanceof Introspection) || method_exists(model, "metaData") {
+                this->initialize(model, key, source, schema);
+
+                continue;
+            }
+
+            /**
+             * Group the pending models by connection and schema
+             */
+            let connection = model->getReadConnection(),
+                groupKey = spl_object_hash(connection) . "-" . schema;
+
+            if !isset groups[groupKey] {
+                let groups[groupKey] = [connection, schema, []];
+            }
+
+            let groups[groupKey][2][] = [model, key, source];
+        }
+
+        for group in groups {
+            let connection = group[0],
+                schema = group[1];
+
+            if schema {
+                let tables = connection->describeSchemaColumns(schema);
+            } else {
+                let tables = connection->describeSchemaColumns();
+            }
+
+            for entry in group[2] {
+                let model = entry[0],
+                    key = entry[1],
+                    source = entry[2];
+
+                /**
+                 * Unknown tables are left to initialize() so that the usual
+                 * exception is thrown
+                 */
+                if fetch columns, tables[source] {
+                    if count(columns) {
+                        let modelMetadata = strategy->getMetaDataFromColumns(columns),
+                            this->metaData[key] = modelMetadata;
+
+                        this->{"write"}("meta-" . key, modelMetadata);
+                    }
+                }
+
+                this->initialize(model, key, source, schema);
+            }
+        }
+    }
+
     /**
      * Writes the metadata to adapter
      */
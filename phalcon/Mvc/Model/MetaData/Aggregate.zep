@@ -0,0 +1,288 @@
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Mvc\Model\MetaData;
+
+use Phalcon\Mvc\Model\MetaData;
+use Phalcon\Mvc\Model\Exception;
+
+/**
+ * Phalcon\Mvc\Model\MetaData\Aggregate
+ *
+ * Stores the meta-data and column maps of all models in a single generated PHP
+ * file (or in a fixed number of shards). Every shard is loaded with one
+ * `require`, so opcache serves the whole meta-data set as an immutable array.
+ * Shards are written to a temporary file and renamed, so readers never see a
+ * partially written file. Writers hold an exclusive lock on "metadata.lock"
+ * and merge their keys into the shard as currently stored, so concurrent
+ * processes do not overwrite each other's keys. The writes of warmup() are
+ * flushed once, at the end.
+ *
+ *<code>
+ * $metaData = new \Phalcon\Mvc\Model\MetaData\Aggregate(
+ *     [
+ *         "metaDataDir" => "app/cache/metadata/",
+ *         "shards"      => 4,
+ *     ]
+ * );
+ *</code>
+ */
+class Aggregate extends MetaData
+{
+    /**
+     * Whether the writes are queued until flush()
+     *
+     * @var bool
+     */
+    protected batching = false;
+
+    protected metaData = [];
+
+    protected metaDataDir = "./";
+
+    /**
+     * Writes queued while batching, by shard
+     *
+     * @var array
+     */
+    protected pending = [];
+
+    /**
+     * Loaded shards
+     *
+     * @var array
+     */
+    protected shards = [];
+
+    /**
+     * Number of files the meta-data is spread across
+     *
+     * @var int
+     */
+    protected shardsCount = 1;
+
+    /**
+     * Phalcon\Mvc\Model\MetaData\Aggregate constructor
+     *
+     * @param array options
+     */
+    public function __construct(options = null) -> void
+    {
+        var metaDataDir, shards;
+
+        if fetch metaDataDir, options["metaDataDir"] {
+            let this->metaDataDir = metaDataDir;
+        }
+
+        if fetch shards, options["shards"] {
+            if shards > 1 {
+                let this->shardsCount = (int) shards;
+            }
+        }
+    }
+
+    /**
+     * Writes the queued meta-data, once per shard
+     */
+    public function flush() -> void
+    {
+        var entries, index, pending;
+
+        let pending       = this->pending,
+            this->pending = [];
+
+        for index, entries in pending {
+            this->writeShard(index, entries);
+        }
+    }
+
+    /**
+     * Reads meta-data from the shard holding the key
+     */
+    public function read(string! key) -> array | null
+    {
+        var data, shard;
+
+        let shard = this->loadShard(
+            this->getShard(key)
+        );
+
+        if !fetch data, shard[key] {
+            return null;
+        }
+
+        return data;
+    }
+
+    /**
+     * Resets internal meta-data in order to regenerate it. The shards are
+     * loaded again from the files on the next read
+     */
+    public function reset() -> void
+    {
+        let this->shards = [];
+
+        parent::reset();
+    }
+
+    /**
+     * Initializes the meta-data of many models, writing every shard once
+     */
+    public function warmup(array models) -> void
+    {
+        var e;
+
+        let this->batching = true;
+
+        try {
+            parent::warmup(models);
+        } catch \Throwable, e {
+            let this->batching = false;
+
+            this->flush();
+
+            throw e;
+        }
+
+        let this->batching = false;
+
+        this->flush();
+    }
+
+    /**
+     * Writes the meta-data to the shard holding the key. While warming up the
+     * write is queued until the end
+     */
+    public function write(string! key, array data) -> void
+    {
+        int index;
+
+        let index = this->getShard(key);
+
+        if this->batching {
+            let this->pending[index][key] = data;
+
+            return;
+        }
+
+        this->writeShard(index, [key : data]);
+    }
+
+    /**
+     * Returns the shard a key belongs to
+     */
+    protected function getShard(string! key) -> int
+    {
+        if this->shardsCount == 1 {
+            return 0;
+        }
+
+        return abs(crc32(key)) % this->shardsCount;
+    }
+
+    /**
+     * Returns the path of a shard file
+     */
+    protected function getShardPath(int index) -> string
+    {
+        if this->shardsCount == 1 {
+            return this->metaDataDir . "metadata.php";
+        }
+
+        return this->metaDataDir . "metadata-" . index . ".php";
+    }
+
+    /**
+     * Loads a shard once per instance
+     */
+    protected function loadShard(int index) -> array
+    {
+        var path, shard;
+
+        if fetch shard, this->shards[index] {
+            return shard;
+        }
+
+        let path = this->getShardPath(index),
+            shard = null;
+
+        if file_exists(path) {
+            let shard = require path;
+        }
+
+        if typeof shard != "array" {
+            let shard = [];
+        }
+
+        let this->shards[index] = shard;
+
+        return shard;
+    }
+
+    /**
+     * Merges entries into a shard under the lock: the shard is read again
+     * from its file, written to a temporary file and moved over the previous
+     * one
+     */
+    protected function writeShard(int index, array entries) -> void
+    {
+        var data, handle, key, path, shard, tempPath;
+
+        let handle = fopen(this->metaDataDir . "metadata.lock", "c");
+
+        if unlikely handle === false || !flock(handle, LOCK_EX) {
+            throw new Exception("Meta-Data directory cannot be written");
+        }
+
+        let path  = this->getShardPath(index),
+            shard = null;
+
+        if file_exists(path) {
+            if function_exists("opcache_invalidate") {
+                opcache_invalidate(path, true);
+            }
+
+            let shard = require path;
+        }
+
+        if typeof shard != "array" {
+            let shard = [];
+        }
+
+        for key, data in entries {
+            let shard[key] = data;
+        }
+
+        let tempPath = path . "." . uniqid("", true) . ".tmp";
+
+        if file_put_contents(tempPath, "<?php return " . var_export(shard, true) . "; ") === false {
+            flock(handle, LOCK_UN);
+            fclose(handle);
+
+            throw new Exception("Meta-Data directory cannot be written");
+        }
+
+        if !rename(tempPath, path) {
+            unlink(tempPath);
+            flock(handle, LOCK_UN);
+            fclose(handle);
+
+            throw new Exception("Meta-Data directory cannot be written");
+        }
+
+        if function_exists("opcache_invalidate") {
+            opcache_invalidate(path, true);
+        }
+
+        flock(handle, LOCK_UN);
+        fclose(handle);
+
+        let this->shards[index] = shard;
+    }
+}
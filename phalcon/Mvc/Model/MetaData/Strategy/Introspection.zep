@@ -64,10 +64,7 @@ class Introspection implements StrategyInterface
      */
     final public function getMetaData(<ModelInterface> model, <DiInterface> container) -> array
     {
-        var schema, table, readConnection, columns, attributes, primaryKeys,
-            nonPrimaryKeys, numericTyped, notNull, fieldTypes, automaticDefault,
-            identityField, fieldBindTypes, defaultValues, column, fieldName,
-            defaultValue, emptyStringValues;
+        var schema, table, readConnection, columns;
         string completeTable;
 
         let schema = model->getSchema(),
@@ -113,6 +110,20 @@ class Introspection implements StrategyInterface
             );
         }
 
+        return this->getMetaDataFromColumns(columns);
+    }
+
+    /**
+     * Builds the meta-data of a model from the Phalcon\Db\Column objects
+     * describing its table. This allows the columns of many tables to be
+     * fetched at once using Phalcon\Db\AdapterInterface::describeSchemaColumns()
+     */
+    final public function getMetaDataFromColumns(array columns) -> array
+    {
+        var attributes, primaryKeys, nonPrimaryKeys, numericTyped, notNull,
+            fieldTypes, automaticDefault, identityField, fieldBindTypes,
+            defaultValues, column, fieldName, defaultValue, emptyStringValues;
+
         /**
          * Initialize meta-data
          */
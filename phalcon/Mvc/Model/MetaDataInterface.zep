@@ -150,6 +150,11 @@ interface MetaDataInterface
      */
     public function setEmptyStringAttributes(<ModelInterface> model, array attributes) -> void;
 
+    /**
+     * Loads the meta-data and column maps of many models in a single pass
+     */
+    public function warmup(array models) -> void;
+
     /**
      * Writes meta-data for certain model using a MODEL_* constant
      */
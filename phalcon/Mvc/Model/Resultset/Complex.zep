@@ -18,6 +18,7 @@ use Phalcon\Mvc\Model\Exception;
 use Phalcon\Mvc\Model\ResultsetInterface;
 use Phalcon\DiInterface;
 use Phalcon\Di;
+use Phalcon\Db\Result\Packed;
 use Phalcon\Cache\Adapter\AdapterInterface;
 use Phalcon\Storage\Serializer\SerializerInterface;
 
@@ -288,16 +289,29 @@ class Complex extends Resultset implements ResultsetInterface
      */
     public function serialize() -> string
     {
-        var records, cache, columnTypes, hydrateMode, container, serializer;
+        var records, container, serializer;
+        array data;
 
         /**
          * Obtain the records as an array
          */
         let records = this->toArray();
 
-        let cache       = this->cache,
-            columnTypes = this->columnTypes,
-            hydrateMode = this->hydrateMode;
+        let data = [
+            "cache"       : this->cache,
+            "columnTypes" : this->columnTypes,
+            "hydrateMode" : this->hydrateMode
+        ];
+
+        /**
+         * Rows hydrated as arrays are stored in a compact binary format
+         * decoded on access
+         */
+        if globals_get("orm.resultset_packing") && this->hydrateMode == Resultset::HYDRATE_ARRAYS {
+            let data["packed"] = Packed::pack(records);
+        } else {
+            let data["rows"] = records;
+        }
 
         let container = Di::getDefault();
 
@@ -310,26 +324,12 @@ class Complex extends Resultset implements ResultsetInterface
         if container->has("serializer") {
             let serializer = <SerializerInterface> container->getShared("serializer");
 
-            serializer->setData(
-                [
-                    "cache"       : cache,
-                    "rows"        : records,
-                    "columnTypes" : columnTypes,
-                    "hydrateMode" : hydrateMode
-                ]
-            );
+            serializer->setData(data);
 
             return serializer->serialize();
         }
 
-        return serialize(
-            [
-                "cache"       : cache,
-                "rows"        : records,
-                "columnTypes" : columnTypes,
-                "hydrateMode" : hydrateMode
-            ]
-        );
+        return serialize(data);
     }
 
     /**
@@ -337,7 +337,7 @@ class Complex extends Resultset implements ResultsetInterface
      */
     public function unserialize(var data) -> void
     {
-        var resultset, container, serializer;
+        var resultset, container, serializer, packed, result;
 
         /**
          * Rows are already hydrated
@@ -364,9 +364,20 @@ class Complex extends Resultset implements ResultsetInterface
             throw new Exception("Invalid serialization data");
         }
 
-        let this->rows        = resultset["rows"],
-            this->count       = count(resultset["rows"]),
-            this->cache       = resultset["cache"],
+        /**
+         * Packed rows are decoded lazily, one by one, as they are accessed
+         */
+        if fetch packed, resultset["packed"] {
+            let result       = new Packed(packed),
+                this->result = result,
+                this->rows   = null,
+                this->count  = result->numRows();
+        } else {
+            let this->rows  = resultset["rows"],
+                this->count = count(resultset["rows"]);
+        }
+
+        let this->cache       = resultset["cache"],
             this->columnTypes = resultset["columnTypes"],
             this->hydrateMode = resultset["hydrateMode"];
     }
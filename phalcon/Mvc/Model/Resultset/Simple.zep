@@ -11,6 +11,7 @@
 namespace Phalcon\Mvc\Model\Resultset;
 
 use Phalcon\Di;
+use Phalcon\Db\Result\Packed;
 use Phalcon\DiInterface;
 use Phalcon\Mvc\Model;
 use Phalcon\Mvc\Model\Exception;
@@ -249,12 +250,22 @@ class Simple extends Resultset
         let data = [
             "model"         : this->model,
             "cache"         : this->cache,
-            "rows"          : this->toArray(false),
             "columnMap"     : this->columnMap,
             "hydrateMode"   : this->hydrateMode,
             "keepSnapshots" : this->keepSnapshots
         ];
 
+        /**
+         * Rows are stored in a compact binary format decoded on access
+         */
+        if globals_get("orm.resultset_packing") {
+            let data["packed"] = Packed::pack(
+                this->toArray(false)
+            );
+        } else {
+            let data["rows"] = this->toArray(false);
+        }
+
         if container->has("serializer") {
             let serializer = <SerializerInterface> container->getShared("serializer");
             serializer->setData(data);
@@ -274,7 +285,7 @@ class Simple extends Resultset
      */
     public function unserialize(var data) -> void
     {
-        var resultset, keepSnapshots, container, serializer;
+        var resultset, keepSnapshots, container, serializer, packed, result;
 
         let container = Di::getDefault();
 
@@ -295,9 +306,20 @@ class Simple extends Resultset
             throw new Exception("Invalid serialization data");
         }
 
+        /**
+         * Packed rows are decoded lazily, one by one, as they are accessed
+         */
+        if fetch packed, resultset["packed"] {
+            let result       = new Packed(packed),
+                this->result = result,
+                this->rows   = null,
+                this->count  = result->numRows();
+        } else {
+            let this->rows  = resultset["rows"],
+                this->count = count(resultset["rows"]);
+        }
+
         let this->model       = resultset["model"],
-            this->rows        = resultset["rows"],
-            this->count       = count(resultset["rows"]),
             this->cache       = resultset["cache"],
             this->columnMap   = resultset["columnMap"],
             this->hydrateMode = resultset["hydrateMode"];
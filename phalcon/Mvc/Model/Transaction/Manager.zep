@@ -10,8 +10,14 @@
 
 namespace Phalcon\Mvc\Model\Transaction;
 
+use Phalcon\Db;
+use Phalcon\Db\AdapterInterface;
+use Phalcon\Db\RawValue;
 use Phalcon\DiInterface;
 use Phalcon\Di\InjectionAwareInterface;
+use Phalcon\Mvc\Model;
+use Phalcon\Mvc\ModelInterface;
+use Phalcon\Mvc\Model\Relation;
 use Phalcon\Mvc\Model\Transaction\ManagerInterface;
 use Phalcon\Mvc\Model\Transaction\Exception;
 use Phalcon\Mvc\Model\Transaction;
@@ -63,15 +69,40 @@ use Phalcon\Mvc\Model\TransactionInterface;
  *    echo "Failed, reason: ", $e->getMessage();
  * }
  *</code>
+ *
+ * The manager can also act as a unit of work: models queued with persist()
+ * and remove() are written together by flush(), in a single transaction and
+ * with a few coalesced statements per table.
  */
 class Manager implements ManagerInterface, InjectionAwareInterface
 {
     protected container;
 
+    /**
+     * Number of rows coalesced into a single statement by flush()
+     *
+     * @var int
+     */
+    protected flushBatchSize = 100;
+
     protected initialized = false;
 
     protected number = 0;
 
+    /**
+     * Models queued to be deleted by flush()
+     *
+     * @var array
+     */
+    protected pendingDeletes = [];
+
+    /**
+     * Models queued to be inserted or updated by flush()
+     *
+     * @var array
+     */
+    protected pendingSaves = [];
+
     protected rollbackPendent = true;
 
     protected service = "db";
@@ -101,6 +132,15 @@ class Manager implements ManagerInterface, InjectionAwareInterface
         }
     }
 
+    /**
+     * Discards the models queued with persist() and remove()
+     */
+    public function clearPending() -> void
+    {
+        let this->pendingSaves = [],
+            this->pendingDeletes = [];
+    }
+
     /**
      * Remove all the transactions from the manager
      */
@@ -135,6 +175,175 @@ class Manager implements ManagerInterface, InjectionAwareInterface
         }
     }
 
+    /**
+     * Writes the models queued with persist() and remove(). The statements
+     * are ordered by the belongsTo relations of the models, so parents are
+     * inserted before their children and deleted after them, and the rows of
+     * the same table are coalesced into multi-row INSERT, CASE-based UPDATE
+     * and IN/OR-based DELETE statements of up to `flushBatchSize` rows.
+     *
+     * The validation and before* events run for every model before any
+     * statement is sent; if one of them cancels the operation nothing is
+     * written and FALSE is returned. The after* events are replayed once all
+     * the statements succeeded. The writes run in their own transaction,
+     * unless the manager already has an active one.
+     *
+     * Unlike `Phalcon\Mvc\Model::save()` and `delete()`, flush() does not
+     * run the not null checks (`orm.not_null_validations`) nor the virtual
+     * foreign key checks and cascades of the relations: the database
+     * constraints are the only ones enforced. The parents assigned through a
+     * belongsTo alias are not saved either; when they are queued too, their
+     * keys are copied to the children once they are written, so the foreign
+     * keys of the children are not known yet while they are validated
+     *
+     * Every queued model must be written through the database service of the
+     * manager (see setDbService()), otherwise an exception is thrown before
+     * anything is written
+     *
+     *<code>
+     * $robot = new Robots();
+     *
+     * $robot->name = "WALL·E";
+     *
+     * $transactionManager->persist($robot);
+     * $transactionManager->remove($oldRobot);
+     *
+     * $transactionManager->flush();
+     *</code>
+     */
+    public function flush() -> bool
+    {
+        var model, hash, className, exists, classes, inserts, updates,
+            removals, order, transaction, connection, models, saved, deleted,
+            exception;
+        bool ownTransaction;
+
+        if !count(this->pendingSaves) && !count(this->pendingDeletes) {
+            return true;
+        }
+
+        for model in array_merge(this->pendingSaves, this->pendingDeletes) {
+            if unlikely model->getWriteConnectionService() !== this->service {
+                throw new Exception(
+                    "The model '" . get_class(model) . "' is written through the '" .
+                    model->getWriteConnectionService() . "' service, flush() only writes through '" .
+                    this->service . "'"
+                );
+            }
+        }
+
+        let exists = [],
+            classes = [],
+            inserts = [],
+            updates = [],
+            removals = [];
+
+        for hash, model in this->pendingSaves {
+            let exists[hash] = model->getDirtyState() == Model::DIRTY_STATE_PERSISTENT;
+
+            if this->fireBeforeSave(model, exists[hash]) === false {
+                return false;
+            }
+
+            let className = get_class_lower(model),
+                classes[className] = model;
+
+            if exists[hash] {
+                let updates[className][] = model;
+            } else {
+                let inserts[className][] = model;
+            }
+        }
+
+        for model in this->pendingDeletes {
+            if globals_get("orm.events") {
+                if model->fireEventCancel("beforeDelete") === false {
+                    return false;
+                }
+            }
+
+            let className = get_class_lower(model),
+                classes[className] = model,
+                removals[className][] = model;
+        }
+
+        let order = this->sortByDependency(classes),
+            ownTransaction = !this->has(),
+            transaction = this->get(),
+            connection = transaction->getConnection();
+
+        try {
+            for className in reverse order {
+                if fetch models, removals[className] {
+                    this->flushDeletes(connection, models);
+                }
+            }
+
+            for className in order {
+                if fetch models, inserts[className] {
+                    this->fillForeignKeys(models);
+                    this->flushInserts(connection, models);
+                }
+
+                if fetch models, updates[className] {
+                    this->fillForeignKeys(models);
+                    this->flushUpdates(connection, models);
+                }
+            }
+
+            if ownTransaction {
+                transaction->commit();
+            }
+        } catch \Throwable, exception {
+            if ownTransaction {
+                connection->rollback();
+
+                this->notifyRollback(transaction);
+            }
+
+            throw exception;
+        }
+
+        let saved = this->pendingSaves,
+            deleted = this->pendingDeletes;
+
+        /**
+         * The queues are emptied before replaying the events, so the
+         * listeners are free to queue new models
+         */
+        this->clearPending();
+
+        for hash, model in saved {
+            model->setDirtyState(Model::DIRTY_STATE_PERSISTENT);
+
+            if model->getModelsManager()->isKeepingSnapshots(model) && globals_get("orm.update_snapshot_on_save") {
+                model->setSnapshotData(
+                    model->toArray()
+                );
+            }
+
+            if globals_get("orm.events") {
+                if exists[hash] {
+                    model->fireEvent("afterUpdate");
+                } else {
+                    model->fireEvent("afterCreate");
+                }
+
+                model->fireEvent("afterSave");
+            }
+        }
+
+        for model in deleted {
+            model->setDirtyState(Model::DIRTY_STATE_DETACHED);
+
+            if globals_get("orm.events") {
+                model->fireEvent("afterDelete");
+            }
+        }
+
+        return true;
+    }
+
     /**
      * Returns a new \Phalcon\Mvc\Model\Transaction or an already created once
      * This method registers a shutdown function to rollback active connections
@@ -243,6 +452,33 @@ class Manager implements ManagerInterface, InjectionAwareInterface
         this->collectTransaction(transaction);
     }
 
+    /**
+     * Queues a model to be inserted or updated by the next flush(). New models
+     * are inserted, models loaded from the database are updated
+     */
+    public function persist(<ModelInterface> model) -> <ManagerInterface>
+    {
+        let this->pendingSaves[spl_object_hash(model)] = model;
+
+        return this;
+    }
+
+    /**
+     * Queues a model to be deleted by the next flush()
+     */
+    public function remove(<ModelInterface> model) -> <ManagerInterface>
+    {
+        var hash;
+
+        let hash = spl_object_hash(model);
+
+        unset this->pendingSaves[hash];
+
+        let this->pendingDeletes[hash] = model;
+
+        return this;
+    }
+
     /**
      * Rollbacks active transactions within the manager
      * Collect will remove the transaction from the manager
@@ -293,6 +529,21 @@ class Manager implements ManagerInterface, InjectionAwareInterface
         let this->container = container;
     }
 
+    /**
+     * Sets the maximum number of rows coalesced into a single statement by
+     * flush()
+     */
+    public function setFlushBatchSize(int flushBatchSize) -> <ManagerInterface>
+    {
+        if unlikely flushBatchSize < 1 {
+            throw new Exception("The flush batch size must be greater than zero");
+        }
+
+        let this->flushBatchSize = flushBatchSize;
+
+        return this;
+    }
+
     /**
      * Set if the transaction manager must register a shutdown function to clean
      * up pendent transactions
@@ -304,6 +555,84 @@ class Manager implements ManagerInterface, InjectionAwareInterface
         return this;
     }
 
+    /**
+     * Builds a multi-row INSERT for rows sharing the same columns
+     */
+    protected function buildInsert(<AdapterInterface> connection, string! escapedTable, array! rows, array! bindDataTypes) -> array
+    {
+        var row, field, value, bindType, escapedFields, tuple, tuples, bind,
+            bindTypes;
+
+        let escapedFields = [],
+            tuples = [],
+            bind = [],
+            bindTypes = [];
+
+        for field in array_keys(rows[0]) {
+            let escapedFields[] = connection->escapeIdentifier(field);
+        }
+
+        for row in rows {
+            let tuple = [];
+
+            for field, value in row {
+                if typeof value == "object" && value instanceof RawValue {
+                    let tuple[] = (string) value;
+
+                    continue;
+                }
+
+                if typeof value == "object" {
+                    let value = (string) value;
+                }
+
+                if value === null {
+                    let tuple[] = "null";
+
+                    continue;
+                }
+
+                if unlikely !fetch bindType, bindDataTypes[field] {
+                    throw new Exception(
+                        "Column '" . field . "' have not defined a bind data type"
+                    );
+                }
+
+                let tuple[] = "?",
+                    bind[] = value,
+                    bindTypes[] = bindType;
+            }
+
+            let tuples[] = "(" . join(", ", tuple) . ")";
+        }
+
+        return [
+            "INSERT INTO " . escapedTable . " (" . join(", ", escapedFields) . ") VALUES " . join(", ", tuples),
+            bind,
+            bindTypes
+        ];
+    }
+
+    /**
+     * Builds the WHERE clause matching the primary keys of a batch of rows
+     */
+    protected function buildKeyWhere(<AdapterInterface> connection, array! primaryKeys, array! keys) -> string
+    {
+        var key, conditions;
+
+        if count(primaryKeys) == 1 {
+            return connection->escapeIdentifier(primaryKeys[0]) . " IN (" . join(", ", array_fill(0, count(keys), "?")) . ")";
+        }
+
+        let conditions = [];
+
+        for key in keys {
+            let conditions[] = key[0];
+        }
+
+        return "(" . join(") OR (", conditions) . ")";
+    }
+
     /**
      * Removes transactions from the TransactionManager
      */
@@ -324,4 +653,540 @@ class Manager implements ManagerInterface, InjectionAwareInterface
 
         let this->transactions = newTransactions;
     }
+
+    /**
+     * Copies the keys of the parents assigned through a belongsTo alias to the
+     * foreign keys of the models. The parents queued in the same flush() are
+     * written first, so their generated identities are known
+     */
+    protected function fillForeignKeys(array! models) -> void
+    {
+        var model, alias, record, relation, fields, referencedFields,
+            position, field;
+
+        for model in models {
+            if !(model instanceof Model) {
+                continue;
+            }
+
+            for alias, record in model->getDirtyRelated() {
+                let relation = model->getModelsManager()->getRelationByAlias(
+                    get_class(model),
+                    alias
+                );
+
+                if typeof relation != "object" || relation->getType() != Relation::BELONGS_TO || typeof record != "object" {
+                    continue;
+                }
+
+                let fields = relation->getFields(),
+                    referencedFields = relation->getReferencedFields();
+
+                if typeof fields == "array" {
+                    for position, field in fields {
+                        model->writeAttribute(
+                            field,
+                            record->readAttribute(referencedFields[position])
+                        );
+                    }
+                } else {
+                    model->writeAttribute(
+                        fields,
+                        record->readAttribute(referencedFields)
+                    );
+                }
+            }
+        }
+    }
+
+    /**
+     * Runs the validation and before* events of a queued model
+     */
+    protected function fireBeforeSave(<ModelInterface> model, bool exists) -> bool
+    {
+        var eventName, eventNames;
+
+        if !globals_get("orm.events") {
+            return model->fireEventCancel("validation") !== false;
+        }
+
+        if exists {
+            let eventNames = [
+                "beforeValidation",
+                "beforeValidationOnUpdate",
+                "validation",
+                "afterValidationOnUpdate",
+                "afterValidation",
+                "beforeSave",
+                "beforeUpdate"
+            ];
+        } else {
+            let eventNames = [
+                "beforeValidation",
+                "beforeValidationOnCreate",
+                "validation",
+                "afterValidationOnCreate",
+                "afterValidation",
+                "beforeSave",
+                "beforeCreate"
+            ];
+        }
+
+        for eventName in eventNames {
+            if model->fireEventCancel(eventName) === false {
+                if eventName == "validation" {
+                    model->fireEvent("onValidationFails");
+                }
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Deletes the queued models of a class
+     */
+    protected function flushDeletes(<AdapterInterface> connection, array! models) -> void
+    {
+        var model, metaData, columnMap, primaryKeys, bindDataTypes,
+            escapedTable, chunk, key, keys, bind, bindTypes;
+
+        let model = models[0],
+            metaData = model->getModelsMetaData(),
+            primaryKeys = metaData->getPrimaryKeyAttributes(model),
+            bindDataTypes = metaData->getBindTypes(model),
+            escapedTable = connection->escapeIdentifier(
+                this->getModelTable(model)
+            );
+
+        if globals_get("orm.column_renaming") {
+            let columnMap = metaData->getColumnMap(model);
+        } else {
+            let columnMap = null;
+        }
+
+        for chunk in array_chunk(models, this->flushBatchSize) {
+            let keys = [],
+                bind = [],
+                bindTypes = [];
+
+            for model in chunk {
+                let key = this->getKeyCondition(connection, model, primaryKeys, bindDataTypes, columnMap),
+                    keys[] = key;
+
+                merge_append(bind, key[1]);
+                merge_append(bindTypes, key[2]);
+            }
+
+            connection->execute(
+                "DELETE FROM " . escapedTable . " WHERE " . this->buildKeyWhere(connection, primaryKeys, keys),
+                bind,
+                bindTypes
+            );
+        }
+    }
+
+    /**
+     * Inserts the queued models of a class. Rows with a known identity (or
+     * without an identity column) are coalesced into multi-row INSERTs. Rows
+     * waiting for a generated identity are coalesced only when the database
+     * can return the generated values (RETURNING), otherwise they are
+     * inserted one by one to recover each last insert id
+     */
+    protected function flushInserts(<AdapterInterface> connection, array! models) -> void
+    {
+        var model, metaData, columnMap, attributes, automaticAttributes,
+            defaultValues, bindDataTypes, identityField, identityAttribute,
+            fields, field, attributeField, value, row, explicitRows,
+            generatedRows, generatedModels, escapedTable, chunk, statement,
+            position, lastInsertedId, returned;
+
+        let model = models[0],
+            metaData = model->getModelsMetaData(),
+            attributes = metaData->getAttributes(model),
+            automaticAttributes = metaData->getAutomaticCreateAttributes(model),
+            defaultValues = metaData->getDefaultValues(model),
+            bindDataTypes = metaData->getBindTypes(model),
+            identityField = metaData->getIdentityField(model),
+            escapedTable = connection->escapeIdentifier(
+                this->getModelTable(model)
+            );
+
+        if globals_get("orm.column_renaming") {
+            let columnMap = metaData->getColumnMap(model);
+        } else {
+            let columnMap = null;
+        }
+
+        let fields = [];
+
+        for field in attributes {
+            let attributeField = this->getAttributeName(columnMap, field);
+
+            if field != identityField && !isset automaticAttributes[attributeField] {
+                let fields[field] = attributeField;
+            }
+        }
+
+        if identityField {
+            let identityAttribute = this->getAttributeName(columnMap, identityField);
+        }
+
+        let explicitRows = [],
+            generatedRows = [],
+            generatedModels = [];
+
+        for model in models {
+            let row = [];
+
+            for field, attributeField in fields {
+                let value = model->readAttribute(attributeField);
+
+                /**
+                 * Columns with a default value take it from the database
+                 * and the value is written back to the model, as save() does
+                 */
+                if value === null && isset defaultValues[field] {
+                    let value = connection->getDefaultValue();
+
+                    model->writeAttribute(attributeField, defaultValues[field]);
+                }
+
+                let row[field] = value;
+            }
+
+            if identityField {
+                let value = model->readAttribute(identityAttribute);
+
+                if value === null || value === "" {
+                    let generatedRows[] = row,
+                        generatedModels[] = model;
+
+                    continue;
+                }
+
+                let row[identityField] = value;
+            }
+
+            let explicitRows[] = row;
+        }
+
+        for chunk in array_chunk(explicitRows, this->flushBatchSize) {
+            let statement = this->buildInsert(connection, escapedTable, chunk, bindDataTypes);
+
+            connection->execute(statement[0], statement[1], statement[2]);
+        }
+
+        if !count(generatedRows) {
+            return;
+        }
+
+        let position = 0;
+
+        if connection->getDialectType() == "postgresql" {
+            for chunk in array_chunk(generatedRows, this->flushBatchSize) {
+                let statement = this->buildInsert(connection, escapedTable, chunk, bindDataTypes);
+
+                for returned in connection->fetchAll(statement[0] . " RETURNING " . connection->escapeIdentifier(identityField), Db::FETCH_NUM, statement[1], statement[2]) {
+                    let lastInsertedId = returned[0];
+
+                    if unlikely globals_get("orm.cast_last_insert_id_to_int") {
+                        let lastInsertedId = intval(lastInsertedId, 10);
+                    }
+
+                    let model = generatedModels[position];
+
+                    model->writeAttribute(identityAttribute, lastInsertedId);
+
+                    let position++;
+                }
+            }
+
+            return;
+        }
+
+        for row in generatedRows {
+            let statement = this->buildInsert(connection, escapedTable, [row], bindDataTypes);
+
+            connection->execute(statement[0], statement[1], statement[2]);
+
+            let lastInsertedId = connection->lastInsertId();
+
+            if unlikely globals_get("orm.cast_last_insert_id_to_int") {
+                let lastInsertedId = intval(lastInsertedId, 10);
+            }
+
+            let model = generatedModels[position];
+
+            model->writeAttribute(identityAttribute, lastInsertedId);
+
+            let position++;
+        }
+    }
+
+    /**
+     * Updates the queued models of a class with one CASE-based UPDATE per
+     * batch. Models using dynamic update only write their changed columns
+     */
+    protected function flushUpdates(<AdapterInterface> connection, array! models) -> void
+    {
+        var model, metaData, columnMap, primaryKeys, nonPrimaryKeys,
+            automaticAttributes, bindDataTypes, dynamicUpdate, changedFields,
+            field, attributeField, value, bindType, escapedTable, escapedField,
+            chunk, key, keys, cases, rows, row, sets, clause, bind, bindTypes;
+        bool changed;
+
+        let model = models[0],
+            metaData = model->getModelsMetaData(),
+            primaryKeys = metaData->getPrimaryKeyAttributes(model),
+            nonPrimaryKeys = metaData->getNonPrimaryKeyAttributes(model),
+            automaticAttributes = metaData->getAutomaticUpdateAttributes(model),
+            bindDataTypes = metaData->getBindTypes(model),
+            dynamicUpdate = model->getModelsManager()->isUsingDynamicUpdate(model),
+            escapedTable = connection->escapeIdentifier(
+                this->getModelTable(model)
+            );
+
+        if globals_get("orm.column_renaming") {
+            let columnMap = metaData->getColumnMap(model);
+        } else {
+            let columnMap = null;
+        }
+
+        for chunk in array_chunk(models, this->flushBatchSize) {
+            let cases = [],
+                keys = [];
+
+            for model in chunk {
+                let key = this->getKeyCondition(connection, model, primaryKeys, bindDataTypes, columnMap),
+                    changedFields = null,
+                    changed = false;
+
+                if dynamicUpdate && model->hasSnapshotData() {
+                    let changedFields = model->getChangedFields();
+                }
+
+                for field in nonPrimaryKeys {
+                    let attributeField = this->getAttributeName(columnMap, field);
+
+                    if isset automaticAttributes[attributeField] {
+                        continue;
+                    }
+
+                    if typeof changedFields == "array" && !in_array(attributeField, changedFields) {
+                        continue;
+                    }
+
+                    let cases[field][] = [key, model->readAttribute(attributeField)],
+                        changed = true;
+                }
+
+                if changed {
+                    let keys[] = key;
+                }
+            }
+
+            if !count(keys) {
+                continue;
+            }
+
+            let sets = [],
+                bind = [],
+                bindTypes = [];
+
+            for field, rows in cases {
+                let escapedField = connection->escapeIdentifier(field),
+                    clause = escapedField . " = CASE";
+
+                for row in rows {
+                    let key = row[0],
+                        value = row[1],
+                        clause .= " WHEN " . key[0] . " THEN ";
+
+                    merge_append(bind, key[1]);
+                    merge_append(bindTypes, key[2]);
+
+                    if typeof value == "object" && value instanceof RawValue {
+                        let clause .= (string) value;
+
+                        continue;
+                    }
+
+                    if typeof value == "object" {
+                        let value = (string) value;
+                    }
+
+                    if value === null {
+                        let clause .= "null";
+
+                        continue;
+                    }
+
+                    if unlikely !fetch bindType, bindDataTypes[field] {
+                        throw new Exception(
+                            "Column '" . field . "' have not defined a bind data type"
+                        );
+                    }
+
+                    let clause .= "?",
+                        bind[] = value,
+                        bindTypes[] = bindType;
+                }
+
+                /**
+                 * Rows not changing the column keep their current value
+                 */
+                let sets[] = clause . " ELSE " . escapedField . " END";
+            }
+
+            for key in keys {
+                merge_append(bind, key[1]);
+                merge_append(bindTypes, key[2]);
+            }
+
+            connection->execute(
+                "UPDATE " . escapedTable . " SET " . join(", ", sets) . " WHERE " . this->buildKeyWhere(connection, primaryKeys, keys),
+                bind,
+                bindTypes
+            );
+        }
+    }
+
+    /**
+     * Returns the model attribute a column is mapped to
+     */
+    protected function getAttributeName(var columnMap, string! field) -> string
+    {
+        var attributeField;
+
+        if typeof columnMap != "array" {
+            return field;
+        }
+
+        if unlikely !fetch attributeField, columnMap[field] {
+            throw new Exception(
+                "Column '" . field . "' isn't part of the column map"
+            );
+        }
+
+        return attributeField;
+    }
+
+    /**
+     * Returns the primary key condition of a queued model as an array with the
+     * SQL condition, the bound values and their bind types
+     */
+    protected function getKeyCondition(<AdapterInterface> connection, <ModelInterface> model, array! primaryKeys, array! bindDataTypes, var columnMap) -> array
+    {
+        var field, value, bindType, conditions, bind, bindTypes;
+
+        if unlikely !count(primaryKeys) {
+            throw new Exception(
+                "A primary key must be defined in the model in order to perform the operation in '" . get_class(model) . "'"
+            );
+        }
+
+        let conditions = [],
+            bind = [],
+            bindTypes = [];
+
+        for field in primaryKeys {
+            let value = model->readAttribute(
+                this->getAttributeName(columnMap, field)
+            );
+
+            if unlikely value === null {
+                throw new Exception(
+                    "Cannot flush a record of '" . get_class(model) . "' without a value for the primary key '" . field . "'"
+                );
+            }
+
+            if unlikely !fetch bindType, bindDataTypes[field] {
+                throw new Exception(
+                    "Column '" . field . "' have not defined a bind data type"
+                );
+            }
+
+            let conditions[] = connection->escapeIdentifier(field) . " = ?",
+                bind[] = value,
+                bindTypes[] = bindType;
+        }
+
+        return [
+            join(" AND ", conditions),
+            bind,
+            bindTypes
+        ];
+    }
+
+    /**
+     * Returns the table of a model, qualified with its schema
+     */
+    protected function getModelTable(<ModelInterface> model)
+    {
+        var schema;
+
+        let schema = model->getSchema();
+
+        if schema {
+            return [schema, model->getSource()];
+        }
+
+        return model->getSource();
+    }
+
+    /**
+     * Orders the classes of the queued models so the referenced (belongsTo)
+     * classes come first. Circular references keep the queued order
+     */
+    protected function sortByDependency(array! classes) -> array
+    {
+        var className, model, relation, referencedModel, dependencies,
+            references, pending, remaining, sorted;
+
+        let dependencies = [];
+
+        for className, model in classes {
+            let dependencies[className] = [];
+
+            for relation in model->getModelsManager()->getBelongsTo(model) {
+                let referencedModel = strtolower(
+                    ltrim(relation->getReferencedModel(), "\\")
+                );
+
+                if referencedModel != className && isset classes[referencedModel] {
+                    let dependencies[className][] = referencedModel;
+                }
+            }
+        }
+
+        let sorted = [],
+            pending = dependencies;
+
+        while count(pending) {
+            let remaining = [];
+
+            for className, references in pending {
+                if count(array_diff(references, array_keys(sorted))) {
+                    let remaining[className] = references;
+                } else {
+                    let sorted[className] = true;
+                }
+            }
+
+            if count(remaining) == count(pending) {
+                for className in array_keys(remaining) {
+                    let sorted[className] = true;
+                }
+
+                break;
+            }
+
+            let pending = remaining;
+        }
+
+        return array_keys(sorted);
+    }
 }
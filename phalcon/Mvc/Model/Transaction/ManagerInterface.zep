@@ -10,6 +10,7 @@
 
 namespace Phalcon\Mvc\Model\Transaction;
 
+use Phalcon\Mvc\ModelInterface;
 use Phalcon\Mvc\Model\TransactionInterface;
 
 /**
@@ -19,6 +20,11 @@ use Phalcon\Mvc\Model\TransactionInterface;
  */
 interface ManagerInterface
 {
+    /**
+     * Discards the models queued with persist() and remove()
+     */
+    public function clearPending() -> void;
+
     /**
      * Remove all the transactions from the manager
      */
@@ -29,6 +35,12 @@ interface ManagerInterface
      */
     public function commit();
 
+    /**
+     * Writes the models queued with persist() and remove() in a single
+     * transaction
+     */
+    public function flush() -> bool;
+
     /**
      * Returns a new \Phalcon\Mvc\Model\Transaction or an already created once
      */
@@ -59,6 +71,16 @@ interface ManagerInterface
      */
     public function notifyRollback(<TransactionInterface> transaction) -> void;
 
+    /**
+     * Queues a model to be inserted or updated by the next flush()
+     */
+    public function persist(<ModelInterface> model) -> <ManagerInterface>;
+
+    /**
+     * Queues a model to be deleted by the next flush()
+     */
+    public function remove(<ModelInterface> model) -> <ManagerInterface>;
+
     /**
      * Rollbacks active transactions within the manager
      * Collect will remove transaction from the manager
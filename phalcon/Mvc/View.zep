@@ -14,8 +14,10 @@ use Phalcon\DiInterface;
 use Phalcon\Di\Injectable;
 use Phalcon\Events\ManagerInterface;
 use Phalcon\Helper\Arr;
+use Phalcon\Http\ResponseInterface;
 use Phalcon\Helper\Str;
 use Phalcon\Mvc\View\Exception;
+use Phalcon\Mvc\View\PathCache;
 use Phalcon\Mvc\ViewInterface;
 use Phalcon\Mvc\View\Engine\Php as PhpEngine;
 
@@ -44,6 +46,25 @@ use Phalcon\Mvc\View\Engine\Php as PhpEngine;
  * // Printing views output
  * echo $view->getContent();
  * </code>
+ *
+ * The files resolved for every view can be cached with the "pathCache"
+ * option, either in memory (true), shared by the components of the process
+ * with the same directories and engines (the whole process in long running
+ * workers, the request under PHP-FPM), or in a cache (Phalcon\Storage
+ * adapter or PSR-16 cache) shared across requests. The files resolved
+ * during a render are saved once, at its end. The persisted entries are
+ * invalidated by "pathCacheLifetime" or when the file set as
+ * "pathCacheManifest" is modified
+ *
+ * <code>
+ * $view = new View(
+ *     [
+ *         "pathCache"         => $cache,
+ *         "pathCacheLifetime" => 3600,
+ *         "pathCacheManifest" => "app/cache/volt/manifest.php",
+ *     ]
+ * );
+ * </code>
  */
 class View extends Injectable implements ViewInterface
 {
@@ -95,6 +116,42 @@ class View extends Injectable implements ViewInterface
     protected partialsDir = "";
     protected registeredEngines = [] { get };
     protected renderLevel = 5 { get };
+
+    /**
+     * Files resolved for the views, with the "pathCache" option
+     *
+     * @var \Phalcon\Mvc\View\PathCache | null
+     */
+    protected pathCache = null;
+
+    /**
+     * Whether a render is in progress
+     *
+     * @var bool
+     */
+    protected rendering = false;
+
+    /**
+     * Whether the layouts are streamed to the client
+     *
+     * @var bool
+     */
+    protected streaming = false;
+
+    /**
+     * Output buffering level the streamed view is rendered in
+     *
+     * @var int
+     */
+    protected streamLevel = 0;
+
+    /**
+     * Render stages not yet rendered by a streamed view, innermost first
+     *
+     * @var array
+     */
+    protected streamStages = [];
+
     protected templatesAfter = [];
     protected templatesBefore = [];
     protected viewsDirs = [];
@@ -210,10 +267,9 @@ class View extends Injectable implements ViewInterface
      */
     public function exists(string! view) -> bool
     {
-        var basePath, viewsDir, engines, extension;
+        var engines, exists;
 
-        let basePath = this->basePath,
-            engines  = this->registeredEngines;
+        let engines = this->registeredEngines;
 
         if empty engines {
             let engines = [
@@ -223,15 +279,11 @@ class View extends Injectable implements ViewInterface
             this->registerEngines(engines);
         }
 
-        for viewsDir in this->getViewsDirs() {
-            for extension, _ in engines {
-                if file_exists(basePath . viewsDir . view . extension) {
-                    return true;
-                }
-            }
-        }
+        let exists = count(this->resolveViewPaths(engines, view)) > 0;
 
-        return false;
+        this->saveResolvedPaths();
+
+        return exists;
     }
 
     /**
@@ -244,6 +296,45 @@ class View extends Injectable implements ViewInterface
         return this;
     }
 
+    /**
+     * Sends the output of a streamed view rendered so far to the client. The
+     * headers and cookies of the "response" service are sent first. Calls
+     * made inside a nested output buffer (partials captured with
+     * getPartial(), cache blocks) or when the view is not streamed are
+     * ignored
+     *
+     *<code>
+     * {# app/views/index.volt #}
+     * <head>...</head>
+     * {{ flush() }}
+     * <body>{{ content() }}</body>
+     *</code>
+     */
+    public function flush() -> <View>
+    {
+        var container, response;
+
+        if !this->streaming || ob_get_level() !== this->streamLevel {
+            return this;
+        }
+
+        if !headers_sent() {
+            let container = this->container;
+
+            if typeof container == "object" && container->has("response") {
+                let response = <ResponseInterface> container->getShared("response");
+
+                response->sendHeaders();
+                response->sendCookies();
+            }
+        }
+
+        ob_flush();
+        flush();
+
+        return this;
+    }
+
     /**
      * Gets the name of the action rendered
      */
@@ -285,10 +376,15 @@ class View extends Injectable implements ViewInterface
     }
 
     /**
-     * Returns output from another view stage
+     * Returns output from another view stage. When the view is streamed the
+     * previous stage is rendered straight to the output instead
      */
     public function getContent() -> string
     {
+        if this->streaming && this->renderStreamStage() {
+            return "";
+        }
+
         return this->content;
     }
 
@@ -475,6 +571,14 @@ class View extends Injectable implements ViewInterface
         return this->disabled;
     }
 
+    /**
+     * Whether the layouts are streamed to the client
+     */
+    public function isStreaming() -> bool
+    {
+        return this->streaming;
+    }
+
     /**
      * Renders a partial view
      *
@@ -537,6 +641,11 @@ class View extends Injectable implements ViewInterface
              */
             let this->viewParams = viewParams;
         }
+
+        /**
+         * Partials rendered outside of render()
+         */
+        this->saveResolvedPaths();
     }
 
     /**
@@ -598,7 +707,8 @@ class View extends Injectable implements ViewInterface
      */
     public function registerEngines(array! engines) -> <View>
     {
-        let this->registeredEngines = engines;
+        let this->registeredEngines = engines,
+            this->pathCache         = null;
 
         return this;
     }
@@ -617,9 +727,22 @@ class View extends Injectable implements ViewInterface
         array params = []
     ) -> <View> | bool
     {
-        var result;
+        var exception, rendering, result;
 
-        let result = this->processRender(controllerName, actionName, params);
+        let rendering       = this->rendering,
+            this->rendering = true;
+
+        try {
+            let result = this->processRender(controllerName, actionName, params);
+        } catch \Throwable, exception {
+            let this->rendering = rendering;
+
+            throw exception;
+        }
+
+        let this->rendering = rendering;
+
+        this->saveResolvedPaths();
 
         if !result {
             return false;
@@ -653,7 +776,8 @@ class View extends Injectable implements ViewInterface
      */
     public function setBasePath(string basePath) -> <View>
     {
-        let this->basePath = basePath;
+        let this->basePath  = basePath,
+            this->pathCache = null;
 
         return this;
     }
@@ -766,6 +890,23 @@ class View extends Injectable implements ViewInterface
         return this;
     }
 
+    /**
+     * Enables or disables streaming. A streamed view renders the outermost
+     * layout first, the inner stages are rendered where `content()` is
+     * called, so the output can be sent to the client with `flush()` while
+     * the rest of the page is rendered
+     *
+     * <code>
+     * $this->view->setStreaming(true);
+     * </code>
+     */
+    public function setStreaming(bool streaming) -> <View>
+    {
+        let this->streaming = streaming;
+
+        return this;
+    }
+
     /**
      * Sets a "template after" controller layout
      */
@@ -860,6 +1001,8 @@ class View extends Injectable implements ViewInterface
             let this->viewsDirs = newViewsDir;
         }
 
+        let this->pathCache = null;
+
         return this;
     }
 
@@ -884,7 +1027,13 @@ class View extends Injectable implements ViewInterface
         array params = []
     ) -> string
     {
-        var result;
+        var result, streaming;
+
+        /**
+         * The rendered string is returned, so it can't be streamed
+         */
+        let streaming       = this->streaming,
+            this->streaming = false;
 
         this->start();
 
@@ -897,6 +1046,8 @@ class View extends Injectable implements ViewInterface
 
         this->finish();
 
+        let this->streaming = streaming;
+
         if !result {
             return "";
         }
@@ -915,55 +1066,46 @@ class View extends Injectable implements ViewInterface
     ) {
         bool notExists;
         var basePath, engine, eventsManager, extension, viewsDir, viewsDirPath,
-            viewEnginePath, viewEnginePaths, viewParams;
+            viewsDirPaths, viewEnginePath, viewEnginePaths, viewParams;
 
-        let notExists       = true,
-            basePath        = this->basePath,
-            viewParams      = this->viewParams,
-            eventsManager   = <ManagerInterface> this->eventsManager,
-            viewEnginePaths = [];
+        let notExists     = true,
+            viewParams    = this->viewParams,
+            eventsManager = <ManagerInterface> this->eventsManager;
 
-        for viewsDir in this->getViewsDirs() {
-            if !this->isAbsolutePath(viewPath) {
-                let viewsDirPath = basePath . viewsDir . viewPath;
-            } else {
-                let viewsDirPath = viewPath;
-            }
+        /**
+         * Views are rendered in each views directory, with the first engine
+         * having a file for the view that is not cancelled by
+         * beforeRenderView
+         */
+        for viewsDirPaths in this->resolveViewPaths(engines, viewPath) {
+            for extension, viewEnginePath in viewsDirPaths {
+                let engine = engines[extension];
 
-            /**
-             * Views are rendered in each engine
-             */
-            for extension, engine in engines {
-                let viewEnginePath = viewsDirPath . extension;
-
-                if file_exists(viewEnginePath) {
-                    /**
-                     * Call beforeRenderView if there is an events manager
-                     * available
-                     */
-                    if typeof eventsManager == "object" {
-                        let this->activeRenderPaths = [viewEnginePath];
-
-                        if eventsManager->fire("view:beforeRenderView", this, viewEnginePath) === false {
-                            continue;
-                        }
+                /**
+                 * Call beforeRenderView if there is an events manager
+                 * available
+                 */
+                if typeof eventsManager == "object" {
+                    let this->activeRenderPaths = [viewEnginePath];
+
+                    if eventsManager->fire("view:beforeRenderView", this, viewEnginePath) === false {
+                        continue;
                     }
+                }
 
-                    engine->render(viewEnginePath, viewParams, mustClean);
+                engine->render(viewEnginePath, viewParams, mustClean);
 
-                    /**
-                     * Call afterRenderView if there is an events manager
-                     * available
-                     */
-                    let notExists = false;
+                /**
+                 * Call afterRenderView if there is an events manager
+                 * available
+                 */
+                let notExists = false;
 
-                    if typeof eventsManager == "object" {
-                        eventsManager->fire("view:afterRenderView", this);
-                    }
-                    break;
+                if typeof eventsManager == "object" {
+                    eventsManager->fire("view:afterRenderView", this);
                 }
 
-                let viewEnginePaths[] = viewEnginePath;
+                break;
             }
         }
 
@@ -972,6 +1114,22 @@ class View extends Injectable implements ViewInterface
              * Notify about not found views
              */
             if typeof eventsManager == "object" {
+                let basePath        = this->basePath,
+                    viewEnginePaths = [];
+
+                for viewsDir in this->getViewsDirs() {
+                    if !this->isAbsolutePath(viewPath) {
+                        let viewsDirPath = basePath . viewsDir . viewPath;
+                    } else {
+                        let viewsDirPath = viewPath;
+                    }
+
+                    for extension, _ in engines {
+                        let viewEnginePath    = viewsDirPath . extension,
+                            viewEnginePaths[] = viewEnginePath;
+                    }
+                }
+
                 let this->activeRenderPaths = viewEnginePaths;
 
                 eventsManager->fire("view:notFoundView", this, viewEnginePath);
@@ -1186,7 +1344,14 @@ class View extends Injectable implements ViewInterface
          */
         let renderLevel = (int) this->renderLevel;
 
-        if renderLevel {
+        if renderLevel && this->streaming {
+            this->processStreamRender(
+                renderView,
+                layoutsDir,
+                layoutName,
+                renderLevel
+            );
+        } elseif renderLevel {
             /**
              * Inserts view related to action
              */
@@ -1286,4 +1451,175 @@ class View extends Injectable implements ViewInterface
 
         return true;
     }
+
+    /**
+     * Renders the enabled stages of a streamed view. Only the outermost stage
+     * is rendered here, every stage renders the previous one when it asks for
+     * its content
+     */
+    protected function processStreamRender(
+        string renderView,
+        string layoutsDir,
+        string layoutName,
+        int renderLevel
+    ) -> void
+    {
+        var disabledLevels, template;
+        array stages;
+
+        let disabledLevels = this->disabledLevels,
+            stages         = [];
+
+        if renderLevel >= self::LEVEL_ACTION_VIEW && !isset disabledLevels[self::LEVEL_ACTION_VIEW] {
+            let stages[] = [self::LEVEL_ACTION_VIEW, renderView, true];
+        }
+
+        if renderLevel >= self::LEVEL_BEFORE_TEMPLATE && !isset disabledLevels[self::LEVEL_BEFORE_TEMPLATE] {
+            for template in this->templatesBefore {
+                let stages[] = [self::LEVEL_BEFORE_TEMPLATE, layoutsDir . template, false];
+            }
+        }
+
+        if renderLevel >= self::LEVEL_LAYOUT && !isset disabledLevels[self::LEVEL_LAYOUT] {
+            let stages[] = [self::LEVEL_LAYOUT, layoutsDir . layoutName, true];
+        }
+
+        if renderLevel >= self::LEVEL_AFTER_TEMPLATE && !isset disabledLevels[self::LEVEL_AFTER_TEMPLATE] {
+            for template in this->templatesAfter {
+                let stages[] = [self::LEVEL_AFTER_TEMPLATE, layoutsDir . template, false];
+            }
+        }
+
+        if renderLevel >= self::LEVEL_MAIN_LAYOUT && !isset disabledLevels[self::LEVEL_MAIN_LAYOUT] {
+            let stages[] = [self::LEVEL_MAIN_LAYOUT, this->mainView, true];
+        }
+
+        if !count(stages) {
+            return;
+        }
+
+        /**
+         * The output produced by the controller is only available through
+         * getContent(), as it happens when the stages are buffered
+         */
+        ob_clean();
+
+        let this->streamStages = stages,
+            this->streamLevel  = ob_get_level();
+
+        this->renderStreamStage();
+
+        let this->streamStages       = [],
+            this->currentRenderLevel = 0,
+            this->content            = ob_get_contents();
+    }
+
+    /**
+     * Returns the files of a view in every views directory that has one, as
+     * arrays of extension => path pairs in the order of the engines. Views
+     * are resolved once with the "pathCache" option, missing views included
+     */
+    protected function resolveViewPaths(array engines, string viewPath) -> array
+    {
+        var basePath, cache, extension, paths, resolved, viewsDir,
+            viewsDirPath;
+        array viewsDirsPaths;
+
+        if !fetch cache, this->options["pathCache"] {
+            let cache = false;
+        }
+
+        if cache {
+            if this->pathCache === null {
+                let this->pathCache = new PathCache(
+                    cache,
+                    [
+                        this->basePath,
+                        this->getViewsDirs(),
+                        array_keys(engines)
+                    ],
+                    this->options
+                );
+            }
+
+            let resolved = this->pathCache->get(viewPath);
+
+            if resolved !== null {
+                return resolved;
+            }
+        }
+
+        let basePath       = this->basePath,
+            viewsDirsPaths = [];
+
+        for viewsDir in this->getViewsDirs() {
+            if !this->isAbsolutePath(viewPath) {
+                let viewsDirPath = basePath . viewsDir . viewPath;
+            } else {
+                let viewsDirPath = viewPath;
+            }
+
+            let paths = [];
+
+            for extension, _ in engines {
+                if file_exists(viewsDirPath . extension) {
+                    let paths[extension] = viewsDirPath . extension;
+                }
+            }
+
+            if count(paths) {
+                let viewsDirsPaths[] = paths;
+            }
+        }
+
+        if cache {
+            this->pathCache->set(viewPath, viewsDirsPaths);
+        }
+
+        return viewsDirsPaths;
+    }
+
+    /**
+     * Saves the files resolved for the views once the outermost render is
+     * done
+     */
+    protected function saveResolvedPaths() -> void
+    {
+        if this->rendering || this->pathCache === null {
+            return;
+        }
+
+        this->pathCache->save();
+    }
+
+    /**
+     * Renders the outermost pending stage of a streamed view straight to the
+     * output. Returns false if there are no pending stages
+     */
+    protected function renderStreamStage() -> bool
+    {
+        var stages, stage, currentRenderLevel;
+
+        let stages = this->streamStages,
+            stage  = array_pop(stages);
+
+        if stage === null {
+            return false;
+        }
+
+        let this->streamStages       = stages,
+            currentRenderLevel       = this->currentRenderLevel,
+            this->currentRenderLevel = stage[0];
+
+        this->engineRender(
+            this->loadTemplateEngines(),
+            stage[1],
+            stage[2],
+            false
+        );
+
+        let this->currentRenderLevel = currentRenderLevel;
+
+        return true;
+    }
 }
@@ -33,6 +33,20 @@ abstract class Engine extends Injectable implements EngineInterface
         let this->container = container;
     }
 
+    /**
+     * Sends the output rendered so far to the client if the view is streamed
+     */
+    public function flush() -> void
+    {
+        var view;
+
+        let view = this->view;
+
+        if method_exists(view, "flush") {
+            view->flush();
+        }
+    }
+
     /**
      * Returns cached output on another view stage
      */
@@ -19,11 +19,52 @@ use Phalcon\Mvc\View\Exception;
  * Phalcon\Mvc\View\Engine\Volt
  *
  * Designer friendly and fast template engine for PHP written in Zephir/C
+ *
+ * Templates can be compiled ahead of time with precompile(). When the
+ * 'manifest' option is set, the compiled path of every precompiled template
+ * is read from the manifest and render() skips the compiler (and its file
+ * checks) entirely:
+ *
+ *<code>
+ * $volt->setOptions(
+ *     [
+ *         "path"     => "app/cache/volt/",
+ *         "manifest" => "app/cache/volt/manifest.php",
+ *     ]
+ * );
+ *
+ * // At deploy time
+ * $volt->precompile();
+ *</code>
  */
 class Volt extends Engine
 {
+    /**
+     * Fragments being cached by {% cache %} blocks
+     *
+     * @var array
+     */
+    protected cacheFragments = [];
+
     protected compiler;
+
+    /**
+     * Closures of the macros compiled with the "optimize" option, receiving
+     * their parameters positionally
+     *
+     * @var array
+     */
+    protected macroFunctions = [];
+
     protected macros;
+
+    /**
+     * Precompiled templates, loaded from the manifest
+     *
+     * @var array|null
+     */
+    protected manifest = null;
+
     protected options;
 
     /**
@@ -125,6 +166,24 @@ class Volt extends Engine
         return this->options;
     }
 
+    /**
+     * Invalidates every cached fragment tagged with any of the tags
+     *
+     *<code>
+     * $volt->invalidateCacheTags(["menu"]);
+     *</code>
+     */
+    public function invalidateCacheTags(array! tags) -> void
+    {
+        var cache, tag;
+
+        let cache = this->getCacheService();
+
+        for tag in tags {
+            cache->set("volt-tag-" . tag, uniqid("", true));
+        }
+    }
+
     /**
      * Checks if the needle is included in the haystack
      */
@@ -161,38 +220,137 @@ class Volt extends Engine
         return strlen(item);
     }
 
+    /**
+     * Compiles the templates of the views directories (or of the given
+     * directories) ahead of time and returns the resulting manifest. Only the
+     * templates changed since the previous precompilation, or depending on a
+     * changed template, are compiled again. The manifest is written to the
+     * 'manifest' option path when set.
+     *
+     * The manifest is keyed by the paths render() receives: the views
+     * directories are prefixed with the base path of the view, and the
+     * directories given must be passed the same way.
+     *
+     * Templates served from the manifest are not compiled, so the
+     * "view:beforeCompile" and "view:afterCompile" events are not fired for
+     * them
+     *
+     * @param string|array directories
+     */
+    public function precompile(var directories = null, string! extension = ".volt") -> array
+    {
+        var basePath, compiler, directory, manifest, manifestPath, tempPath,
+            viewsDirs;
+
+        if directories === null {
+            let viewsDirs   = this->view->getViewsDir(),
+                directories = [];
+
+            if typeof viewsDirs != "array" {
+                let viewsDirs = [viewsDirs];
+            }
+
+            let basePath = "";
+
+            if method_exists(this->view, "getBasePath") {
+                let basePath = (string) this->view->getBasePath();
+            }
+
+            for directory in viewsDirs {
+                let directories[] = basePath . directory;
+            }
+        }
+
+        if typeof directories != "array" {
+            let directories = [directories];
+        }
+
+        let compiler = this->getCompiler(),
+            manifest = this->loadManifest();
+
+        for directory in directories {
+            let manifest = compiler->compileTree(directory, extension, manifest);
+        }
+
+        let this->manifest = manifest;
+
+        if !fetch manifestPath, this->options["manifest"] {
+            return manifest;
+        }
+
+        /**
+         * The manifest is replaced atomically, requests being served never
+         * read a partially written file
+         */
+        let tempPath = manifestPath . "." . uniqid("", true) . ".tmp";
+
+        if unlikely file_put_contents(tempPath, "<?php return " . var_export(manifest, true) . ";") === false {
+            throw new Exception("Volt manifest can't be written");
+        }
+
+        if unlikely !rename(tempPath, manifestPath) {
+            unlink(tempPath);
+
+            throw new Exception("Volt manifest can't be written");
+        }
+
+        if function_exists("opcache_invalidate") {
+            opcache_invalidate(manifestPath, true);
+        }
+
+        return manifest;
+    }
+
     /**
      * Renders a view using the template engine
      */
     public function render(string! templatePath, var params, bool mustClean = false)
     {
-        var compiler, compiledTemplatePath, eventsManager, key, value;
+        var compiler, compiledTemplatePath, entry, eventsManager, key, manifest,
+            value;
 
         if mustClean {
             ob_clean();
         }
 
+        let compiledTemplatePath = null;
+
         /**
-         * The compilation process is done by Phalcon\Mvc\View\Engine\Volt\Compiler
+         * Precompiled templates are served straight from the manifest, without
+         * the compile events
          */
-        let compiler      = this->getCompiler(),
-            eventsManager = this->eventsManager;
+        if isset this->options["manifest"] {
+            let manifest = this->loadManifest();
 
-        if typeof eventsManager == "object" {
-            if eventsManager->fire("view:beforeCompile", this) === false {
-                return null;
+            if fetch entry, manifest[templatePath] {
+                let compiledTemplatePath = entry["compiled"];
             }
         }
 
-        compiler->compile(templatePath);
+        if compiledTemplatePath === null {
+            /**
+             * The compilation process is done by
+             * Phalcon\Mvc\View\Engine\Volt\Compiler
+             */
+            let compiler      = this->getCompiler(),
+                eventsManager = this->eventsManager;
 
-        if typeof eventsManager == "object" {
-            if eventsManager->fire("view:afterCompile", this) === false {
-                return null;
+            if typeof eventsManager == "object" {
+                if eventsManager->fire("view:beforeCompile", this) === false {
+                    return null;
+                }
             }
-        }
 
-        let compiledTemplatePath = compiler->getCompiledTemplatePath();
+            compiler->compile(templatePath);
+
+            if typeof eventsManager == "object" {
+                if eventsManager->fire("view:afterCompile", this) === false {
+                    return null;
+                }
+            }
+
+            let compiledTemplatePath = compiler->getCompiledTemplatePath();
+        }
 
         /**
          * Export the variables the current symbol table
@@ -210,12 +368,119 @@ class Volt extends Engine
         }
     }
 
+    /**
+     * Renders a template source, such as a template stored in a database. With
+     * the "stringCache" option the source is compiled once into a file of that
+     * directory and loaded with `require`, otherwise it is compiled on every
+     * call
+     *
+     *<code>
+     * $volt->setOptions(
+     *     [
+     *         "stringCache" => "app/cache/volt-strings/",
+     *     ]
+     * );
+     *
+     * $volt->renderString($page->template, ["page" => $page]);
+     *</code>
+     */
+    public function renderString(string! viewCode, var params = null) -> void
+    {
+        var compiler, compiledTemplatePath, compilation, exception, key,
+            value;
+
+        let compiler    = this->getCompiler(),
+            compilation = null;
+
+        /**
+         * Export the variables the current symbol table
+         */
+        if typeof params == "array" {
+            for key, value in params {
+                let {key} = value;
+            }
+        }
+
+        if compiler->getOption("stringCache") !== null {
+            let compiledTemplatePath = compiler->compileStringFile(viewCode);
+
+            if compiledTemplatePath !== null {
+                require compiledTemplatePath;
+
+                return;
+            }
+
+            /**
+             * Sources with dependencies are not stored, their code is reused
+             */
+            let compilation = compiler->getStringCompilation();
+        }
+
+        if compilation === null {
+            let compilation = compiler->compileString(viewCode);
+        }
+
+        let compiledTemplatePath = tempnam(sys_get_temp_dir(), "volt");
+
+        file_put_contents(compiledTemplatePath, compilation);
+
+        try {
+            require compiledTemplatePath;
+        } catch \Throwable, exception {
+            unlink(compiledTemplatePath);
+
+            throw exception;
+        }
+
+        unlink(compiledTemplatePath);
+    }
+
+    /**
+     * Ends the fragment started by startCache(), stores it in the cache and
+     * outputs it
+     */
+    public function saveCache() -> void
+    {
+        var cache, content, fragment, fragments;
+
+        let fragments = this->cacheFragments,
+            fragment  = array_pop(fragments);
+
+        if unlikely typeof fragment != "array" {
+            throw new Exception("There is no fragment being cached");
+        }
+
+        let this->cacheFragments = fragments,
+            cache   = this->getCacheService(),
+            content = ob_get_clean();
+
+        /**
+         * The fragment is kept for the stale period after it expires
+         */
+        cache->set(
+            fragment["key"],
+            [
+                "content" : content,
+                "expires" : time() + fragment["lifetime"],
+                "tags"    : fragment["tags"]
+            ],
+            fragment["lifetime"] + fragment["stale"]
+        );
+
+        if fragment["stale"] > 0 {
+            cache->delete(fragment["key"] . "-lock");
+        }
+
+        echo content;
+    }
+
     /**
      * Set Volt's options
      */
     public function setOptions(array! options)
     {
-        let this->options = options;
+        let this->options = options,
+            this->manifest = null;
     }
 
     /**
@@ -299,4 +564,198 @@ class Volt extends Engine
 
         return value;
     }
+
+    /**
+     * Starts a cached fragment. If the fragment is cached it is output and
+     * FALSE is returned, otherwise the output is buffered until saveCache()
+     * is called and TRUE is returned.
+     *
+     * Options can be the lifetime in seconds or an array with:
+     *
+     * - lifetime: seconds the fragment is fresh
+     * - stale: seconds an expired fragment can still be served while a
+     *   single request regenerates it
+     * - tags: tags to invalidate the fragment with invalidateCacheTags()
+     *
+     * Defaults are taken from the 'cache' option, which also sets the cache
+     * service ('viewCache' by default)
+     *
+     * @param int|array options
+     */
+    public function startCache(string! key, var options = null) -> bool
+    {
+        var cache, fragment, lifetime, stale, tags, versions;
+
+        if typeof options != "array" {
+            if options !== null {
+                let options = ["lifetime" : options];
+            } else {
+                let options = [];
+            }
+        }
+
+        if !fetch lifetime, options["lifetime"] {
+            let lifetime = this->getCacheOption("lifetime", 3600);
+        }
+
+        if !fetch stale, options["stale"] {
+            let stale = this->getCacheOption("stale", 0);
+        }
+
+        if !fetch tags, options["tags"] {
+            let tags = [];
+        }
+
+        let cache    = this->getCacheService(),
+            versions = this->getCacheTagVersions(cache, tags),
+            fragment = cache->get(key);
+
+        if typeof fragment == "array" && fragment["tags"] == versions {
+            if fragment["expires"] > time() {
+                echo fragment["content"];
+
+                return false;
+            }
+
+            /**
+             * The fragment expired but can still be served. Only the request
+             * taking the lock regenerates it
+             */
+            if stale > 0 {
+                if !this->acquireCacheLock(cache, key . "-lock") {
+                    echo fragment["content"];
+
+                    return false;
+                }
+            }
+        }
+
+        let this->cacheFragments[] = [
+            "key"      : key,
+            "lifetime" : (int) lifetime,
+            "stale"    : (int) stale,
+            "tags"     : versions
+        ];
+
+        ob_start();
+
+        return true;
+    }
+
+    /**
+     * Takes the lock regenerating an expired fragment. The Phalcon caches and
+     * storage adapters create it atomically with add(); other PSR-16 caches
+     * only provide has() and set(), so a few requests may regenerate the same
+     * fragment at once
+     */
+    protected function acquireCacheLock(var cache, string! lockKey) -> bool
+    {
+        var lifetime;
+
+        let lifetime = (int) this->getCacheOption("lockLifetime", 30);
+
+        if typeof cache == "object" && cache instanceof \Phalcon\Cache\Cache {
+            let cache = cache->getAdapter();
+        }
+
+        if method_exists(cache, "add") {
+            return (bool) cache->add(lockKey, 1, lifetime);
+        }
+
+        if cache->has(lockKey) {
+            return false;
+        }
+
+        return (bool) cache->set(lockKey, 1, lifetime);
+    }
+
+    /**
+     * Returns an option of the fragment cache
+     */
+    protected function getCacheOption(string! name, var defaultValue)
+    {
+        var cacheOptions, value;
+
+        if fetch cacheOptions, this->options["cache"] {
+            if fetch value, cacheOptions[name] {
+                return value;
+            }
+        }
+
+        return defaultValue;
+    }
+
+    /**
+     * Returns the cache used by the {% cache %} blocks. Any PSR-16 cache or
+     * Phalcon\Storage adapter can be used
+     */
+    protected function getCacheService()
+    {
+        var container;
+
+        let container = <DiInterface> this->container;
+
+        if unlikely typeof container != "object" {
+            throw new Exception(
+                "A dependency injection container is required to access the 'viewCache' service"
+            );
+        }
+
+        return container->getShared(
+            this->getCacheOption("service", "viewCache")
+        );
+    }
+
+    /**
+     * Returns the current version of each tag, creating the missing ones
+     */
+    protected function getCacheTagVersions(var cache, array! tags) -> array
+    {
+        var tag, version;
+        array versions;
+
+        let versions = [];
+
+        for tag in tags {
+            let version = cache->get("volt-tag-" . tag);
+
+            if version === null {
+                let version = uniqid("", true);
+
+                cache->set("volt-tag-" . tag, version);
+            }
+
+            let versions[tag] = version;
+        }
+
+        return versions;
+    }
+
+    /**
+     * Loads the manifest of precompiled templates once per instance
+     */
+    protected function loadManifest() -> array
+    {
+        var manifest, manifestPath;
+
+        if typeof this->manifest == "array" {
+            return this->manifest;
+        }
+
+        let manifest = null;
+
+        if fetch manifestPath, this->options["manifest"] {
+            if file_exists(manifestPath) {
+                let manifest = require manifestPath;
+            }
+        }
+
+        if typeof manifest != "array" {
+            let manifest = [];
+        }
+
+        let this->manifest = manifest;
+
+        return manifest;
+    }
 }
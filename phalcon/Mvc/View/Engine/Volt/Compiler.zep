@@ -37,11 +37,21 @@ class Compiler implements InjectionAwareInterface
     protected compiledTemplatePath;
     protected currentBlock;
     protected currentPath;
+    protected dependencies = [];
     protected exprLevel = 0;
     protected extended = false;
     protected extensions;
     protected extendedBlocks;
     protected filters;
+
+    /**
+     * Value of the last expression resolved, in an array, when it's made
+     * only of literals and the 'optimize' option is enabled
+     *
+     * @var array|null
+     */
+    protected foldedValue = null;
+
     protected foreachLevel = 0;
     protected forElsePointers;
     protected functions;
@@ -50,6 +60,13 @@ class Compiler implements InjectionAwareInterface
     protected macros;
     protected options;
     protected prefix;
+
+    /**
+     * Code compiled by compileStringFile() that could not be stored
+     *
+     * @var string|null
+     */
+    protected stringCompilation = null;
     protected view;
 
     /**
@@ -184,6 +201,7 @@ class Compiler implements InjectionAwareInterface
         let this->foreachLevel = 0;
         let this->blockLevel = 0;
         let this->exprLevel = 0;
+        let this->dependencies = [];
 
         let compilation = null;
 
@@ -336,10 +354,11 @@ class Compiler implements InjectionAwareInterface
              * The file needs to be compiled because it either doesn't exist or
              * needs to compiled every time
              */
-            let compilation = this->compileFile(
+            let compilation = this->compileLocked(
                 templatePath,
                 compiledTemplatePath,
-                extendsMode
+                extendsMode,
+                compileAlways
             );
         } else {
             if stat === true {
@@ -348,10 +367,11 @@ class Compiler implements InjectionAwareInterface
                  * needs to be recompiled
                  */
                 if compare_mtime(templatePath, compiledTemplatePath) {
-                    let compilation = this->compileFile(
+                    let compilation = this->compileLocked(
                         templatePath,
                         compiledTemplatePath,
-                        extendsMode
+                        extendsMode,
+                        compileAlways
                     );
                 } else {
                     if extendsMode {
@@ -416,7 +436,22 @@ class Compiler implements InjectionAwareInterface
     }
 
     /**
-     * Compiles a "cache" statement returning PHP code
+     * Compiles a "cache" statement returning PHP code. The fragment is cached
+     * through Phalcon\Mvc\View\Engine\Volt::startCache() and saveCache(),
+     * the lifetime can be a number or a variable holding either a number or
+     * an array of options (lifetime, stale and tags)
+     *
+     *<code>
+     * {% cache "sidebar" 3600 %}
+     *     ...
+     * {% endcache %}
+     *
+     * {% set options = ["lifetime": 3600, "stale": 60, "tags": ["menu"]] %}
+     *
+     * {% cache "sidebar" options %}
+     *     ...
+     * {% endcache %}
+     *</code>
      */
     public function compileCache(array! statement, bool extendsMode = false) -> string
     {
@@ -435,22 +470,16 @@ class Compiler implements InjectionAwareInterface
          */
         let exprCode = this->expression(expr);
 
-        let compilation = "<?php $_cache[" . this->expression(expr) . "] = $this->di->get('viewCache'); ";
-
         if fetch lifetime, statement["lifetime"] {
-            let compilation .= "$_cacheKey[" . exprCode . "]";
-
             if lifetime["type"] == PHVOLT_T_IDENTIFIER {
-                let compilation .= " = $_cache[" . exprCode . "]->start(" . exprCode . ", $" . lifetime["value"] . "); ";
+                let compilation = "<?php if ($this->startCache(" . exprCode . ", $" . lifetime["value"] . ")) { ?>";
             } else {
-                let compilation .= " = $_cache[" . exprCode . "]->start(" . exprCode . ", " . lifetime["value"] . "); ";
+                let compilation = "<?php if ($this->startCache(" . exprCode . ", " . lifetime["value"] . ")) { ?>";
             }
         } else {
-            let compilation .= "$_cacheKey[" . exprCode . "] = $_cache[" . exprCode."]->start(" . exprCode . "); ";
+            let compilation = "<?php if ($this->startCache(" . exprCode . ")) { ?>";
         }
 
-        let compilation .= "if ($_cacheKey[" . exprCode . "] === null) { ?>";
-
         /**
          * Get the code in the block
          */
@@ -459,20 +488,7 @@ class Compiler implements InjectionAwareInterface
             extendsMode
         );
 
-        /**
-         * Check if the cache has a lifetime
-         */
-        if fetch lifetime, statement["lifetime"] {
-            if lifetime["type"] == PHVOLT_T_IDENTIFIER {
-                let compilation .= "<?php $_cache[" . exprCode . "]->save(" . exprCode . ", null, $" . lifetime["value"] . "); ";
-            } else {
-                let compilation .= "<?php $_cache[" . exprCode . "]->save(" . exprCode . ", null, " . lifetime["value"] . "); ";
-            }
-
-            let compilation .= "} else { echo $_cacheKey[" . exprCode . "]; } ?>";
-        } else {
-            let compilation .= "<?php $_cache[" . exprCode . "]->save(" . exprCode . "); } else { echo $_cacheKey[" . exprCode . "]; } ?>";
-        }
+        let compilation .= "<?php $this->saveCache(); } ?>";
 
         return compilation;
     }
@@ -562,6 +578,14 @@ class Compiler implements InjectionAwareInterface
                 if name["value"] == "super" {
                     return exprCode;
                 }
+
+                /**
+                 * flush() sends the output of a streamed view and doesn't
+                 * produce any output itself
+                 */
+                if name["value"] == "flush" {
+                    return "<?php " . exprCode . "; ?>";
+                }
             }
         }
 
@@ -569,7 +593,7 @@ class Compiler implements InjectionAwareInterface
          * Echo statement
          */
         if this->autoescape {
-            return "<?= $this->escaper->escapeHtml(" . exprCode . ") ?>";
+            return "<?= " . this->getEscapeCode(exprCode) . " ?>";
         }
 
         return "<?= " . exprCode . " ?>";
@@ -609,7 +633,7 @@ class Compiler implements InjectionAwareInterface
      */
     public function compileFile(string! path, string! compiledPath, bool extendsMode = false)
     {
-        var viewCode, compilation, finalCompilation;
+        var viewCode, compilation, finalCompilation, tempPath;
 
         if unlikely path == compiledPath {
             throw new Exception(
@@ -651,12 +675,26 @@ class Compiler implements InjectionAwareInterface
 
         /**
          * Always use file_put_contents to write files instead of write the file
-         * directly, this respect the open_basedir directive
+         * directly, this respect the open_basedir directive. The compilation
+         * is written to a temporary file and renamed, so concurrent requests
+         * never include a partially written file
          */
-        if unlikely file_put_contents(compiledPath, finalCompilation) === false {
+        let tempPath = compiledPath . "." . uniqid("", true) . ".tmp";
+
+        if unlikely file_put_contents(tempPath, finalCompilation) === false {
+            throw new Exception("Volt directory can't be written");
+        }
+
+        if unlikely !rename(tempPath, compiledPath) {
+            unlink(tempPath);
+
             throw new Exception("Volt directory can't be written");
         }
 
+        if function_exists("opcache_invalidate") {
+            opcache_invalidate(compiledPath, true);
+        }
+
         return compilation;
     }
 
@@ -921,8 +959,42 @@ class Compiler implements InjectionAwareInterface
                     );
                 }
 
+                let this->dependencies = array_merge(
+                    this->dependencies,
+                    [finalPath],
+                    subCompiler->getDependencies()
+                );
+
                 return compilation;
             }
+
+            /**
+             * With the 'optimize' option, includes with parameters are inlined
+             * too. The included code runs in a closure receiving the view
+             * parameters and the include parameters, like a partial does
+             */
+            if this->getOption("optimize") === true {
+                let finalPath = this->resolveIncludePath(pathExpr["value"]);
+
+                if finalPath !== false {
+                    let subCompiler = clone this;
+                    let compilation = subCompiler->compile(finalPath, false);
+
+                    if compilation === null {
+                        let compilation = file_get_contents(
+                            subCompiler->getCompiledTemplatePath()
+                        );
+                    }
+
+                    let this->dependencies = array_merge(
+                        this->dependencies,
+                        [finalPath],
+                        subCompiler->getDependencies()
+                    );
+
+                    return "<?php (function ($_includeParams) { extract($_includeParams); ?>" . compilation . "<?php })(array_merge($this->getView()->getParamsToView(), " . this->expression(statement["params"]) . ")); ?>";
+                }
+            }
         }
 
         /**
@@ -946,8 +1018,8 @@ class Compiler implements InjectionAwareInterface
     public function compileMacro(array! statement, bool extendsMode) -> string
     {
         var name, defaultValue, parameters, position, parameter, variableName,
-            blockStatements;
-        string code, macroName;
+            blockStatements, variables;
+        string code, macroName, binding, body;
 
         /**
          * A valid name is required
@@ -963,43 +1035,41 @@ class Compiler implements InjectionAwareInterface
             throw new Exception("Macro '" . name . "' is already defined");
         }
 
+        if !fetch parameters, statement["parameters"] {
+            let parameters = [];
+        }
+
         /**
-         * Register the macro
+         * Register the macro with its parameters, so calls can be resolved
+         * at compile time
          */
-        let this->macros[name] = name;
+        let this->macros[name] = parameters;
 
-        let macroName = "$this->macros['" . name . "']";
+        let macroName = "$this->macros['" . name . "']",
+            binding   = "",
+            variables = [];
 
-        let code = "<?php ";
-
-        if !fetch parameters, statement["parameters"] {
-            let code .= macroName . " = function() { ?>";
-        } else {
-            /**
-             * Parameters are always received as an array
-             */
-            let code .= macroName . " = function($__p = null) { ";
-
-            for position, parameter in parameters {
-                let variableName = parameter["variable"];
+        /**
+         * Parameters are always received as an array
+         */
+        for position, parameter in parameters {
+            let variableName = parameter["variable"],
+                variables[]  = "$" . variableName;
 
-                let code .= "if (isset($__p[" . position . "])) { ";
-                let code .= "$" . variableName . " = $__p[" . position ."];";
-                let code .= " } else { ";
-                let code .= "if (array_key_exists(\"" . variableName . "\", $__p)) { ";
-                let code .= "$" . variableName . " = $__p[\"" . variableName ."\"];";
-                let code .= " } else { ";
+            let binding .= "if (isset($__p[" . position . "])) { ";
+            let binding .= "$" . variableName . " = $__p[" . position ."];";
+            let binding .= " } else { ";
+            let binding .= "if (array_key_exists(\"" . variableName . "\", $__p)) { ";
+            let binding .= "$" . variableName . " = $__p[\"" . variableName ."\"];";
+            let binding .= " } else { ";
 
-                if likely fetch defaultValue, parameter["default"] {
-                    let code .= "$" . variableName . " = " . this->expression(defaultValue) . ";";
-                } else {
-                    let code .= " throw new \\Phalcon\\Mvc\\View\\Exception(\"Macro '" . name . "' was called without parameter: " . variableName . "\"); ";
-                }
-
-                let code .= " } } ";
+            if likely fetch defaultValue, parameter["default"] {
+                let binding .= "$" . variableName . " = " . this->expression(defaultValue) . ";";
+            } else {
+                let binding .= " throw new \\Phalcon\\Mvc\\View\\Exception(\"Macro '" . name . "' was called without parameter: " . variableName . "\"); ";
             }
 
-            let code .= " ?>";
+            let binding .= " } } ";
         }
 
         /**
@@ -1009,11 +1079,36 @@ class Compiler implements InjectionAwareInterface
             /**
              * Process statements block
              */
-            let code .= this->statementList(blockStatements, extendsMode) . "<?php }; ";
+            let body = this->statementList(blockStatements, extendsMode) . "<?php }; ";
         }  else {
-            let code .= "<?php }; ";
+            let body = "<?php }; ";
+        }
+
+        /**
+         * With the "optimize" option the macro body is a closure receiving
+         * the parameters positionally, called directly from the calls
+         * resolved at compile time. The closure receiving an array remains
+         * for Phalcon\Mvc\View\Engine\Volt::callMacro()
+         */
+        if this->getOption("optimize") === true {
+            let code = "<?php $this->macroFunctions['" . name . "'] = function(" . join(", ", variables) . ") { ?>" . body;
+            let code .= "$this->macroFunctions['" . name . "'] = \\Closure::bind($this->macroFunctions['" . name . "'], $this); ";
+            let code .= macroName . " = function($__p = null) { " . binding . "return $this->macroFunctions['" . name . "'](" . join(", ", variables) . "); }; ";
+            let code .= macroName . " = \\Closure::bind(" . macroName . ", $this); ?>";
+
+            return code;
         }
 
+        let code = "<?php ";
+
+        if !count(parameters) {
+            let code .= macroName . " = function() { ?>";
+        } else {
+            let code .= macroName . " = function($__p = null) { " . binding . " ?>";
+        }
+
+        let code .= body;
+
         /**
          * Bind the closure to the $this object allowing to call services
          */
@@ -1109,7 +1204,9 @@ class Compiler implements InjectionAwareInterface
     }
 
     /**
-     * Compiles a template into a string
+     * Compiles a template into a string. When the "stringCache" option is set
+     * to a directory the compiled code is stored in a file named after the
+     * hash of the source, so the same source is only parsed once
      *
      *<code>
      * echo $compiler->compileString('{{ "hello world" }}');
@@ -1117,9 +1214,188 @@ class Compiler implements InjectionAwareInterface
      */
     public function compileString(string! viewCode, bool extendsMode = false) -> string
     {
-        let this->currentPath = "eval code";
+        var compiledPath, compilation, tempPath;
+
+        let compiledPath = null;
+
+        if !extendsMode && this->getOption("stringCache") !== null {
+            let compiledPath = this->getStringCachePath(viewCode);
+
+            if file_exists(compiledPath) {
+                return file_get_contents(compiledPath);
+            }
+        }
+
+        let this->currentPath  = "eval code",
+            this->dependencies = [];
+
+        let compilation = this->compileSource(viewCode, extendsMode);
+
+        /**
+         * Templates extending or including other templates depend on those
+         * files, so they aren't stored
+         */
+        if compiledPath !== null && !count(this->dependencies) {
+            let tempPath = compiledPath . "." . uniqid("", true) . ".tmp";
+
+            if unlikely file_put_contents(tempPath, compilation) === false {
+                throw new Exception("Volt directory can't be written");
+            }
+
+            if unlikely !rename(tempPath, compiledPath) {
+                unlink(tempPath);
+
+                throw new Exception("Volt directory can't be written");
+            }
+        }
+
+        return compilation;
+    }
+
+    /**
+     * Compiles a template source into the "stringCache" directory and returns
+     * the path of the compiled file, meant to be loaded with `require` so
+     * opcache keeps the compiled code. Sources compiled before are neither
+     * parsed nor compiled again. Returns null for templates extending or
+     * including other templates, which are not stored: their compiled code
+     * is returned by getStringCompilation()
+     *
+     *<code>
+     * $compiler->setOption("stringCache", "app/cache/volt-strings/");
+     *
+     * require $compiler->compileStringFile($page->template);
+     *</code>
+     */
+    public function compileStringFile(string! viewCode)
+    {
+        var compiledPath, compilation;
+
+        let compiledPath            = this->getStringCachePath(viewCode),
+            this->stringCompilation = null;
+
+        if !file_exists(compiledPath) {
+            let compilation = this->compileString(viewCode);
+
+            if count(this->dependencies) {
+                let this->stringCompilation = compilation;
 
-        return this->compileSource(viewCode, extendsMode);
+                return null;
+            }
+        }
+
+        let this->compiledTemplatePath = compiledPath;
+
+        return compiledPath;
+    }
+
+    /**
+     * Compiles every template under a directory and returns a manifest
+     * describing them. Passing the previous manifest only recompiles the
+     * templates whose source or any extended/included template changed since
+     * then, so a changed layout recompiles all the views depending on it.
+     *
+     * Manifest entries are indexed by template path, built the same way
+     * Phalcon\Mvc\View builds them (views dir + relative path), and hold the
+     * compiled path, the source mtime and the mtime of every dependency
+     *
+     *<code>
+     * $manifest = $compiler->compileTree("app/views/");
+     *
+     * // After a deploy
+     * $manifest = $compiler->compileTree("app/views/", ".volt", $manifest);
+     *</code>
+     */
+    public function compileTree(string! directory, string! extension = ".volt", array manifest = []) -> array
+    {
+        var files, file, baseDir, templatePath, templates, entry, dependency,
+            mtime, dependencyMtime, options, dependencies, exception;
+        bool stale;
+
+        let baseDir = rtrim(directory, "\\/"),
+            templates = [];
+
+        let files = new \RecursiveIteratorIterator(
+            new \RecursiveDirectoryIterator(
+                baseDir,
+                \FilesystemIterator::SKIP_DOTS
+            )
+        );
+
+        for file in files {
+            if !file->isFile() || substr(file->getFilename(), -strlen(extension)) !== extension {
+                continue;
+            }
+
+            let templatePath = baseDir . DIRECTORY_SEPARATOR . ltrim(
+                substr(file->getPathname(), strlen(baseDir)),
+                "\\/"
+            );
+
+            let templates[templatePath] = file->getMTime();
+        }
+
+        /**
+         * Entries of templates removed from the directory are dropped
+         */
+        for templatePath, entry in manifest {
+            if strpos(templatePath, baseDir . DIRECTORY_SEPARATOR) === 0 && !isset templates[templatePath] {
+                unset manifest[templatePath];
+            }
+        }
+
+        /**
+         * Templates are always compiled here, so the dependencies of the
+         * included and extended templates are collected too
+         */
+        let options = this->options;
+
+        this->setOption("always", true);
+
+        try {
+            for templatePath, mtime in templates {
+                let stale = true;
+
+                if fetch entry, manifest[templatePath] {
+                    if entry["mtime"] == mtime && file_exists(entry["compiled"]) {
+                        let stale = false;
+
+                        for dependency, dependencyMtime in entry["dependencies"] {
+                            if !file_exists(dependency) || filemtime(dependency) != dependencyMtime {
+                                let stale = true;
+
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                if !stale {
+                    continue;
+                }
+
+                this->compile(templatePath);
+
+                let dependencies = [];
+
+                for dependency in this->dependencies {
+                    let dependencies[dependency] = filemtime(dependency);
+                }
+
+                let manifest[templatePath] = [
+                    "compiled"     : this->compiledTemplatePath,
+                    "mtime"        : templates[templatePath],
+                    "dependencies" : dependencies
+                ];
+            }
+        } catch \Throwable, exception {
+            let this->options = options;
+
+            throw exception;
+        }
+
+        let this->options = options;
+
+        return manifest;
     }
 
     /**
@@ -1186,9 +1462,15 @@ class Compiler implements InjectionAwareInterface
     final public function expression(array! expr) -> string
     {
         var exprCode, extensions, items, singleExpr, singleExprCode, name, left,
-            leftCode, right, rightCode, type, startCode, endCode, start, end;
+            leftCode, right, rightCode, type, startCode, endCode, start, end,
+            folded, leftFolded, rightFolded, singleFolded, values;
+        bool optimize;
 
-        let exprCode = null, this->exprLevel++;
+        let exprCode    = null,
+            folded      = null,
+            leftFolded  = null,
+            rightFolded = null,
+            this->exprLevel++;
 
         /**
          * Check if any of the registered extensions provide compilation for
@@ -1196,6 +1478,13 @@ class Compiler implements InjectionAwareInterface
          */
         let extensions = this->extensions;
 
+        /**
+         * With the 'optimize' option, operations made only of literals are
+         * evaluated at compile time, bottom-up, from the values folded for
+         * their operands
+         */
+        let optimize = typeof extensions != "array" && this->getOption("optimize") === true;
+
         loop {
             if typeof extensions == "array" {
                 /**
@@ -1212,20 +1501,39 @@ class Compiler implements InjectionAwareInterface
             }
 
             if !fetch type, expr["type"] {
-                let items = [];
+                let items  = [],
+                    values = [];
 
                 for singleExpr in expr {
                     let singleExprCode = this->expression(
                         singleExpr["expr"]
                     );
 
+                    let singleFolded = this->foldedValue;
+
+                    if typeof singleFolded != "array" {
+                        let values = null;
+                    }
+
                     if fetch name, singleExpr["name"] {
                         let items[] = "'" . name . "' => " . singleExprCode;
+
+                        if typeof values == "array" {
+                            let values[name] = singleFolded[0];
+                        }
                     } else {
                         let items[] = singleExprCode;
+
+                        if typeof values == "array" {
+                            let values[] = singleFolded[0];
+                        }
                     }
                 }
 
+                if typeof values == "array" {
+                    let folded = [values];
+                }
+
                 let exprCode = join(", ", items);
 
                 break;
@@ -1244,7 +1552,8 @@ class Compiler implements InjectionAwareInterface
              * Left part of expression is always resolved
              */
             if fetch left, expr["left"] {
-                let leftCode = this->expression(left);
+                let leftCode   = this->expression(left),
+                    leftFolded = this->foldedValue;
             }
 
             /**
@@ -1263,10 +1572,18 @@ class Compiler implements InjectionAwareInterface
              * We don't resolve the right expression for filters
              */
             if type == 124 {
-                let exprCode = this->resolveFilter(
-                    expr["right"],
-                    leftCode
-                );
+                if optimize {
+                    let folded = this->foldConstant(expr, leftFolded, null);
+                }
+
+                if typeof folded == "array" {
+                    let exprCode = var_export(folded[0], true);
+                } else {
+                    let exprCode = this->resolveFilter(
+                        expr["right"],
+                        leftCode
+                    );
+                }
 
                 break;
             }
@@ -1275,7 +1592,18 @@ class Compiler implements InjectionAwareInterface
              * From here, right part of expression is always resolved
              */
             if fetch right, expr["right"] {
-                let rightCode = this->expression(right);
+                let rightCode   = this->expression(right),
+                    rightFolded = this->foldedValue;
+            }
+
+            if optimize {
+                let folded = this->foldConstant(expr, leftFolded, rightFolded);
+
+                if typeof folded == "array" && in_array(type, [37, 126, 278, PHVOLT_T_ADD, PHVOLT_T_SUB, PHVOLT_T_MUL, PHVOLT_T_DIV, PHVOLT_T_RANGE, PHVOLT_T_MINUS, PHVOLT_T_PLUS, PHVOLT_T_NOT]) {
+                    let exprCode = var_export(folded[0], true);
+
+                    break;
+                }
             }
 
             let exprCode = null;
@@ -1522,7 +1850,8 @@ class Compiler implements InjectionAwareInterface
             break;
         }
 
-        let this->exprLevel--;
+        let this->foldedValue = folded,
+            this->exprLevel--;
 
         return exprCode;
     }
@@ -1654,6 +1983,13 @@ class Compiler implements InjectionAwareInterface
                 return "$this->getContent()";
             }
 
+            /**
+             * This function sends the output rendered so far to the client
+             */
+            if name == "flush" {
+                return "$this->flush()";
+            }
+
             /**
              * This function includes views of volt or others template engines
              * dynamically
@@ -1832,6 +2168,18 @@ class Compiler implements InjectionAwareInterface
                 return "constant(" . arguments . ")";
             }
 
+            /**
+             * Macros defined in the compiled source are called directly with
+             * the "optimize" option
+             */
+            if this->getOption("optimize") === true && isset this->macros[name] {
+                let code = this->compileMacroCall(name, funcArguments);
+
+                if code !== null {
+                    return code;
+                }
+            }
+
             /**
              * By default it tries to call a macro
              */
@@ -1849,6 +2197,16 @@ class Compiler implements InjectionAwareInterface
         return this->compiledTemplatePath;
     }
 
+    /**
+     * Returns the templates extended or included by the last compiled
+     * template, including the ones they depend on. Only complete when the
+     * template has been compiled (not served from an up to date compiled file)
+     */
+    public function getDependencies() -> array
+    {
+        return this->dependencies;
+    }
+
     /**
      * Returns the internal dependency injector
      */
@@ -1905,6 +2263,15 @@ class Compiler implements InjectionAwareInterface
         return this->options;
     }
 
+    /**
+     * Returns the code compiled by the last compileStringFile() call when it
+     * could not be stored
+     */
+    public function getStringCompilation() -> string | null
+    {
+        return this->stringCompilation;
+    }
+
     /**
      * Returns the path that is currently being compiled
      */
@@ -2096,6 +2463,94 @@ class Compiler implements InjectionAwareInterface
     }
 
 
+    /**
+     * Compiles a template holding an advisory lock on the compiled path, so a
+     * template is compiled by a single process at a time. While a template is
+     * being compiled, other processes use the previous compiled version when
+     * there is one, otherwise they wait for the compilation to finish.
+     * Returns NULL when the template was compiled by another process.
+     *
+     * The lock file is removed when the lock is released. The lock can be
+     * disabled with the 'lock' option
+     *
+     * @return string|array|null
+     */
+    protected function compileLocked(string! path, string! compiledPath, bool extendsMode = false, bool compileAlways = false)
+    {
+        var lock, lockPath, handle, compilation, exception, stat;
+
+        if fetch lock, this->options["lock"] {
+            if lock === false {
+                return this->compileFile(path, compiledPath, extendsMode);
+            }
+        }
+
+        let lockPath = compiledPath . ".lock";
+
+        loop {
+            let handle = fopen(lockPath, "c");
+
+            /**
+             * Compile without the lock rather than failing
+             */
+            if unlikely handle === false {
+                return this->compileFile(path, compiledPath, extendsMode);
+            }
+
+            if !flock(handle, LOCK_EX | LOCK_NB) {
+                if file_exists(compiledPath) {
+                    fclose(handle);
+
+                    return null;
+                }
+
+                flock(handle, LOCK_EX);
+            }
+
+            /**
+             * The lock is only held if the file locked was not removed by
+             * the previous holder in the meantime
+             */
+            clearstatcache(true, lockPath);
+
+            if is_file(lockPath) {
+                let stat = fstat(handle);
+
+                if stat["ino"] === fileinode(lockPath) {
+                    break;
+                }
+            }
+
+            fclose(handle);
+        }
+
+        /**
+         * Another process may have finished the compilation while the lock was
+         * being acquired
+         */
+        if !compileAlways {
+            clearstatcache(true, compiledPath);
+
+            if file_exists(compiledPath) && !compare_mtime(path, compiledPath) {
+                this->unlockCompilation(handle, lockPath);
+
+                return null;
+            }
+        }
+
+        try {
+            let compilation = this->compileFile(path, compiledPath, extendsMode);
+        } catch \Throwable, exception {
+            this->unlockCompilation(handle, lockPath);
+
+            throw exception;
+        }
+
+        this->unlockCompilation(handle, lockPath);
+
+        return compilation;
+    }
+
     /**
      * Compiles a Volt source code returning a PHP plain version
      */
@@ -2107,6 +2562,13 @@ class Compiler implements InjectionAwareInterface
 
         let currentPath = this->currentPath;
 
+        /**
+         * Macros are resolved at compile time only when they are defined in
+         * the compiled source, as the compiled files of included or
+         * previously compiled templates can be rendered on their own
+         */
+        let this->macros = [];
+
         /**
          * Check for compilation options
          */
@@ -2209,6 +2671,246 @@ class Compiler implements InjectionAwareInterface
         return compilation;
     }
 
+    /**
+     * Evaluates a node made only of literals at compile time from the values
+     * already folded for its operands, without walking them again. Returns
+     * an array holding the value, or NULL if the node isn't constant
+     */
+    protected function foldConstant(array! expr, var leftValue, var rightValue)
+    {
+        var type, value, filter;
+
+        if !fetch type, expr["type"] {
+            return null;
+        }
+
+        switch type {
+            case 258:
+                return [intval(expr["value"])];
+
+            case 259:
+                return [floatval(expr["value"])];
+
+            case PHVOLT_T_STRING:
+                /**
+                 * Escape sequences are left to the PHP parser
+                 */
+                if memstr(expr["value"], "\\") {
+                    return null;
+                }
+
+                return [expr["value"]];
+
+            case PHVOLT_T_NULL:
+                return [null];
+
+            case PHVOLT_T_TRUE:
+                return [true];
+
+            case PHVOLT_T_FALSE:
+                return [false];
+
+            case PHVOLT_T_ENCLOSED:
+                return leftValue;
+
+            case PHVOLT_T_ARRAY:
+                if !isset expr["left"] {
+                    return [[]];
+                }
+
+                return leftValue;
+
+            case 124:
+                let filter = expr["right"];
+
+                /**
+                 * Only filters without arguments and not overridden by the
+                 * user are evaluated
+                 */
+                if filter["type"] != PHVOLT_T_IDENTIFIER || isset this->filters[filter["value"]] {
+                    return null;
+                }
+
+                if leftValue === null {
+                    return null;
+                }
+
+                return this->foldFilter(filter["value"], leftValue[0]);
+        }
+
+        if type == PHVOLT_T_MINUS || type == PHVOLT_T_PLUS || type == PHVOLT_T_NOT {
+            if rightValue === null {
+                return null;
+            }
+
+            let value = rightValue[0];
+
+            if type == PHVOLT_T_NOT {
+                return [!value];
+            }
+
+            if typeof value != "integer" && typeof value != "double" {
+                return null;
+            }
+
+            if type == PHVOLT_T_MINUS {
+                return [-value];
+            }
+
+            return [value];
+        }
+
+        if leftValue === null || rightValue === null {
+            return null;
+        }
+
+        let leftValue  = leftValue[0],
+            rightValue = rightValue[0];
+
+        /**
+         * Concatenation
+         */
+        if type == 126 {
+            if typeof leftValue != "string" && typeof leftValue != "integer" && typeof leftValue != "double" {
+                return null;
+            }
+
+            if typeof rightValue != "string" && typeof rightValue != "integer" && typeof rightValue != "double" {
+                return null;
+            }
+
+            return [leftValue . rightValue];
+        }
+
+        if typeof leftValue != "integer" && typeof leftValue != "double" {
+            return null;
+        }
+
+        if typeof rightValue != "integer" && typeof rightValue != "double" {
+            return null;
+        }
+
+        switch type {
+            case PHVOLT_T_ADD:
+                return [leftValue + rightValue];
+
+            case PHVOLT_T_SUB:
+                return [leftValue - rightValue];
+
+            case PHVOLT_T_MUL:
+                return [leftValue * rightValue];
+
+            case PHVOLT_T_DIV:
+                if rightValue == 0 {
+                    return null;
+                }
+
+                return [leftValue / rightValue];
+
+            case 37:
+                if typeof leftValue != "integer" || typeof rightValue != "integer" || rightValue == 0 {
+                    return null;
+                }
+
+                return [leftValue % rightValue];
+
+            case 278:
+                return [pow(leftValue, rightValue)];
+
+            case PHVOLT_T_RANGE:
+                /**
+                 * Big ranges are left to the runtime to keep the compiled
+                 * code small
+                 */
+                if typeof leftValue != "integer" || typeof rightValue != "integer" || abs(rightValue - leftValue) > 255 {
+                    return null;
+                }
+
+                return [range(leftValue, rightValue)];
+        }
+
+        return null;
+    }
+
+    /**
+     * Applies a filter to a literal at compile time, as the compiled filter
+     * would do at runtime. Returns NULL for filters that can't be evaluated
+     */
+    protected function foldFilter(string! name, var value)
+    {
+        if typeof value == "array" {
+            switch name {
+                case "keys":
+                    return [array_keys(value)];
+
+                case "length":
+                    return [count(value)];
+
+                case "json_encode":
+                    return [json_encode(value)];
+            }
+
+            return null;
+        }
+
+        if typeof value != "string" {
+            if name == "abs" && (typeof value == "integer" || typeof value == "double") {
+                return [abs(value)];
+            }
+
+            return null;
+        }
+
+        switch name {
+            case "upper":
+            case "uppercase":
+                return [\Phalcon\Text::upper(value)];
+
+            case "lower":
+            case "lowercase":
+                return [\Phalcon\Text::lower(value)];
+
+            case "capitalize":
+                return [ucwords(value)];
+
+            case "trim":
+                return [trim(value)];
+
+            case "left_trim":
+                return [ltrim(value)];
+
+            case "right_trim":
+                return [rtrim(value)];
+
+            case "striptags":
+                return [strip_tags(value)];
+
+            case "url_encode":
+                return [urlencode(value)];
+
+            case "slashes":
+                return [addslashes(value)];
+
+            case "stripslashes":
+                return [stripslashes(value)];
+
+            case "nl2br":
+                return [nl2br(value)];
+
+            case "json_encode":
+                return [json_encode(value)];
+
+            case "length":
+                if function_exists("mb_strlen") {
+                    return [mb_strlen(value)];
+                }
+
+                return [strlen(value)];
+        }
+
+        return null;
+    }
+
     /**
      * Gets the final path with VIEW
      */
@@ -2238,6 +2940,198 @@ class Compiler implements InjectionAwareInterface
         return path;
     }
 
+    /**
+     * Resolves the arguments of a call to a macro defined in the compiled
+     * source, returning the code calling its closure with positional
+     * arguments. Returns null when the call can't be resolved at compile
+     * time, as when a parameter is missing or has a non literal default
+     */
+    protected function compileMacroCall(string! name, var funcArguments)
+    {
+        var parameters, position, parameter, argument, argumentName,
+            defaultValue, variableName, positional, named;
+        array arguments;
+
+        let parameters = this->macros[name],
+            positional = [],
+            named      = [],
+            arguments  = [];
+
+        if typeof funcArguments == "array" {
+            for argument in funcArguments {
+                if fetch argumentName, argument["name"] {
+                    let named[argumentName] = this->expression(argument["expr"]);
+                } else {
+                    let positional[] = this->expression(argument["expr"]);
+                }
+            }
+        }
+
+        for position, parameter in parameters {
+            let variableName = parameter["variable"];
+
+            if array_key_exists(position, positional) {
+                let arguments[] = positional[position];
+
+                continue;
+            }
+
+            if array_key_exists(variableName, named) {
+                let arguments[] = named[variableName];
+
+                continue;
+            }
+
+            if !fetch defaultValue, parameter["default"] {
+                return null;
+            }
+
+            if !in_array(defaultValue["type"], [258, 259, PHVOLT_T_STRING, PHVOLT_T_NULL, PHVOLT_T_FALSE, PHVOLT_T_TRUE]) {
+                return null;
+            }
+
+            let arguments[] = this->expression(defaultValue);
+        }
+
+        return "$this->macroFunctions['" . name . "'](" . join(", ", arguments) . ")";
+    }
+
+    /**
+     * Identifies the definition of a user function or filter: the function
+     * name, or the file and lines of a closure
+     */
+    protected function getDefinitionHash(var definition) -> string
+    {
+        var reflection;
+
+        if typeof definition == "string" {
+            return definition;
+        }
+
+        if typeof definition == "object" && definition instanceof \Closure {
+            let reflection = new \ReflectionFunction(definition);
+
+            return reflection->getFileName() . ":" . reflection->getStartLine() . "-" . reflection->getEndLine();
+        }
+
+        return gettype(definition);
+    }
+
+    /**
+     * Returns the code escaping an expression for HTML (or for HTML
+     * attributes). With the "optimize" option, and when the "escaper" service
+     * is a Phalcon\Escaper, htmlspecialchars() is called directly with the
+     * settings of the escaper at compile time, avoiding the service lookup and
+     * the method call for every output
+     */
+    protected function getEscapeCode(string! exprCode, bool attribute = false) -> string
+    {
+        var container, escaper, quoteType;
+
+        let container = this->container;
+
+        if this->getOption("optimize") === true && typeof container == "object" && container->has("escaper") {
+            let escaper = container->getShared("escaper");
+
+            if get_class(escaper) === "Phalcon\\Escaper" {
+                if attribute {
+                    let quoteType = ENT_QUOTES;
+                } else {
+                    let quoteType = escaper->getHtmlQuoteType();
+                }
+
+                return "htmlspecialchars(" . exprCode . ", " . var_export(quoteType, true) . ", " . var_export(escaper->getEncoding(), true) . ", " . var_export(escaper->getDoubleEncode(), true) . ")";
+            }
+        }
+
+        if attribute {
+            return "$this->escaper->escapeHtmlAttr(" . exprCode . ")";
+        }
+
+        return "$this->escaper->escapeHtml(" . exprCode . ")";
+    }
+
+    /**
+     * Returns the file a template source is compiled to in the "stringCache"
+     * directory. The name is the hash of the source, the scalar options, the
+     * definitions of the user functions and filters (closures by their
+     * location), the extensions and, with the "optimize" option, the settings
+     * of the escaper, all of which can change the compiled code
+     */
+    protected function getStringCachePath(string! viewCode) -> string
+    {
+        var container, directory, escaper, name, value, extension;
+        array options, functions, filters, extensions, escaping;
+
+        let directory = this->getOption("stringCache");
+
+        if unlikely typeof directory != "string" || directory === "" {
+            throw new Exception(
+                "The 'stringCache' option must be set to a directory"
+            );
+        }
+
+        let options    = [],
+            functions  = [],
+            filters    = [],
+            extensions = [],
+            escaping   = [];
+
+        if typeof this->options == "array" {
+            for name, value in this->options {
+                if is_scalar(value) {
+                    let options[name] = value;
+                }
+            }
+        }
+
+        if typeof this->functions == "array" {
+            for name, value in this->functions {
+                let functions[name] = this->getDefinitionHash(value);
+            }
+        }
+
+        if typeof this->filters == "array" {
+            for name, value in this->filters {
+                let filters[name] = this->getDefinitionHash(value);
+            }
+        }
+
+        let container = this->container;
+
+        if this->getOption("optimize") === true && typeof container == "object" && container->has("escaper") {
+            let escaper = container->getShared("escaper");
+
+            if get_class(escaper) === "Phalcon\\Escaper" {
+                let escaping = [
+                    escaper->getHtmlQuoteType(),
+                    escaper->getEncoding(),
+                    escaper->getDoubleEncode()
+                ];
+            }
+        }
+
+        if typeof this->extensions == "array" {
+            for extension in this->extensions {
+                let extensions[] = get_class(extension);
+            }
+        }
+
+        return rtrim(directory, "\\/") . DIRECTORY_SEPARATOR . md5(
+            serialize(
+                [
+                    viewCode,
+                    this->autoescape,
+                    options,
+                    functions,
+                    filters,
+                    extensions,
+                    escaping
+                ]
+            )
+        ) . ".php";
+    }
+
     /**
      * Resolves filter intermediate code into PHP function calls
      */
@@ -2362,6 +3256,18 @@ class Compiler implements InjectionAwareInterface
          * "length" uses the length method implemented in the Volt adapter
          */
         if name == "length" {
+            /**
+             * With the "optimize" option the length of variables is computed
+             * inline
+             */
+            if this->getOption("optimize") === true && preg_match("/^\\$[a-zA-Z0-9_]+$/", left) {
+                if function_exists("mb_strlen") {
+                    return "((is_array(" . left . ") || is_object(" . left . ")) ? count(" . left . ") : mb_strlen(" . left . "))";
+                }
+
+                return "((is_array(" . left . ") || is_object(" . left . ")) ? count(" . left . ") : strlen(" . left . "))";
+            }
+
             return "$this->length(" . arguments . ")";
         }
 
@@ -2369,7 +3275,7 @@ class Compiler implements InjectionAwareInterface
          * "e"/"escape" filter uses the escaper component
          */
         if name == "e" || name == "escape" {
-            return "$this->escaper->escapeHtml(" . arguments . ")";
+            return this->getEscapeCode(arguments);
         }
 
         /**
@@ -2391,7 +3297,7 @@ class Compiler implements InjectionAwareInterface
          * attributes
          */
         if name == "escape_attr" {
-            return "$this->escaper->escapeHtmlAttr(" . arguments . ")";
+            return this->getEscapeCode(arguments, true);
         }
 
         /**
@@ -2552,6 +3458,32 @@ class Compiler implements InjectionAwareInterface
         );
     }
 
+    /**
+     * Resolves the template of an include with parameters the way
+     * Phalcon\Mvc\View::partial() does, or returns FALSE if it can't be found
+     * at compile time
+     */
+    protected function resolveIncludePath(string! path)
+    {
+        var view, candidate, finalPath;
+
+        let view = this->view;
+
+        if typeof view == "object" && method_exists(view, "getPartialsDir") {
+            let path = view->getPartialsDir() . path;
+        }
+
+        for candidate in [path, path . ".volt"] {
+            let finalPath = this->getFinalPath(candidate);
+
+            if file_exists(finalPath) {
+                return finalPath;
+            }
+        }
+
+        return false;
+    }
+
     /**
      * Traverses a statement list compiling each of its nodes
      */
@@ -2741,15 +3673,27 @@ class Compiler implements InjectionAwareInterface
                     );
 
                     /**
-                     * If the compilation doesn't return anything we include the
-                     * compiled path
+                     * If the compilation doesn't return anything we read the
+                     * serialized blocks from the compiled path
                      */
                     if tempCompilation === null {
                         let tempCompilation = file_get_contents(
                             subCompiler->getCompiledTemplatePath()
                         );
+
+                        if tempCompilation {
+                            let tempCompilation = unserialize(tempCompilation);
+                        } else {
+                            let tempCompilation = [];
+                        }
                     }
 
+                    let this->dependencies = array_merge(
+                        this->dependencies,
+                        [finalPath],
+                        subCompiler->getDependencies()
+                    );
+
                     let this->extended = true;
                     let this->extendedBlocks = tempCompilation;
                     let blockMode = extended;
@@ -2908,4 +3852,14 @@ class Compiler implements InjectionAwareInterface
          */
         return statements;
     }
+
+    /**
+     * Releases the compilation lock, removing the lock file while it is held
+     */
+    protected function unlockCompilation(var handle, string! lockPath) -> void
+    {
+        unlink(lockPath);
+        flock(handle, LOCK_UN);
+        fclose(handle);
+    }
 }
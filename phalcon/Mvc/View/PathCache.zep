@@ -0,0 +1,178 @@
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Mvc\View;
+
+/**
+ * Phalcon\Mvc\View\PathCache
+ *
+ * Keeps the files resolved for the views of Phalcon\Mvc\View and
+ * Phalcon\Mvc\View\Simple, either in memory (the "pathCache" option set to
+ * true), shared by the components of the process with the same key, or in
+ * a cache (Phalcon\Storage adapter or PSR-16 cache) shared across requests.
+ *
+ * The key depends on the parts passed by the view (directories and engines)
+ * and on the modification time of the "pathCacheManifest" file
+ */
+class PathCache
+{
+    /**
+     * @var object | bool
+     */
+    protected cache;
+
+    /**
+     * Key the resolved files are persisted with
+     *
+     * @var string
+     */
+    protected key = "";
+
+    /**
+     * @var int | null
+     */
+    protected lifetime = null;
+
+    /**
+     * Files resolved for every view, indexed by the view name
+     *
+     * @var array
+     */
+    protected paths = [];
+
+    /**
+     * Files resolved since the cache was loaded
+     *
+     * @var array
+     */
+    protected pending = [];
+
+    /**
+     * Files resolved by the caches created with "pathCache" set to true, by
+     * key
+     *
+     * @var array
+     */
+    protected static sharedPaths = [];
+
+    /**
+     * Phalcon\Mvc\View\PathCache constructor. Loads the files stored under
+     * the key of the parts passed
+     */
+    public function __construct(var cache, array keyParts, array options = [])
+    {
+        var lifetime, manifest, paths, prefix;
+        int modified = 0;
+
+        if !fetch prefix, options["pathCacheKey"] {
+            let prefix = "view-paths-";
+        }
+
+        if fetch manifest, options["pathCacheManifest"] {
+            if file_exists(manifest) {
+                let modified = (int) filemtime(manifest);
+            }
+        }
+
+        if fetch lifetime, options["pathCacheLifetime"] {
+            let this->lifetime = lifetime;
+        }
+
+        let keyParts[]  = modified,
+            this->cache = cache,
+            this->key   = prefix . md5(serialize(keyParts));
+
+        let paths = this->read();
+
+        if typeof paths == "array" {
+            let this->paths = paths;
+        }
+    }
+
+    /**
+     * Returns the files resolved for a view, or null if it wasn't resolved
+     * yet
+     */
+    public function get(string! viewPath) -> array | null
+    {
+        var resolved;
+
+        if !fetch resolved, this->paths[viewPath] {
+            return null;
+        }
+
+        return resolved;
+    }
+
+    /**
+     * Saves the files resolved since the last save, merged with the ones
+     * saved in the meantime by other requests
+     */
+    public function save() -> void
+    {
+        var resolved, sharedPaths, stored, viewPath;
+
+        if empty this->pending {
+            return;
+        }
+
+        let stored = this->read();
+
+        if typeof stored != "array" {
+            let stored = [];
+        }
+
+        for viewPath, resolved in this->pending {
+            let stored[viewPath] = resolved;
+        }
+
+        let this->paths   = stored,
+            this->pending = [];
+
+        if typeof this->cache == "object" {
+            this->cache->set(this->key, stored, this->lifetime);
+
+            return;
+        }
+
+        let sharedPaths = self::sharedPaths,
+            sharedPaths[this->key] = stored,
+            self::sharedPaths = sharedPaths;
+    }
+
+    /**
+     * Stores the files resolved for a view, saved with the next save()
+     */
+    public function set(string! viewPath, array resolved) -> void
+    {
+        let this->paths[viewPath]   = resolved,
+            this->pending[viewPath] = resolved;
+    }
+
+    /**
+     * Reads the files stored under the key
+     */
+    protected function read() -> var
+    {
+        var sharedPaths, stored;
+
+        if typeof this->cache == "object" {
+            return this->cache->get(this->key);
+        }
+
+        let sharedPaths = self::sharedPaths;
+
+        if !fetch stored, sharedPaths[this->key] {
+            return null;
+        }
+
+        return stored;
+    }
+}
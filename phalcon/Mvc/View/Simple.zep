@@ -46,6 +46,10 @@ use Phalcon\Mvc\View\Engine\Php as PhpEngine;
  *     ]
  * );
  *</code>
+ *
+ * As in Phalcon\Mvc\View, the "pathCache", "pathCacheKey",
+ * "pathCacheLifetime" and "pathCacheManifest" options cache the files
+ * resolved for the views, saved once at the end of the render
  */
 class Simple extends Injectable implements ViewBaseInterface
 {
@@ -65,6 +69,20 @@ class Simple extends Injectable implements ViewBaseInterface
      */
     protected registeredEngines { get };
 
+    /**
+     * Files resolved for the views, with the "pathCache" option
+     *
+     * @var \Phalcon\Mvc\View\PathCache | null
+     */
+    protected pathCache = null;
+
+    /**
+     * Whether a render is in progress
+     *
+     * @var bool
+     */
+    protected rendering = false;
+
     protected viewsDir;
 
     protected viewParams = [];
@@ -217,6 +235,11 @@ class Simple extends Injectable implements ViewBaseInterface
 
         ob_end_clean();
 
+        /**
+         * Partials rendered outside of render()
+         */
+        this->saveResolvedPaths();
+
         /**
          * Content is output to the parent view
          */
@@ -238,7 +261,8 @@ class Simple extends Injectable implements ViewBaseInterface
      */
     public function registerEngines(array! engines)
     {
-        let this->registeredEngines = engines;
+        let this->registeredEngines = engines,
+            this->pathCache         = null;
     }
 
     /**
@@ -246,7 +270,7 @@ class Simple extends Injectable implements ViewBaseInterface
      */
     public function render(string! path, array params = []) -> string
     {
-        var mergedParams, viewParams;
+        var exception, mergedParams, rendering, viewParams;
 
         /**
          * Create a virtual symbol table
@@ -262,10 +286,23 @@ class Simple extends Injectable implements ViewBaseInterface
          */
         let mergedParams = array_merge(viewParams, params);
 
+        let rendering       = this->rendering,
+            this->rendering = true;
+
         /**
          * internalRender is also reused by partials
          */
-        this->internalRender(path, mergedParams);
+        try {
+            this->internalRender(path, mergedParams);
+        } catch \Throwable, exception {
+            let this->rendering = rendering;
+
+            throw exception;
+        }
+
+        let this->rendering = rendering;
+
+        this->saveResolvedPaths();
 
         ob_end_clean();
 
@@ -341,7 +378,8 @@ class Simple extends Injectable implements ViewBaseInterface
      */
     public function setViewsDir(string! viewsDir)
     {
-        let this->viewsDir = Str::dirSeparator(viewsDir);
+        let this->viewsDir  = Str::dirSeparator(viewsDir),
+            this->pathCache = null;
     }
 
     /**
@@ -427,9 +465,9 @@ class Simple extends Injectable implements ViewBaseInterface
      */
     final protected function internalRender(string! path, params)
     {
-        var eventsManager, engines, extension, engine;
+        var eventsManager, engines, extension, engine, viewEnginePath;
         bool notExists, mustClean;
-        string viewEnginePath, viewsDirPath;
+        string viewsDirPath;
 
         let eventsManager = this->eventsManager;
 
@@ -457,20 +495,11 @@ class Simple extends Injectable implements ViewBaseInterface
         let engines = this->loadTemplateEngines();
 
         /**
-         * Views are rendered in each engine
+         * Views are rendered with the first engine having a file for the view
+         * that is not cancelled by beforeRenderView
          */
-        for extension, engine in engines {
-            if file_exists(viewsDirPath . extension) {
-                let viewEnginePath = viewsDirPath . extension;
-            } elseif substr(viewsDirPath, -strlen(extension)) == extension && file_exists(viewsDirPath) {
-                /**
-                 * if passed filename with engine extension
-                 */
-
-                let viewEnginePath = viewsDirPath;
-            } else {
-                continue;
-            }
+        for extension, viewEnginePath in this->resolveViewPath(engines, path) {
+            let engine = engines[extension];
 
             /**
              * Call beforeRenderView if there is an events manager available
@@ -511,4 +540,70 @@ class Simple extends Injectable implements ViewBaseInterface
             eventsManager->fire("view:afterRender", this);
         }
     }
+
+    /**
+     * Returns the files of a view as extension => path pairs in the order of
+     * the engines, or an empty array if the view doesn't exist. The path can
+     * include the extension of the engine
+     */
+    protected function resolveViewPath(array engines, string path) -> array
+    {
+        var cache, extension, resolved, viewsDirPath;
+
+        if !fetch cache, this->options["pathCache"] {
+            let cache = false;
+        }
+
+        if cache {
+            if this->pathCache === null {
+                let this->pathCache = new PathCache(
+                    cache,
+                    [
+                        this->viewsDir,
+                        array_keys(engines)
+                    ],
+                    this->options
+                );
+            }
+
+            let resolved = this->pathCache->get(path);
+
+            if resolved !== null {
+                return resolved;
+            }
+        }
+
+        let viewsDirPath = this->viewsDir . path,
+            resolved     = [];
+
+        for extension, _ in engines {
+            if file_exists(viewsDirPath . extension) {
+                let resolved[extension] = viewsDirPath . extension;
+            } elseif substr(viewsDirPath, -strlen(extension)) == extension && file_exists(viewsDirPath) {
+                /**
+                 * if passed filename with engine extension
+                 */
+                let resolved[extension] = viewsDirPath;
+            }
+        }
+
+        if cache {
+            this->pathCache->set(path, resolved);
+        }
+
+        return resolved;
+    }
+
+    /**
+     * Saves the files resolved for the views once the outermost render is
+     * done
+     */
+    protected function saveResolvedPaths() -> void
+    {
+        if this->rendering || this->pathCache === null {
+            return;
+        }
+
+        this->pathCache->save();
+    }
 }
@@ -1,4 +1,3 @@
-
 /**
  * This file is part of the Phalcon.
  *
@@ -10,21 +9,114 @@
 
 namespace Phalcon\Session\Adapter;
 
+use Phalcon\Helper\Arr;
+use Phalcon\Session\Exception;
 use Phalcon\Storage\Adapter\AdapterInterface;
 use SessionHandlerInterface;
+use SessionUpdateTimestampHandlerInterface;
 
-abstract class AbstractAdapter implements SessionHandlerInterface
+/**
+ * Phalcon\Session\Adapter\AbstractAdapter
+ *
+ * A session that has not changed since it was read is not written back:
+ * only its expiration is refreshed with updateTimestamp()
+ *
+ * The "locking" option sets how concurrent requests of the same session are
+ * handled:
+ *
+ * - "none" (default): no locking, the last request writing the session wins
+ * - "spin": the session is locked when it is read and unlocked when it is
+ *   closed, so the requests of a session run one after the other. A request
+ *   waits for the lock at most "lockTimeout" milliseconds (5000 by default)
+ *   and a lock expires after "lockTtl" milliseconds (30000 by default)
+ * - "optimistic": the session is not locked while the request runs. When it
+ *   is written, the variables changed or removed by the request are applied
+ *   to the session as currently stored, under a lock held only for the
+ *   write. The write fails when that lock can not be acquired within
+ *   "lockTimeout". This mode requires "session.serialize_handler" to be set
+ *   to "php_serialize"
+ *
+ *<code>
+ * $adapter = new \Phalcon\Session\Adapter\Redis(
+ *     $adapterFactory,
+ *     [
+ *         "locking"     => "spin",
+ *         "lockTimeout" => 2000,
+ *     ]
+ * );
+ *</code>
+ */
+abstract class AbstractAdapter implements SessionHandlerInterface, SessionUpdateTimestampHandlerInterface
 {
+    const LOCKING_NONE       = "none";
+    const LOCKING_OPTIMISTIC = "optimistic";
+    const LOCKING_SPIN       = "spin";
+
     /**
      * @var <AdapterInterface>
      */
     protected adapter;
 
+    /**
+     * Hashes of the payloads read, by session id
+     *
+     * @var array
+     */
+    protected hashes = [];
+
+    /**
+     * Lifetime of the sessions, in seconds
+     *
+     * @var int
+     */
+    protected lifetime = 3600;
+
+    /**
+     * Locking strategy
+     *
+     * @var string
+     */
+    protected locking = "none";
+
+    /**
+     * Tokens of the locks held, by session id
+     *
+     * @var array
+     */
+    protected locks = [];
+
+    /**
+     * Maximum time to wait for a lock, in milliseconds
+     *
+     * @var int
+     */
+    protected lockTimeout = 5000;
+
+    /**
+     * Time after which a lock expires, in milliseconds
+     *
+     * @var int
+     */
+    protected lockTtl = 30000;
+
+    /**
+     * Payloads read, by session id (optimistic locking)
+     *
+     * @var array
+     */
+    protected originals = [];
+
     /**
      * Close
      */
     public function close() -> bool
     {
+        var id;
+
+        for id in array_keys(this->locks) {
+            this->unlock(id);
+        }
+
         return true;
     }
 
@@ -33,11 +125,18 @@ abstract class AbstractAdapter implements SessionHandlerInterface
      */
     public function destroy(var id) -> bool
     {
+        var result = true;
+
+        unset this->hashes[id];
+        unset this->originals[id];
+
         if !empty(id) && this->adapter->has(id) {
-            return this->adapter->delete(id);
+            let result = this->adapter->delete(id);
         }
 
-        return true;
+        this->unlock(id);
+
+        return result;
     }
 
     /**
@@ -50,10 +149,31 @@ abstract class AbstractAdapter implements SessionHandlerInterface
 
     /**
      * Read
+     *
+     * @throws Exception
      */
     public function read(var id) -> string
     {
-        return this->adapter->get(id);
+        var data;
+
+        if this->locking === self::LOCKING_SPIN {
+            if unlikely !this->lock(id) {
+                throw new Exception(
+                    "The session '" . id . "' could not be locked within " .
+                    this->lockTimeout . "ms"
+                );
+            }
+        }
+
+        let data = (string) this->adapter->get(id);
+
+        let this->hashes[id] = md5(data);
+
+        if this->locking === self::LOCKING_OPTIMISTIC {
+            let this->originals[id] = data;
+        }
+
+        return data;
     }
 
     /**
@@ -65,10 +185,239 @@ abstract class AbstractAdapter implements SessionHandlerInterface
     }
 
     /**
-     * Write
+     * Refreshes the expiration of a session. The payload is written again by
+     * the adapters that can not only touch the key
+     */
+    public function updateTimestamp(var id, var data) -> bool
+    {
+        return this->adapter->set(id, data);
+    }
+
+    /**
+     * Checks that a session exists (used with session.use_strict_mode)
+     */
+    public function validateId(var id) -> bool
+    {
+        return this->adapter->has(id);
+    }
+
+    /**
+     * Write. A payload with the same hash as the one read is not written, its
+     * expiration is refreshed instead
      */
     public function write(var id, var data) -> bool
     {
+        var hash, previous;
+
+        let hash = md5(data);
+
+        if fetch previous, this->hashes[id] {
+            if previous === hash {
+                return this->updateTimestamp(id, data);
+            }
+        }
+
+        let this->hashes[id] = hash;
+
+        if this->locking === self::LOCKING_OPTIMISTIC {
+            return this->merge(id, data);
+        }
+
         return this->adapter->set(id, data);
     }
+
+    /**
+     * Creates the lock key if it does not exist, with the token as value and
+     * the "lockTtl" expiration
+     */
+    abstract protected function acquireLock(string! key, string! token) -> bool;
+
+    /**
+     * Sets the locking options
+     *
+     * @throws Exception
+     */
+    protected function initLocking(array! options) -> void
+    {
+        var locking;
+
+        let locking = Arr::get(options, "locking", self::LOCKING_NONE);
+
+        if unlikely !in_array(
+            locking,
+            [self::LOCKING_NONE, self::LOCKING_OPTIMISTIC, self::LOCKING_SPIN],
+            true
+        ) {
+            throw new Exception(
+                "The locking strategy '" . locking . "' is not supported"
+            );
+        }
+
+        let this->locking     = locking,
+            this->lockTimeout = (int) Arr::get(options, "lockTimeout", 5000),
+            this->lockTtl     = (int) Arr::get(options, "lockTtl", 30000);
+
+        /**
+         * The change sets need a payload that can be decoded outside of the
+         * session
+         */
+        if unlikely locking === self::LOCKING_OPTIMISTIC && ini_get("session.serialize_handler") !== "php_serialize" {
+            throw new Exception(
+                "The 'optimistic' locking strategy requires session.serialize_handler to be 'php_serialize'"
+            );
+        }
+    }
+
+    /**
+     * Locks a session, waiting with an increasing backoff until the lock is
+     * acquired or "lockTimeout" has elapsed
+     */
+    protected function lock(var id) -> bool
+    {
+        var deadline, token, wait;
+
+        if isset this->locks[id] {
+            return true;
+        }
+
+        let token    = bin2hex(random_bytes(16)),
+            deadline = microtime(true) + this->lockTimeout / 1000,
+            wait     = 1000;
+
+        loop {
+            if this->acquireLock(id . ".lock", token) {
+                let this->locks[id] = token;
+
+                return true;
+            }
+
+            if microtime(true) >= deadline {
+                return false;
+            }
+
+            usleep(wait + mt_rand(0, wait));
+
+            let wait = min(wait * 2, 100000);
+        }
+    }
+
+    /**
+     * Deletes the lock key if it still holds the token
+     */
+    abstract protected function releaseLock(string! key, string! token) -> bool;
+
+    /**
+     * Unlocks a session locked by this request
+     */
+    protected function unlock(var id) -> bool
+    {
+        var token;
+
+        if !fetch token, this->locks[id] {
+            return true;
+        }
+
+        unset this->locks[id];
+
+        return this->releaseLock(id . ".lock", token);
+    }
+
+    /**
+     * Decodes a payload of the "php_serialize" handler
+     */
+    private function decode(string data) -> array | null
+    {
+        var values;
+
+        if data === "" {
+            return [];
+        }
+
+        let values = unserialize(data);
+
+        if typeof values != "array" {
+            return null;
+        }
+
+        return values;
+    }
+
+    /**
+     * Applies the variables changed and removed since the session was read
+     * to the session as currently stored
+     */
+    private function merge(var id, var data) -> bool
+    {
+        var changes, current, key, original, read, removed, result, stored,
+            value, written;
+
+        if !fetch original, this->originals[id] {
+            let this->originals[id] = data;
+
+            return this->adapter->set(id, data);
+        }
+
+        let read    = this->decode(original),
+            written = this->decode(data);
+
+        if read === null || written === null {
+            let this->originals[id] = data;
+
+            return this->adapter->set(id, data);
+        }
+
+        let changes = [],
+            removed = [];
+
+        for key, value in written {
+            if !array_key_exists(key, read) || serialize(read[key]) !== serialize(value) {
+                let changes[key] = value;
+            }
+        }
+
+        for key, value in read {
+            if !array_key_exists(key, written) {
+                let removed[] = key;
+            }
+        }
+
+        /**
+         * Lock for the read-merge-write only. Without the lock the changes
+         * of another request could be lost, so the write fails
+         */
+        if unlikely !this->lock(id) {
+            unset this->hashes[id];
+
+            return false;
+        }
+
+        let stored = (string) this->adapter->get(id);
+
+        if stored !== original {
+            let current = this->decode(stored);
+
+            if current === null {
+                let current = [];
+            }
+
+            for key, value in changes {
+                let current[key] = value;
+            }
+
+            for key in removed {
+                unset current[key];
+            }
+
+            let data             = serialize(current),
+                this->hashes[id] = md5(data);
+        }
+
+        let result = this->adapter->set(id, data);
+
+        this->unlock(id);
+
+        let this->originals[id] = data;
+
+        return result;
+    }
 }
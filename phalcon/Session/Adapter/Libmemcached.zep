@@ -10,11 +10,15 @@
 
 namespace Phalcon\Session\Adapter;
 
+use Phalcon\Helper\Arr;
 use Phalcon\Storage\AdapterFactory;
 use Phalcon\Session\Adapter\AbstractAdapter;
 
 /**
  * Phalcon\Session\Adapter\Libmemcached
+ *
+ * Supports the "locking", "lockTimeout" and "lockTtl" options of
+ * Phalcon\Session\Adapter\AbstractAdapter
  */
 class Libmemcached extends AbstractAdapter
 {
@@ -24,6 +28,51 @@ class Libmemcached extends AbstractAdapter
     public function __construct(<AdapterFactory> factory, array! options = []) -> void
     {
         let options["prefix"] = "sess-memc-",
+            this->lifetime    = (int) Arr::get(options, "lifetime", 3600),
             this->adapter     = factory->newInstance("libmemcached", options);
+
+        this->initLocking(options);
+    }
+
+    /**
+     * Refreshes the expiration of a session without writing its payload. The
+     * payload is written if the key has expired in the meantime
+     */
+    public function updateTimestamp(var id, var data) -> bool
+    {
+        if this->adapter->getAdapter()->touch(id, this->lifetime) {
+            return true;
+        }
+
+        return this->adapter->set(id, data);
+    }
+
+    /**
+     * Creates the lock key with add(). Memcached expirations are in seconds,
+     * so "lockTtl" is rounded up
+     */
+    protected function acquireLock(string! key, string! token) -> bool
+    {
+        var ttl;
+
+        let ttl = (int) ceil(this->lockTtl / 1000);
+
+        return (bool) this->adapter->getAdapter()->add(key, token, max(ttl, 1));
+    }
+
+    /**
+     * Deletes the lock key if it still holds the token
+     */
+    protected function releaseLock(string! key, string! token) -> bool
+    {
+        var connection;
+
+        let connection = this->adapter->getAdapter();
+
+        if connection->get(key) !== token {
+            return false;
+        }
+
+        return (bool) connection->delete(key);
     }
 }
@@ -11,6 +11,7 @@
 namespace Phalcon\Session\Adapter;
 
 use SessionHandlerInterface;
+use SessionUpdateTimestampHandlerInterface;
 
 /**
  * Phalcon\Session\Adapter\Noop
@@ -28,7 +29,7 @@ use SessionHandlerInterface;
  * $session->setHandler(new Noop());
  * </code>
  */
-class Noop implements SessionHandlerInterface
+class Noop implements SessionHandlerInterface, SessionUpdateTimestampHandlerInterface
 {
     /**
      * The connection of some adapters
@@ -111,6 +112,22 @@ class Noop implements SessionHandlerInterface
         return true;
     }
 
+    /**
+     * Refreshes the expiration of a session
+     */
+    public function updateTimestamp(var id, var data) -> bool
+    {
+        return true;
+    }
+
+    /**
+     * Checks that a session exists (used with session.use_strict_mode)
+     */
+    public function validateId(var id) -> bool
+    {
+        return true;
+    }
+
     /**
      * Write
      */
@@ -10,11 +10,15 @@
 
 namespace Phalcon\Session\Adapter;
 
+use Phalcon\Helper\Arr;
 use Phalcon\Storage\AdapterFactory;
 use Phalcon\Session\Adapter\AbstractAdapter;
 
 /**
  * Phalcon\Session\Adapter\Redis
+ *
+ * Supports the "locking", "lockTimeout" and "lockTtl" options of
+ * Phalcon\Session\Adapter\AbstractAdapter
  */
  class Redis extends AbstractAdapter
 {
@@ -24,6 +28,89 @@ use Phalcon\Session\Adapter\AbstractAdapter;
     public function __construct(<AdapterFactory> factory, array! options = []) -> void
     {
         let options["prefix"] = "sess-reds-",
+            this->lifetime    = (int) Arr::get(options, "lifetime", 3600),
             this->adapter     = factory->newInstance("redis", options);
+
+        this->initLocking(options);
+    }
+
+    /**
+     * Refreshes the expiration of a session without writing its payload. The
+     * payload is written if the key has expired in the meantime
+     */
+    public function updateTimestamp(var id, var data) -> bool
+    {
+        if this->adapter->getAdapter()->expire(id, this->lifetime) {
+            return true;
+        }
+
+        return this->adapter->set(id, data);
+    }
+
+    /**
+     * Sets the lock key with SET NX PX. The token is written without the
+     * serializer of the connection, so the release script can compare it
+     */
+    protected function acquireLock(string! key, string! token) -> bool
+    {
+        var connection, exception, result, serializer;
+
+        let connection = this->adapter->getAdapter(),
+            serializer = connection->getOption(\Redis::OPT_SERIALIZER);
+
+        connection->setOption(\Redis::OPT_SERIALIZER, \Redis::SERIALIZER_NONE);
+
+        try {
+            let result = connection->set(
+                key,
+                token,
+                [
+                    "nx",
+                    "px" : this->lockTtl
+                ]
+            );
+        } catch \Throwable, exception {
+            connection->setOption(\Redis::OPT_SERIALIZER, serializer);
+
+            throw exception;
+        }
+
+        connection->setOption(\Redis::OPT_SERIALIZER, serializer);
+
+        return (bool) result;
+    }
+
+    /**
+     * Deletes the lock key with a script, so that a lock that has expired and
+     * was acquired by another request is not deleted. The arguments of the
+     * script are sent without the serializer of the connection, like the
+     * token
+     */
+    protected function releaseLock(string! key, string! token) -> bool
+    {
+        var connection, exception, result, script, serializer;
+
+        let script = "if redis.call('get', KEYS[1]) == ARGV[1] then " .
+            "return redis.call('del', KEYS[1]) end return 0";
+
+        let connection = this->adapter->getAdapter(),
+            serializer = connection->getOption(\Redis::OPT_SERIALIZER);
+
+        connection->setOption(\Redis::OPT_SERIALIZER, \Redis::SERIALIZER_NONE);
+
+        try {
+            let result = call_user_func_array(
+                [connection, "eval"],
+                [script, [key, token], 1]
+            );
+        } catch \Throwable, exception {
+            connection->setOption(\Redis::OPT_SERIALIZER, serializer);
+
+            throw exception;
+        }
+
+        connection->setOption(\Redis::OPT_SERIALIZER, serializer);
+
+        return (bool) result;
     }
 }
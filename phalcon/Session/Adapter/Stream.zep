@@ -16,7 +16,9 @@ use Phalcon\Session\Exception;
 /**
  * Phalcon\Session\Adapter\Stream
  *
- * This is the file based adapter. It stores sessions in a file based system
+ * This is the file based adapter. It stores sessions in a file based system.
+ * A session that has not changed since it was read is not written back, the
+ * modification time of its file is updated instead
  *
  * <code>
  * <?php
@@ -35,6 +37,13 @@ use Phalcon\Session\Exception;
  */
 class Stream extends Noop
 {
+    /**
+     * Hashes of the payloads read, by session id
+     *
+     * @var array
+     */
+    private hashes = [];
+
     /**
      * @var string
      */
@@ -67,6 +76,8 @@ class Stream extends Noop
     {
         var file;
 
+        unset this->hashes[id];
+
         let file = this->path . this->getPrefixedName(id);
 
         if file_exists(file) && is_file(file) {
@@ -122,15 +133,44 @@ class Stream extends Noop
             }
         }
 
+        let this->hashes[id] = md5(data);
+
         return data;
     }
 
-    public function write(var id, var data) -> bool
+    public function updateTimestamp(var id, var data) -> bool
     {
         var name;
 
         let name = this->path . this->getPrefixedName(id);
 
+        if file_exists(name) && touch(name) {
+            return true;
+        }
+
+        return false !== file_put_contents(name, data);
+    }
+
+    public function validateId(var id) -> bool
+    {
+        return file_exists(this->path . this->getPrefixedName(id));
+    }
+
+    public function write(var id, var data) -> bool
+    {
+        var hash, name, previous;
+
+        let hash = md5(data);
+
+        if fetch previous, this->hashes[id] {
+            if previous === hash {
+                return this->updateTimestamp(id, data);
+            }
+        }
+
+        let name = this->path . this->getPrefixedName(id),
+            this->hashes[id] = hash;
+
         return false !== file_put_contents(name, data);
     }
 }
@@ -22,6 +22,23 @@ use Phalcon\Session\ManagerInterface;
  * Phalcon\Session\Manager
  *
  * Session manager class
+ *
+ * With the "lazy" option, start() only registers the session and the handler
+ * is opened and read the first time a variable is set, or read while the
+ * request carries a session cookie (or an id set with setId()). Requests of
+ * visitors without a session never reach the session store. The session
+ * has to be used before any output is sent.
+ *
+ *<code>
+ * $session = new \Phalcon\Session\Manager(
+ *     [
+ *         "lazy" => true,
+ *     ]
+ * );
+ *
+ * $session->setHandler($handler);
+ * $session->start();
+ *</code>
  */
 class Manager implements ManagerInterface, InjectionAwareInterface
 {
@@ -35,6 +52,11 @@ class Manager implements ManagerInterface, InjectionAwareInterface
      */
     private handler = null;
 
+    /**
+     * @var bool
+     */
+    private lazy = false;
+
     /**
      * @var string
      */
@@ -45,6 +67,14 @@ class Manager implements ManagerInterface, InjectionAwareInterface
      */
     private options = [];
 
+    /**
+     * Whether start() was called in lazy mode and the session is not started
+     * yet
+     *
+     * @var bool
+     */
+    private pending = false;
+
     /**
      * @var string
      */
@@ -95,6 +125,16 @@ class Manager implements ManagerInterface, InjectionAwareInterface
      */
     public function destroy() -> void
     {
+        if this->pending {
+            if !this->hasCookie() {
+                let this->pending = false;
+
+                return;
+            }
+
+            this->startPending();
+        }
+
         if (true === this->exists()) {
             session_destroy();
 
@@ -117,6 +157,14 @@ class Manager implements ManagerInterface, InjectionAwareInterface
     {
         var uniqueKey, value = null;
 
+        if this->pending {
+            if !this->hasCookie() {
+                return defaultValue;
+            }
+
+            this->startPending();
+        }
+
         if (false === this->exists()) {
             // To use $_SESSION variable we need to start session first
             return value;
@@ -175,6 +223,14 @@ class Manager implements ManagerInterface, InjectionAwareInterface
     {
         var uniqueKey;
 
+        if this->pending {
+            if !this->hasCookie() {
+                return false;
+            }
+
+            this->startPending();
+        }
+
         if (false === this->exists()) {
             // To use $_SESSION variable we need to start session first
             return false;
@@ -202,6 +258,10 @@ class Manager implements ManagerInterface, InjectionAwareInterface
 
         let delete = (bool) deleteOldSession;
 
+        if this->pending && this->hasCookie() {
+            this->startPending();
+        }
+
         if (true === this->exists()) {
             session_regenerate_id(delete);
         }
@@ -222,6 +282,14 @@ class Manager implements ManagerInterface, InjectionAwareInterface
      */
     public function remove(string key)
     {
+        if this->pending {
+            if !this->hasCookie() {
+                return;
+            }
+
+            this->startPending();
+        }
+
         if (false === this->exists()) {
             // To use $_SESSION variable we need to start session first
             return;
@@ -241,6 +309,10 @@ class Manager implements ManagerInterface, InjectionAwareInterface
     {
         var uniqueKey;
 
+        if this->pending {
+            this->startPending();
+        }
+
         if (false === this->exists()) {
             // To use $_SESSION variable we need to start session first
             return;
@@ -322,19 +394,20 @@ class Manager implements ManagerInterface, InjectionAwareInterface
     public function setOptions(array options) -> void
     {
         let this->uniqueId = Arr::get(options, "uniqueId", ""),
+            this->lazy     = (bool) Arr::get(options, "lazy", false),
             this->options  = options;
     }
 
     /**
      * Starts the session (if headers are already sent the session will not be
-     * started)
+     * started). In lazy mode the session is only started when it is used
      */
     public function start() -> bool
     {
         /**
          * Check if the session exists
          */
-        if (true === this->exists()) {
+        if (true === this->exists() || this->pending) {
             return true;
         }
 
@@ -349,6 +422,15 @@ class Manager implements ManagerInterface, InjectionAwareInterface
             throw new Exception("The session handler is not valid");
         }
 
+        /**
+         * Defer the handler until the session is used
+         */
+        if this->lazy {
+            let this->pending = true;
+
+            return true;
+        }
+
         /**
          * Register the handler
          */
@@ -389,4 +471,46 @@ class Manager implements ManagerInterface, InjectionAwareInterface
     {
         return this->uniqueId . "#" . key;
     }
+
+    /**
+     * Whether the request refers to an existing session: a session cookie was
+     * sent or an id was set
+     */
+    private function hasCookie() -> bool
+    {
+        var name;
+
+        if session_id() !== "" {
+            return true;
+        }
+
+        let name = session_name();
+
+        return isset _COOKIE[name];
+    }
+
+    /**
+     * Starts the session deferred by start() in lazy mode
+     */
+    private function startPending() -> bool
+    {
+        let this->pending = false;
+
+        if (true === this->exists()) {
+            return true;
+        }
+
+        /**
+         * Cannot start this - headers already sent
+         */
+        if (true === headers_sent()) {
+            return false;
+        }
+
+        this->registerHandler(this->handler);
+
+        session_start();
+
+        return true;
+    }
 }
@@ -14,6 +14,7 @@ use DateInterval;
 use Phalcon\Helper\Arr;
 use Phalcon\Storage\Adapter\AdapterInterface;
 use Phalcon\Storage\Exception;
+use Phalcon\Storage\Metrics;
 use Phalcon\Storage\SerializerFactory;
 use Phalcon\Storage\Serializer\SerializerInterface;
 
@@ -38,6 +39,13 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     protected lifetime = 3600;
 
+    /**
+     * Metrics collector, null when the operations are not measured
+     *
+     * @var <Metrics>|null
+     */
+    protected metrics = null;
+
     /**
      * @var string
      */
@@ -57,24 +65,46 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     protected serializerFactory;
 
+    /**
+     * Lifetime of the tag versions
+     *
+     * @var int
+     */
+    protected tagLifetime = 2592000;
+
     /**
      * Sets parameters based on options
      */
     protected function __construct(<SerializerFactory> factory, array! options) -> void
     {
+        var metrics;
+
+        let metrics = Arr::get(options, "metrics", null);
+
+        if unlikely metrics !== null && !(metrics instanceof Metrics) {
+            throw new Exception("The 'metrics' option must be an instance of Phalcon\\Storage\\Metrics");
+        }
+
         /**
          * Lets set some defaults and options here
          */
         let this->defaultSerializer = Arr::get(options, "defaultSerializer", "Php"),
             this->lifetime          = Arr::get(options, "lifetime", 3600),
+            this->metrics           = metrics,
             this->serializer        = Arr::get(options, "serializer", null),
-            this->serializerFactory = factory;
+            this->serializerFactory = factory,
+            this->tagLifetime       = (int) Arr::get(options, "tagLifetime", 2592000);
 
         if isset options["prefix"] {
             let this->prefix = options["prefix"];
         }
     }
 
+    /**
+     * Stores data in the adapter only if the key does not exist yet
+     */
+    abstract public function add(string! key, var value, var ttl = null) -> bool;
+
     /**
      * Flushes/clears the cache
      */
@@ -90,6 +120,26 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     abstract public function delete(string! key) -> bool;
 
+    /**
+     * Deletes several keys from the adapter. Adapters able to delete them in
+     * one operation override this method
+     */
+    public function deleteMultiple(array! keys) -> bool
+    {
+        var key;
+        bool result;
+
+        let result = true;
+
+        for key in keys {
+            if !this->delete(key) {
+                let result = false;
+            }
+        }
+
+        return result;
+    }
+
     /**
      * Reads data from the adapter
      */
@@ -105,6 +155,83 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     abstract public function getKeys() -> array;
 
+    /**
+     * Returns the metrics collector, if any
+     */
+    public function getMetrics() -> <Metrics> | null
+    {
+        return this->metrics;
+    }
+
+    /**
+     * Reads several keys from the adapter. Adapters able to read them in one
+     * operation override this method
+     */
+    public function getMultiple(array! keys, var defaultValue = null) -> array
+    {
+        var key;
+        array results;
+
+        let results = [];
+
+        for key in keys {
+            let results[key] = this->get(key, defaultValue);
+        }
+
+        return results;
+    }
+
+    /**
+     * Returns the key to use for an item depending on tags. The versions of
+     * the tags are read in one operation; a missing version is created
+     *
+     *<code>
+     * $key = $adapter->getTaggedKey("product-12", ["products", "prices"]);
+     *
+     * $adapter->set($key, $product);
+     *
+     * // Every product and price is computed again
+     * $adapter->invalidateTags(["prices"]);
+     *</code>
+     */
+    public function getTaggedKey(string! key, array! tags) -> string
+    {
+        var tag, tagKey, version, versions;
+        array tagKeys;
+
+        if empty tags {
+            return key;
+        }
+
+        let tags = array_unique(tags);
+
+        sort(tags);
+
+        let tagKeys = [];
+
+        for tag in tags {
+            let tagKeys[] = "tag-" . tag;
+        }
+
+        let versions = this->getMultiple(tagKeys);
+
+        for tagKey, version in versions {
+            if version {
+                continue;
+            }
+
+            let version = bin2hex(random_bytes(8));
+
+            if !this->add(tagKey, version, this->tagLifetime) {
+                let version = this->get(tagKey, version);
+            }
+
+            let versions[tagKey] = version;
+        }
+
+        return key . "-" . substr(md5(implode("-", versions)), 0, 12);
+    }
+
     /**
      * Checks if an element exists in the cache
      */
@@ -115,11 +242,61 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     abstract public function increment(string! key, int value = 1) -> int | bool;
 
+    /**
+     * Invalidates every key obtained with getTaggedKey() for these tags by
+     * giving them new versions. The items are not deleted, they expire
+     */
+    public function invalidateTags(array! tags) -> bool
+    {
+        var tag;
+        array versions;
+
+        let versions = [];
+
+        for tag in tags {
+            let versions["tag-" . tag] = bin2hex(random_bytes(8));
+        }
+
+        if empty versions {
+            return true;
+        }
+
+        return this->setMultiple(versions, this->tagLifetime);
+    }
+
     /**
      * Stores data in the adapter
      */
     abstract public function set(string! key, var value, var ttl = null) -> bool;
 
+    /**
+     * Sets the metrics collector, or removes it with null
+     */
+    public function setMetrics(<Metrics> metrics = null) -> void
+    {
+        let this->metrics = metrics;
+    }
+
+    /**
+     * Stores several key => value pairs in the adapter. Adapters able to
+     * store them in one operation override this method
+     */
+    public function setMultiple(array! values, var ttl = null) -> bool
+    {
+        var key, value;
+        bool result;
+
+        let result = true;
+
+        for key, value in values {
+            if !this->set(key, value, ttl) {
+                let result = false;
+            }
+        }
+
+        return result;
+    }
+
     /**
      * Returns the key requested, prefixed
      */
@@ -135,11 +312,25 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     protected function getSerializedData(var content) -> var
     {
+        var start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
         if this->defaultSerializer !== "" {
             this->serializer->setData(content);
             let content = this->serializer->serialize();
         }
 
+        if unlikely this->metrics !== null {
+            this->metrics->increment("serializationTime", microtime(true) - start);
+
+            if typeof content == "string" {
+                this->metrics->increment("bytesOut", strlen(content));
+            }
+        }
+
         return content;
     }
 
@@ -172,15 +363,29 @@ abstract class AbstractAdapter implements AdapterInterface
      */
     protected function getUnserializedData(var content, var defaultValue = null) -> var
     {
+        var start;
+
         if !content {
             return defaultValue;
         }
 
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+
+            if typeof content == "string" {
+                this->metrics->increment("bytesIn", strlen(content));
+            }
+        }
+
         if this->defaultSerializer !== "" {
             this->serializer->unserialize(content);
             let content = this->serializer->getData();
         }
 
+        if unlikely this->metrics !== null {
+            this->metrics->increment("serializationTime", microtime(true) - start);
+        }
+
         return content;
     }
 
@@ -198,4 +403,14 @@ abstract class AbstractAdapter implements AdapterInterface
         let className        = strtolower(this->defaultSerializer),
             this->serializer = this->serializerFactory->newInstance(className);
     }
+
+    /**
+     * Records in the metrics collector an operation started at start, a
+     * microtime(true) value. Operations on several keys are recorded under
+     * the first key
+     */
+    protected function measure(string! operation, var key, float start, var hit = null) -> void
+    {
+        this->metrics->record(operation, (string) key, microtime(true) - start, hit);
+    }
 }
@@ -19,6 +19,12 @@ use Phalcon\Storage\Serializer\SerializerInterface;
  */
 interface AdapterInterface
 {
+    /**
+     * Stores data in the adapter only if the key does not exist yet. The
+     * check and the write are atomic, so it can be used as a lock
+     */
+    public function add(string! key, var value, var ttl = null) -> bool;
+
     /**
      * Flushes/clears the cache
      */
@@ -34,6 +40,12 @@ interface AdapterInterface
      */
     public function delete(string! key) -> bool;
 
+    /**
+     * Deletes several keys from the adapter in as few operations as the
+     * backend allows
+     */
+    public function deleteMultiple(array! keys) -> bool;
+
     /**
      * Reads data from the adapter
      */
@@ -50,11 +62,24 @@ interface AdapterInterface
      */
     public function getKeys() -> array;
 
+    /**
+     * Reads several keys from the adapter in as few operations as the backend
+     * allows. Returns an array indexed by the requested keys
+     */
+    public function getMultiple(array! keys, var defaultValue = null) -> array;
+
     /**
      * Returns the prefix for the keys
      */
     public function getPrefix() -> string;
 
+    /**
+     * Returns the key to use for an item depending on tags. The current
+     * version of every tag is folded into the key, so invalidateTags()
+     * makes the items stored with the previous versions unreachable
+     */
+    public function getTaggedKey(string! key, array! tags) -> string;
+
     /**
      * Checks if an element exists in the cache
      */
@@ -65,8 +90,19 @@ interface AdapterInterface
      */
     public function increment(string! key, int value = 1) -> int | bool;
 
+    /**
+     * Invalidates every key obtained with getTaggedKey() for these tags
+     */
+    public function invalidateTags(array! tags) -> bool;
+
     /**
      * Stores data in the adapter
      */
     public function set(string! key, var value, var ttl = null) -> bool;
+
+    /**
+     * Stores several key => value pairs in the adapter in as few operations
+     * as the backend allows
+     */
+    public function setMultiple(array! values, var ttl = null) -> bool;
 }
@@ -44,6 +44,36 @@ class Apcu extends AbstractAdapter
         this->initSerializer();
     }
 
+    /**
+     * Stores data in the adapter only if the key does not exist yet
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = apcu_add(
+            this->getPrefixedKey(key),
+            this->getSerializedData(value),
+            this->getTtl(ttl)
+        );
+
+        if unlikely this->metrics !== null {
+            this->measure("add", key, start);
+        }
+
+        return result;
+    }
+
     /**
      * Flushes/clears the cache
      */
@@ -91,7 +121,55 @@ class Apcu extends AbstractAdapter
      */
     public function delete(string! key) -> bool
     {
-        return apcu_delete(this->getPrefixedKey(key));
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = apcu_delete(this->getPrefixedKey(key));
+
+        if unlikely this->metrics !== null {
+            this->measure("delete", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Deletes several keys with a single apcu_delete() call
+     *
+     * @param array $keys
+     *
+     * @return bool
+     */
+    public function deleteMultiple(array! keys) -> bool
+    {
+        var failed, key, start;
+        array prefixedKeys;
+
+        if empty keys {
+            return true;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let prefixedKeys = [];
+
+        for key in keys {
+            let prefixedKeys[] = this->getPrefixedKey(key);
+        }
+
+        let failed = apcu_delete(prefixedKeys);
+
+        if unlikely this->metrics !== null {
+            this->measure("deleteMultiple", current(keys), start);
+            this->metrics->increment("deletes", count(keys));
+        }
+
+        return typeof failed == "array" && count(failed) === 0;
     }
 
     /**
@@ -104,10 +182,18 @@ class Apcu extends AbstractAdapter
      */
     public function get(string! key, var defaultValue = null) -> var
     {
-    	var content;
-	
+        var content, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
         let content = apcu_fetch(this->getPrefixedKey(key));
 
+        if unlikely this->metrics !== null {
+            this->measure("get", key, start, content !== false);
+        }
+
         return this->getUnserializedData(content, defaultValue);
     }
 
@@ -147,6 +233,58 @@ class Apcu extends AbstractAdapter
         return results;
     }
 
+    /**
+     * Reads several keys with a single apcu_fetch() call
+     *
+     * @param array $keys
+     * @param null  $defaultValue
+     *
+     * @return array
+     */
+    public function getMultiple(array! keys, var defaultValue = null) -> array
+    {
+        var key, start, value, values;
+        array prefixedKeys, results;
+
+        let results = [];
+
+        if empty keys {
+            return results;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let prefixedKeys = [];
+
+        for key in keys {
+            let prefixedKeys[] = this->getPrefixedKey(key);
+        }
+
+        let values = apcu_fetch(prefixedKeys);
+
+        if typeof values != "array" {
+            let values = [];
+        }
+
+        if unlikely this->metrics !== null {
+            this->measure("getMultiple", current(keys), start);
+            this->metrics->increment("hits", count(values));
+            this->metrics->increment("misses", count(keys) - count(values));
+        }
+
+        for key in keys {
+            if !fetch value, values[this->getPrefixedKey(key)] {
+                let value = false;
+            }
+
+            let results[key] = this->getUnserializedData(value, defaultValue);
+        }
+
+        return results;
+    }
+
     /**
      * Checks if an element exists in the cache
      *
@@ -156,7 +294,19 @@ class Apcu extends AbstractAdapter
      */
     public function has(string! key) -> bool
     {
-        return apcu_exists(this->getPrefixedKey(key));
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = apcu_exists(this->getPrefixedKey(key));
+
+        if unlikely this->metrics !== null {
+            this->measure("has", key, start);
+        }
+
+        return result;
     }
 
     /**
@@ -184,10 +334,59 @@ class Apcu extends AbstractAdapter
      */
     public function set(string! key, var value, var ttl = null) -> bool
     {
-        return apcu_store(
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = apcu_store(
             this->getPrefixedKey(key),
             this->getSerializedData(value),
             this->getTtl(ttl)
         );
+
+        if unlikely this->metrics !== null {
+            this->measure("set", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Stores several key => value pairs with a single apcu_store() call
+     *
+     * @param array $values
+     * @param null  $ttl
+     *
+     * @return bool
+     */
+    public function setMultiple(array! values, var ttl = null) -> bool
+    {
+        var failed, key, start, value;
+        array items;
+
+        if empty values {
+            return true;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let items = [];
+
+        for key, value in values {
+            let items[this->getPrefixedKey(key)] = this->getSerializedData(value);
+        }
+
+        let failed = apcu_store(items, null, this->getTtl(ttl));
+
+        if unlikely this->metrics !== null {
+            this->measure("setMultiple", current(array_keys(values)), start);
+            this->metrics->increment("sets", count(values));
+        }
+
+        return typeof failed == "array" && count(failed) === 0;
     }
 }
@@ -51,6 +51,37 @@ class Libmemcached extends AbstractAdapter
         parent::__construct(factory, options);
     }
 
+    /**
+     * Stores data in the adapter only if the key does not exist yet
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = this->getAdapter()->add(
+            key,
+            this->getSerializedData(value),
+            this->getTtl(ttl)
+        );
+
+        if unlikely this->metrics !== null {
+            this->measure("add", key, start);
+        }
+
+        return result;
+    }
+
     /**
      * Flushes/clears the cache
      *
@@ -80,7 +111,59 @@ class Libmemcached extends AbstractAdapter
      */
     public function delete(string! key) -> bool
     {
-        return this->getAdapter()->delete(key, 0);
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = this->getAdapter()->delete(key, 0);
+
+        if unlikely this->metrics !== null {
+            this->measure("delete", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Deletes several keys with a single deleteMulti() call
+     *
+     * @param array $keys
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function deleteMultiple(array! keys) -> bool
+    {
+        var result, results, start;
+
+        if empty keys {
+            return true;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let results = this->getAdapter()->deleteMulti(array_values(keys), 0);
+
+        if unlikely this->metrics !== null {
+            this->measure("deleteMultiple", current(keys), start);
+            this->metrics->increment("deletes", count(keys));
+        }
+
+        if typeof results != "array" {
+            return false;
+        }
+
+        for result in results {
+            if result !== true {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     /**
@@ -94,10 +177,19 @@ class Libmemcached extends AbstractAdapter
      */
     public function get(string! key, var defaultValue = null) -> var
     {
-        return this->getUnserializedData(
-            this->getAdapter()->get(key),
-            defaultValue
-        );
+        var content, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let content = this->getAdapter()->get(key);
+
+        if unlikely this->metrics !== null {
+            this->measure("get", key, start, content !== false);
+        }
+
+        return this->getUnserializedData(content, defaultValue);
     }
 
     /**
@@ -164,6 +256,53 @@ class Libmemcached extends AbstractAdapter
         return !keys ? [] : keys;
     }
 
+    /**
+     * Reads several keys with a single getMulti() call
+     *
+     * @param array $keys
+     * @param null  $defaultValue
+     *
+     * @return array
+     * @throws Exception
+     */
+    public function getMultiple(array! keys, var defaultValue = null) -> array
+    {
+        var key, start, value, values;
+        array results;
+
+        let results = [];
+
+        if empty keys {
+            return results;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let values = this->getAdapter()->getMulti(array_values(keys));
+
+        if typeof values != "array" {
+            let values = [];
+        }
+
+        if unlikely this->metrics !== null {
+            this->measure("getMultiple", current(keys), start);
+            this->metrics->increment("hits", count(values));
+            this->metrics->increment("misses", count(keys) - count(values));
+        }
+
+        for key in keys {
+            if !fetch value, values[key] {
+                let value = false;
+            }
+
+            let results[key] = this->getUnserializedData(value, defaultValue);
+        }
+
+        return results;
+    }
+
     /**
      * Checks if an element exists in the cache
      *
@@ -174,12 +313,23 @@ class Libmemcached extends AbstractAdapter
      */
     public function has(string! key) -> bool
     {
-        var connection, result;
+        var connection, result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let connection = this->getAdapter();
+
+        connection->get(key);
 
-        let connection = this->getAdapter(),
-            result     = connection->get(key);
+        let result = \Memcached::RES_NOTFOUND !== connection->getResultCode();
 
-        return \Memcached::RES_NOTFOUND !== connection->getResultCode();
+        if unlikely this->metrics !== null {
+            this->measure("has", key, start);
+        }
+
+        return result;
     }
 
     /**
@@ -208,11 +358,61 @@ class Libmemcached extends AbstractAdapter
      */
     public function set(string! key, var value, var ttl = null) -> bool
     {
-        return this->getAdapter()->set(
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = this->getAdapter()->set(
             key,
             this->getSerializedData(value),
             this->getTtl(ttl)
         );
+
+        if unlikely this->metrics !== null {
+            this->measure("set", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Stores several key => value pairs with a single setMulti() call
+     *
+     * @param array $values
+     * @param null  $ttl
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function setMultiple(array! values, var ttl = null) -> bool
+    {
+        var key, result, start, value;
+        array items;
+
+        if empty values {
+            return true;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let items = [];
+
+        for key, value in values {
+            let items[key] = this->getSerializedData(value);
+        }
+
+        let result = this->getAdapter()->setMulti(items, this->getTtl(ttl));
+
+        if unlikely this->metrics !== null {
+            this->measure("setMultiple", current(array_keys(values)), start);
+            this->metrics->increment("sets", count(values));
+        }
+
+        return result;
     }
 
     /**
@@ -234,7 +434,11 @@ class Libmemcached extends AbstractAdapter
 
         let serializer = strtolower(this->defaultSerializer);
 
-        if isset map[serializer] {
+        /**
+         * The native serializers do not go through a compressing
+         * serializer factory
+         */
+        if isset map[serializer] && !(this->serializerFactory && this->serializerFactory->hasCompression()) {
             let this->defaultSerializer = "";
             connection->setOption(\Memcached::OPT_SERIALIZER, map[serializer]);
         } else {
@@ -51,6 +51,24 @@ class Memory extends AbstractAdapter
         this->initSerializer();
     }
 
+    /**
+     * Stores data in the adapter only if the key does not exist yet
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        if this->has(key) {
+            return false;
+        }
+
+        return this->set(key, value, ttl);
+    }
+
     /**
      * Flushes/clears the cache
      */
@@ -96,13 +114,21 @@ class Memory extends AbstractAdapter
      */
     public function delete(string! key) -> bool
     {
-        var exists, prefixedKey;
+        var exists, prefixedKey, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
 
         let prefixedKey = this->getPrefixedKey(key),
             exists      = this->data->has(prefixedKey);
 
         this->data->remove(prefixedKey);
 
+        if unlikely this->metrics !== null {
+            this->measure("delete", key, start);
+        }
+
         return exists;
     }
 
@@ -116,11 +142,19 @@ class Memory extends AbstractAdapter
      */
     public function get(string! key, var defaultValue = null) -> var
     {
-        var content, prefixedKey;
+        var content, prefixedKey, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
 
         let prefixedKey = this->getPrefixedKey(key),
             content     = this->data->get(prefixedKey);
 
+        if unlikely this->metrics !== null {
+            this->measure("get", key, start, content !== null);
+        }
+
         return this->getUnserializedData(content, defaultValue);
     }
 
@@ -154,11 +188,20 @@ class Memory extends AbstractAdapter
      */
     public function has(string! key) -> bool
     {
-        var prefixedKey;
+        var prefixedKey, result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let prefixedKey = this->getPrefixedKey(key),
+            result      = this->data->has(prefixedKey);
 
-        let prefixedKey = this->getPrefixedKey(key);
+        if unlikely this->metrics !== null {
+            this->measure("has", key, start);
+        }
 
-        return this->data->has(prefixedKey);
+        return result;
     }
 
     /**
@@ -198,7 +241,11 @@ class Memory extends AbstractAdapter
      */
     public function set(string! key, var value, var ttl = null) -> bool
     {
-        var content, lifetime, prefixedKey;
+        var content, lifetime, prefixedKey, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
 
         let content     = this->getSerializedData(value),
             lifetime    = this->getTtl(ttl),
@@ -206,6 +253,10 @@ class Memory extends AbstractAdapter
 
         this->data->set(prefixedKey, content);
 
+        if unlikely this->metrics !== null {
+            this->measure("set", key, start);
+        }
+
         return true;
     }
 }
@@ -49,14 +49,91 @@ class Redis extends AbstractAdapter
     }
 
     /**
-     * Flushes/clears the cache
+     * Stores data in the adapter only if the key does not exist yet
+     * (SET NX PX). Like set(), a TTL of zero or less stores the key without
+     * expiration
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        var lifetime, options, result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let lifetime = this->getTtl(ttl),
+            options  = ["nx"];
+
+        /**
+         * PX rejects a zero or negative expiration
+         */
+        if lifetime > 0 {
+            let options["px"] = lifetime * 1000;
+        }
+
+        let result = (bool) this->getAdapter()->set(
+            key,
+            this->getSerializedData(value),
+            options
+        );
+
+        if unlikely this->metrics !== null {
+            this->measure("add", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Flushes/clears the keys of the prefix. They are enumerated with SCAN
+     * and removed with UNLINK, one page at a time, so the server is never
+     * blocked and the keys of other prefixes are kept. Without a prefix the
+     * database is flushed
      *
      * @return bool
      * @throws Exception
      */
     public function clear() -> bool
     {
-        return this->getAdapter()->flushDB();
+        var connection, cursor, page;
+
+        let connection = this->getAdapter();
+
+        if this->prefix === "" {
+            return connection->flushDB();
+        }
+
+        let cursor = "0";
+
+        loop {
+            let page = this->scan(cursor);
+
+            if page === false {
+                return false;
+            }
+
+            let cursor = page[0];
+
+            if !empty page[1] {
+                call_user_func_array(
+                    [connection, "rawCommand"],
+                    array_merge(["UNLINK"], page[1])
+                );
+            }
+
+            if cursor === "0" {
+                break;
+            }
+        }
+
+        return true;
     }
 
     /**
@@ -83,7 +160,49 @@ class Redis extends AbstractAdapter
      */
     public function delete(string! key) -> bool
     {
-        return (bool) this->getAdapter()->delete(key);
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = (bool) this->getAdapter()->delete(key);
+
+        if unlikely this->metrics !== null {
+            this->measure("delete", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Deletes several keys with a single DEL command
+     *
+     * @param array $keys
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function deleteMultiple(array! keys) -> bool
+    {
+        var result, start;
+
+        if empty keys {
+            return true;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = this->getAdapter()->del(array_values(keys)) == count(array_unique(keys));
+
+        if unlikely this->metrics !== null {
+            this->measure("deleteMultiple", current(keys), start);
+            this->metrics->increment("deletes", count(keys));
+        }
+
+        return result;
     }
 
     /**
@@ -97,10 +216,19 @@ class Redis extends AbstractAdapter
      */
     public function get(string! key, var defaultValue = null) -> var
     {
-        return this->getUnserializedData(
-            this->getAdapter()->get(key),
-            defaultValue
-        );
+        var content, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let content = this->getAdapter()->get(key);
+
+        if unlikely this->metrics !== null {
+            this->measure("get", key, start, content !== false);
+        }
+
+        return this->getUnserializedData(content, defaultValue);
     }
 
     /**
@@ -151,14 +279,82 @@ class Redis extends AbstractAdapter
     }
 
     /**
-     * Stores data in the adapter
+     * Returns the keys of the prefix, enumerated with SCAN instead of KEYS so
+     * that the server is not blocked on large keyspaces
      *
      * @return array
      * @throws Exception
      */
     public function getKeys() -> array
     {
-        return this->getAdapter()->getKeys("*");
+        var cursor, page;
+        array keys;
+
+        let keys   = [],
+            cursor = "0";
+
+        loop {
+            let page = this->scan(cursor);
+
+            if page === false {
+                break;
+            }
+
+            let cursor = page[0],
+                keys   = array_merge(keys, page[1]);
+
+            if cursor === "0" {
+                break;
+            }
+        }
+
+        return keys;
+    }
+
+    /**
+     * Reads several keys with a single MGET command
+     *
+     * @param array $keys
+     * @param null  $defaultValue
+     *
+     * @return array
+     * @throws Exception
+     */
+    public function getMultiple(array! keys, var defaultValue = null) -> array
+    {
+        var index, key, start, value, values;
+        array results;
+
+        let results = [];
+
+        if empty keys {
+            return results;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let keys   = array_values(keys),
+            values = this->getAdapter()->mget(keys);
+
+        if unlikely this->metrics !== null {
+            this->measure("getMultiple", keys[0], start);
+        }
+
+        for index, key in keys {
+            if !fetch value, values[index] {
+                let value = false;
+            }
+
+            if unlikely this->metrics !== null {
+                this->metrics->increment(value === false ? "misses" : "hits");
+            }
+
+            let results[key] = this->getUnserializedData(value, defaultValue);
+        }
+
+        return results;
     }
 
     /**
@@ -171,7 +367,19 @@ class Redis extends AbstractAdapter
      */
     public function has(string! key) -> bool
     {
-        return (bool) this->getAdapter()->exists($key);
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = (bool) this->getAdapter()->exists($key);
+
+        if unlikely this->metrics !== null {
+            this->measure("has", key, start);
+        }
+
+        return result;
     }
 
     /**
@@ -200,11 +408,109 @@ class Redis extends AbstractAdapter
      */
     public function set(string! key, var value, var ttl = null) -> bool
     {
-        return this->getAdapter()->set(
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = this->getAdapter()->set(
             key,
             this->getSerializedData(value),
             this->getTtl(ttl)
         );
+
+        if unlikely this->metrics !== null {
+            this->measure("set", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Stores several key => value pairs, sending all the SET commands in one
+     * pipeline
+     *
+     * @param array $values
+     * @param null  $ttl
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function setMultiple(array! values, var ttl = null) -> bool
+    {
+        var connection, key, lifetime, result, results, start, value;
+
+        if empty values {
+            return true;
+        }
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let connection = this->getAdapter(),
+            lifetime   = this->getTtl(ttl);
+
+        connection->multi(\Redis::PIPELINE);
+
+        for key, value in values {
+            connection->set(
+                (string) key,
+                this->getSerializedData(value),
+                lifetime
+            );
+        }
+
+        let results = connection->exec();
+
+        if unlikely this->metrics !== null {
+            this->measure("setMultiple", current(array_keys(values)), start);
+            this->metrics->increment("sets", count(values));
+        }
+
+        if typeof results != "array" {
+            return false;
+        }
+
+        for result in results {
+            if !result {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Returns a page of keys of the prefix: [next cursor, keys]. The keys
+     * include the prefix
+     */
+    protected function scan(string cursor) -> array | bool
+    {
+        var result, scanCount;
+
+        if !fetch scanCount, this->options["scanCount"] {
+            let scanCount = 1000;
+        }
+
+        let result = this->getAdapter()->rawCommand(
+            "SCAN",
+            cursor,
+            "MATCH",
+            addcslashes(this->prefix, "*?[]\\") . "*",
+            "COUNT",
+            scanCount
+        );
+
+        if typeof result != "array" || count(result) !== 2 {
+            return false;
+        }
+
+        return [
+            (string) result[0],
+            typeof result[1] == "array" ? result[1] : []
+        ];
     }
 
     /**
@@ -237,7 +543,11 @@ class Redis extends AbstractAdapter
 
         let serializer = strtolower(this->defaultSerializer);
 
-        if isset map[serializer] {
+        /**
+         * The native serializers do not go through a compressing
+         * serializer factory
+         */
+        if isset map[serializer] && !(this->serializerFactory && this->serializerFactory->hasCompression()) {
             let this->defaultSerializer = "";
             connection->setOption(\Redis::OPT_SERIALIZER, map[serializer]);
         } else {
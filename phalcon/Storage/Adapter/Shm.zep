@@ -0,0 +1,307 @@
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Storage\Adapter;
+
+use Phalcon\Helper\Arr;
+use Phalcon\Storage\Adapter\AbstractAdapter;
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\SerializerFactory;
+
+/**
+ * Phalcon\Storage\Adapter\Shm
+ *
+ * Shared memory adapter
+ *
+ * Stores the items in a hash table kept in a file mapped in memory by every
+ * process using the same file, so the cache is shared by the FPM workers and
+ * the CLI scripts of a host without any extension or server. Reads do not
+ * take any lock; writes only lock the bucket of the key. When the memory is
+ * full the least recently read items are evicted. The locks of a process
+ * that died are taken over, dropping the items of the buckets it was
+ * writing, so the processes sharing a file must see each other's pids (the
+ * same pid namespace).
+ *
+ * Integers are stored as they are, so increment() and decrement() are
+ * atomic; other values are stored serialized. A key and its serialized value
+ * can not be bigger than 1MB. The "size" option (in bytes, 4MB minimum) is
+ * only used when the file is created.
+ *
+ * Not available on Windows.
+ *
+ *<code>
+ * $adapter = new \Phalcon\Storage\Adapter\Shm(
+ *     $serializerFactory,
+ *     [
+ *         "file" => "/dev/shm/app.cache",
+ *         "size" => 64 * 1024 * 1024,
+ *     ]
+ * );
+ *</code>
+ */
+class Shm extends AbstractAdapter
+{
+    /**
+     * Handle of the mapped file
+     *
+     * @var int
+     */
+    protected handle;
+
+    /**
+     * @var array
+     */
+    protected options = [];
+
+    /**
+     * Constructor
+     *
+     * @throws Exception
+     */
+    public function __construct(<SerializerFactory> factory = null, array! options = [])
+    {
+        var file, handle, size;
+
+        let file   = Arr::get(options, "file", sys_get_temp_dir() . "/phalcon-shm.cache"),
+            size   = (int) Arr::get(options, "size", 67108864),
+            handle = phalcon_shm_open(file, size);
+
+        if unlikely handle === false {
+            throw new Exception("The shared memory file '" . file . "' could not be opened");
+        }
+
+        /**
+         * Lets set some defaults and options here
+         */
+        let this->handle  = handle,
+            this->prefix  = "ph-shm-",
+            this->options = options;
+
+        parent::__construct(factory, options);
+
+        this->initSerializer();
+    }
+
+    /**
+     * Stores data in the adapter only if the key does not exist yet
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        var content, lifetime, result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let content  = this->getStoredData(value),
+            lifetime = this->getTtl(ttl),
+            result   = phalcon_shm_add(this->handle, this->getPrefixedKey(key), content, lifetime);
+
+        if unlikely this->metrics !== null {
+            this->measure("add", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Flushes/clears the cache. Only the keys with the prefix of the adapter
+     * are deleted, unless the prefix is empty
+     */
+    public function clear() -> bool
+    {
+        return phalcon_shm_clear(this->handle, this->prefix);
+    }
+
+    /**
+     * Decrements a stored number
+     *
+     * @param string $key
+     * @param int    $value
+     *
+     * @return bool|int
+     */
+    public function decrement(string! key, int value = 1) -> int | bool
+    {
+        var step;
+
+        let step = -value;
+
+        return phalcon_shm_increment(this->handle, this->getPrefixedKey(key), step);
+    }
+
+    /**
+     * Reads data from the adapter
+     *
+     * @param string $key
+     *
+     * @return bool
+     */
+    public function delete(string! key) -> bool
+    {
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = phalcon_shm_delete(this->handle, this->getPrefixedKey(key));
+
+        if unlikely this->metrics !== null {
+            this->measure("delete", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Reads data from the adapter
+     *
+     * @param string $key
+     * @param null   $defaultValue
+     *
+     * @return mixed
+     */
+    public function get(string! key, var defaultValue = null) -> var
+    {
+        var content, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let content = phalcon_shm_get(this->handle, this->getPrefixedKey(key));
+
+        if unlikely this->metrics !== null {
+            this->measure("get", key, start, content !== null);
+        }
+
+        if content === null {
+            return defaultValue;
+        }
+
+        if typeof content == "integer" {
+            return content;
+        }
+
+        return this->getUnserializedData(content, defaultValue);
+    }
+
+    /**
+     * Returns the handle of the mapped file
+     *
+     * @return int
+     */
+    public function getAdapter() -> var
+    {
+        return this->handle;
+    }
+
+    /**
+     * Stores data in the adapter
+     *
+     * @return array
+     */
+    public function getKeys() -> array
+    {
+        var keys;
+
+        let keys = phalcon_shm_keys(this->handle, this->prefix);
+
+        return keys;
+    }
+
+    /**
+     * Checks if an element exists in the cache
+     *
+     * @param string $key
+     *
+     * @return bool
+     */
+    public function has(string! key) -> bool
+    {
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let result = phalcon_shm_has(this->handle, this->getPrefixedKey(key));
+
+        if unlikely this->metrics !== null {
+            this->measure("has", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Increments a stored number
+     *
+     * @param string $key
+     * @param int    $value
+     *
+     * @return bool|int
+     */
+    public function increment(string! key, int value = 1) -> int | bool
+    {
+        var step;
+
+        let step = value;
+
+        return phalcon_shm_increment(this->handle, this->getPrefixedKey(key), step);
+    }
+
+    /**
+     * Stores data in the adapter
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function set(string! key, var value, var ttl = null) -> bool
+    {
+        var content, lifetime, result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let content  = this->getStoredData(value),
+            lifetime = this->getTtl(ttl),
+            result   = phalcon_shm_set(this->handle, this->getPrefixedKey(key), content, lifetime);
+
+        if unlikely this->metrics !== null {
+            this->measure("set", key, start);
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the value to store: integers as they are, so they can be
+     * incremented, the serialized data otherwise
+     */
+    private function getStoredData(var value) -> var
+    {
+        if typeof value == "integer" {
+            return value;
+        }
+
+        return this->getSerializedData(value);
+    }
+}
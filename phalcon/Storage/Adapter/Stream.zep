@@ -1,4 +1,3 @@
-
 /**
  * This file is part of the Phalcon Framework.
  *
@@ -10,25 +9,63 @@
 
 namespace Phalcon\Storage\Adapter;
 
+use FilesystemIterator;
 use Phalcon\Helper\Arr;
 use Phalcon\Helper\Str;
 use Phalcon\Storage\Adapter\AbstractAdapter;
 use Phalcon\Storage\Exception;
 use Phalcon\Storage\SerializerFactory;
 use Phalcon\Storage\Serializer\SerializerInterface;
+use RecursiveDirectoryIterator;
+use RecursiveIteratorIterator;
 
 /**
  * Phalcon\Storage\Adapter\Stream
  *
  * Stream adapter
+ *
+ * Every key is stored in its own file, starting with an 8 bytes header (a
+ * signature and the expiry timestamp) followed by the serialized data, so
+ * has() only reads the header. Files are written to a temporary file and
+ * renamed, so readers never see a partially written item. increment(),
+ * decrement() and add() hold an flock() on a lock file next to the item,
+ * which is removed when the lock is released.
+ *
+ * With the "format" option set to "php", items are stored as PHP files
+ * returning the expiry and the value, which opcache keeps in shared memory.
+ * This suits data that is read often and rarely written. The values must be
+ * exportable with var_export(); the serializer is not used. These files have
+ * a ".php" suffix, so the items of the binary format are never run, and a
+ * file is only included when it starts with "<?php return".
+ *
+ *<code>
+ * $adapter = new \Phalcon\Storage\Adapter\Stream(
+ *     $serializerFactory,
+ *     [
+ *         "cacheDir" => "app/cache/",
+ *         "format"   => "php",
+ *     ]
+ * );
+ *</code>
  */
 class Stream extends AbstractAdapter
 {
+    const PHP_SIGNATURE = "<?php return ";
+    const PHP_SUFFIX    = ".php";
+    const SIGNATURE     = "PHS1";
+
     /**
     * @var string
     */
     protected cacheDir = "";
 
+    /**
+     * Store the items as PHP files
+     *
+     * @var bool
+     */
+    protected phpFiles = false;
+
     /**
      * @var array
      */
@@ -43,17 +80,24 @@ class Stream extends AbstractAdapter
      */
     public function __construct(<SerializerFactory> factory = null, array! options = [])
     {
-        var cacheDir;
+        var cacheDir, format;
 
         let cacheDir = Arr::get(options, "cacheDir", "");
         if empty cacheDir {
             throw new Exception("The 'cacheDir' must be specified in the options");
         }
 
+        let format = Arr::get(options, "format", "binary");
+
+        if unlikely format !== "binary" && format !== "php" {
+            throw new Exception("The 'format' must be 'binary' or 'php'");
+        }
+
         /**
          * Lets set some defaults and options here
          */
         let this->cacheDir = Str::dirSeparator(cacheDir),
+            this->phpFiles = format === "php",
             this->prefix   = "phstrm-",
             this->options  = options;
 
@@ -62,19 +106,60 @@ class Stream extends AbstractAdapter
         this->initSerializer();
     }
 
+    /**
+     * Stores data in the adapter only if the key does not exist yet or has
+     * expired. The check and the write happen while holding the lock of the
+     * key
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        var filepath, handle, start;
+        bool result;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
+
+        let filepath = this->getFilepath(key),
+            handle   = this->lock(filepath);
+
+        if handle === false {
+            return false;
+        }
+
+        let result = false;
+
+        if this->readPayload(filepath) === null {
+            let result = this->writePayload(filepath, value, ttl);
+        }
+
+        this->unlock(handle, filepath);
+
+        if unlikely this->metrics !== null {
+            this->measure("add", key, start);
+        }
+
+        return result;
+    }
+
     /**
      * Flushes/clears the cache
      */
     public function clear() -> bool
     {
-        var directory, iterator, file, result;
+        var file;
+        bool result;
 
-        let result    = true,
-            directory = Str::dirSeparator(this->cacheDir),
-            iterator  = this->rglob(directory . "/*");
+        let result = true;
 
-        for file in iterator {
-            if !is_dir(file) && !unlink(file) {
+        for file in this->getFiles(true) {
+            if !unlink(file->getPathname()) {
                 let result = false;
             }
         }
@@ -93,16 +178,7 @@ class Stream extends AbstractAdapter
      */
     public function decrement(string! key, int value = 1) -> int | bool
     {
-        var data;
-
-        if !this->has(key) {
-            return false;
-        }
-
-        let data = this->get(key),
-            data = (int) data - value;
-
-        return this->set(key, data);
+        return this->updateCounter(key, -value);
     }
 
     /**
@@ -114,15 +190,20 @@ class Stream extends AbstractAdapter
      */
     public function delete(string! key) -> bool
     {
-        var directory;
+        var filepath, result, start;
 
-        if !this->has(key) {
-            return false;
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
         }
 
-        let directory = this->getDir(key);
+        let filepath = this->getFilepath(key),
+            result   = is_file(filepath) && unlink(filepath);
+
+        if unlikely this->metrics !== null {
+            this->measure("delete", key, start);
+        }
 
-        return unlink(directory . key);
+        return result;
     }
 
     /**
@@ -135,28 +216,29 @@ class Stream extends AbstractAdapter
      */
     public function get(string! key, var defaultValue = null) -> var
     {
-        var content, directory, payload;
+        var payload, start;
 
-        let directory = this->getDir(key);
-	
-        if !file_exists(directory . key) {
-            return defaultValue;
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
         }
-	
-        let payload   = file_get_contents(directory . key),
-            payload = json_decode(payload, true);
 
-        if json_last_error() !== JSON_ERROR_NONE {
-            return defaultValue;
+        let payload = this->readPayload(
+            this->getFilepath(key)
+        );
+
+        if unlikely this->metrics !== null {
+            this->measure("get", key, start, payload !== null);
         }
 
-        if this->isExpired(payload) {
+        if payload === null {
             return defaultValue;
         }
 
-        let content = Arr::get(payload, "content", null);
+        if this->phpFiles {
+            return payload[1];
+        }
 
-        return this->getUnserializedData(content, defaultValue);
+        return this->getUnserializedData(payload[1], defaultValue);
     }
 
     /**
@@ -173,24 +255,31 @@ class Stream extends AbstractAdapter
      */
     public function getKeys() -> array
     {
-        var directory, iterator, file, split, results;
+        var file, name;
+        array results;
 
-        let results   = [],
-            directory = Str::dirSeparator(this->cacheDir),
-            iterator  = this->rglob(directory . "/*");
+        let results = [];
 
-        for file in iterator {
-            if !is_dir(file) {
-                let split     = explode("/", file),
-                    results[] = this->prefix . Arr::last(split);
+        for file in this->getFiles() {
+            let name = file->getFilename();
+
+            if this->phpFiles {
+                if !Str::endsWith(name, self::PHP_SUFFIX) {
+                    continue;
+                }
+
+                let name = substr(name, 0, -strlen(self::PHP_SUFFIX));
             }
+
+            let results[] = this->prefix . name;
         }
 
         return results;
     }
 
     /**
-     * Checks if an element exists in the cache and is not expired
+     * Checks if an element exists in the cache and is not expired. Only the
+     * header of the file is read
      *
      * @param string $key
      *
@@ -198,19 +287,34 @@ class Stream extends AbstractAdapter
      */
     public function has(string! key) -> bool
     {
-        var directory, exists, payload;
+        var filepath, handle, header, start;
+        bool result;
 
-        let directory = this->getDir(key),
-            exists    = file_exists(directory . key);
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
 
-        if !exists {
-            return false;
+        let filepath = this->getFilepath(key),
+            result   = false;
+
+        if this->phpFiles {
+            let result = this->readPayload(filepath) !== null;
+        } elseif is_file(filepath) {
+            let handle = fopen(filepath, "rb");
+
+            if handle !== false {
+                let header = fread(handle, 8),
+                    result = this->getHeaderExpiry(header) !== null;
+
+                fclose(handle);
+            }
         }
 
-        let payload = file_get_contents(directory . key),
-            payload = json_decode(payload);
+        if unlikely this->metrics !== null {
+            this->measure("has", key, start);
+        }
 
-        return !this->isExpired(payload);
+        return result;
     }
 
     /**
@@ -224,16 +328,7 @@ class Stream extends AbstractAdapter
      */
     public function increment(string! key, int value = 1) -> int | bool
     {
-        var data;
-
-        if !this->has(key) {
-            return false;
-        }
-
-        let data = this->get(key),
-            data = (int) data + value;
-
-        return this->set(key, data);
+        return this->updateCounter(key, value);
     }
 
     /**
@@ -248,22 +343,23 @@ class Stream extends AbstractAdapter
      */
     public function set(string! key, var value, var ttl = null) -> bool
     {
-        var directory;
-        array payload;
+        var result, start;
+
+        if unlikely this->metrics !== null {
+            let start = microtime(true);
+        }
 
-        let payload   = [
-                "created" : time(),
-                "ttl"     : this->getTtl(ttl),
-                "content" : this->getSerializedData(value)
-            ],
-            payload   = json_encode(payload),
-            directory = this->getDir(key);
+        let result = this->writePayload(
+            this->getFilepath(key),
+            value,
+            ttl
+        );
 
-        if !is_dir(directory) {
-            mkdir(directory, 0777, true);
+        if unlikely this->metrics !== null {
+            this->measure("set", key, start);
         }
 
-        return false !== file_put_contents(directory . key, payload);
+        return result;
     }
 
     /**
@@ -284,41 +380,245 @@ class Stream extends AbstractAdapter
     }
 
     /**
-     * Returns if the cache has expired for this item or not
-     *
-     * @param array $payload
-     *
-     * @return bool
+     * Returns the file of a key
+     */
+    private function getFilepath(string! key) -> string
+    {
+        if this->phpFiles {
+            return this->getDir(key) . key . self::PHP_SUFFIX;
+        }
+
+        return this->getDir(key) . key;
+    }
+
+    /**
+     * Returns the item files, with the temporary and the lock files if
+     * requested
      */
-    private function isExpired(array! payload) -> bool
+    private function getFiles(bool all = false) -> array
     {
-        var created, ttl;
+        var directory, file, iterator, name;
+        array files;
 
-        let created = Arr::get(payload, "created", time()),
-            ttl     = Arr::get(payload, "ttl", 3600);
+        let files     = [],
+            directory = Str::dirSeparator(this->cacheDir . this->prefix);
 
-        return (created + ttl) < time();
+        if !is_dir(directory) {
+            return files;
+        }
+
+        let iterator = new RecursiveIteratorIterator(
+            new RecursiveDirectoryIterator(directory, FilesystemIterator::SKIP_DOTS)
+        );
+
+        for file in iterator {
+            let name = file->getFilename();
+
+            if !file->isFile() {
+                continue;
+            }
+
+            if all || (!Str::endsWith(name, ".tmp") && !Str::endsWith(name, ".lock")) {
+                let files[] = file;
+            }
+        }
+
+        return files;
     }
 
     /**
-     * @param string $pattern
+     * Returns the expiry stored in a binary header, or null if the header is
+     * invalid or the item expired
+     */
+    private function getHeaderExpiry(var header) -> int | null
+    {
+        var expires;
+
+        if typeof header != "string" || strlen(header) < 8 || substr(header, 0, 4) !== self::SIGNATURE {
+            return null;
+        }
+
+        let expires = unpack("N", header, 4);
+
+        if expires[1] < time() {
+            return null;
+        }
+
+        return expires[1];
+    }
+
+    /**
+     * Acquires the exclusive lock of an item. The lock file is removed when
+     * the lock is released, so the lock is only held once the file locked is
+     * still the one at the path
      *
-     * @return array
+     * @return resource|bool
      */
-    private function rglob(string! pattern) -> array
+    private function lock(string! filepath) -> var
     {
-        var dir, dirName, files, flags, recurse;
+        var directory, handle, lockPath, stat;
 
-        let dirName = dirname(pattern) . "/*",
-            files   = glob(pattern),
-            flags   = GLOB_ONLYDIR | GLOB_NOSORT;
+        let directory = dirname(filepath),
+            lockPath  = filepath . ".lock";
 
-        for dir in glob(dirName, flags) {
-            let dir     = dir . "/" . basename(pattern),
-                recurse = this->rglob(dir),
-                files   = array_merge(files, recurse);
+        if !is_dir(directory) {
+            mkdir(directory, 0777, true);
         }
 
-        return files;
+        loop {
+            let handle = fopen(lockPath, "c");
+
+            if handle === false {
+                return false;
+            }
+
+            if !flock(handle, LOCK_EX) {
+                fclose(handle);
+
+                return false;
+            }
+
+            clearstatcache(true, lockPath);
+
+            if is_file(lockPath) {
+                let stat = fstat(handle);
+
+                if stat["ino"] === fileinode(lockPath) {
+                    return handle;
+                }
+            }
+
+            /**
+             * The file was removed by the previous holder: lock the new one
+             */
+            fclose(handle);
+        }
+    }
+
+    /**
+     * Reads an item. Returns [expiry, data], or null if it is missing,
+     * invalid or expired
+     */
+    private function readPayload(string! filepath) -> array | null
+    {
+        var expires, payload;
+
+        if !is_file(filepath) {
+            return null;
+        }
+
+        if this->phpFiles {
+            if file_get_contents(filepath, false, null, 0, strlen(self::PHP_SIGNATURE)) !== self::PHP_SIGNATURE {
+                return null;
+            }
+
+            let payload = require filepath;
+
+            if typeof payload != "array" || !isset payload[0] || payload[0] < time() {
+                return null;
+            }
+
+            return payload;
+        }
+
+        let payload = file_get_contents(filepath),
+            expires = this->getHeaderExpiry(payload);
+
+        if expires === null {
+            return null;
+        }
+
+        return [expires, substr(payload, 8)];
+    }
+
+    /**
+     * Releases the lock of an item, removing the lock file while it is held
+     */
+    private function unlock(var handle, string! filepath) -> void
+    {
+        unlink(filepath . ".lock");
+        flock(handle, LOCK_UN);
+        fclose(handle);
+    }
+
+    /**
+     * Adds a number to a stored number while holding its lock. The expiry of
+     * the item is kept
+     */
+    private function updateCounter(string! key, int value) -> int | bool
+    {
+        var current, filepath, handle, payload, result;
+
+        let filepath = this->getFilepath(key);
+
+        if !is_file(filepath) {
+            return false;
+        }
+
+        let handle = this->lock(filepath);
+
+        if handle === false {
+            return false;
+        }
+
+        let payload = this->readPayload(filepath);
+
+        if payload === null {
+            this->unlock(handle, filepath);
+
+            return false;
+        }
+
+        if this->phpFiles {
+            let current = payload[1];
+        } else {
+            let current = this->getUnserializedData(payload[1]);
+        }
+
+        let current = (int) current + value,
+            result  = this->writePayload(filepath, current, payload[0] - time());
+
+        this->unlock(handle, filepath);
+
+        return result ? current : false;
+    }
+
+    /**
+     * Writes an item to a temporary file and renames it
+     */
+    private function writePayload(string! filepath, var value, var ttl) -> bool
+    {
+        var directory, expires, payload, tempPath;
+
+        let directory = dirname(filepath),
+            expires   = time() + this->getTtl(ttl);
+
+        if !is_dir(directory) {
+            mkdir(directory, 0777, true);
+        }
+
+        if this->phpFiles {
+            let payload = self::PHP_SIGNATURE . var_export([expires, value], true) . ";";
+        } else {
+            let payload = self::SIGNATURE . pack("N", expires) . this->getSerializedData(value);
+        }
+
+        let tempPath = filepath . "." . bin2hex(random_bytes(6)) . ".tmp";
+
+        if file_put_contents(tempPath, payload) === false {
+            return false;
+        }
+
+        if !rename(tempPath, filepath) {
+            unlink(tempPath);
+
+            return false;
+        }
+
+        if this->phpFiles && function_exists("opcache_invalidate") {
+            opcache_invalidate(filepath, true);
+        }
+
+        return true;
     }
 }
@@ -0,0 +1,696 @@
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Storage\Adapter;
+
+use Phalcon\Helper\Arr;
+use Phalcon\Storage\Adapter\AbstractAdapter;
+use Phalcon\Storage\Adapter\AdapterInterface;
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\SerializerFactory;
+
+/**
+ * Phalcon\Storage\Adapter\Tiered
+ *
+ * Chains several adapters, from the fastest (in process) to the shared one.
+ * Reads go down the tiers until the key is found and copy the value back to
+ * the upper tiers. Writes go to every tier ("through") or only to the last
+ * one, removing the key from the upper tiers ("around"). Deletes are sent to
+ * every tier.
+ *
+ * The upper tiers are local to a server, so a key deleted or changed on
+ * another server is only seen there once it expires. Every upper tier needs
+ * a short lifetime in "lifetimes": a value copied up from a lower tier is
+ * kept for that lifetime, as the TTL left in the lower tier is not known.
+ * Set a "versionKey" too: the upper tiers then store the keys under a
+ * version kept in the last tier and read again every "versionInterval"
+ * seconds; invalidate() changes it, which drops the upper tiers everywhere.
+ *
+ * The Memory adapter ignores TTLs: its keys only go away when they are
+ * deleted, changed or the process ends. In long running workers it grows
+ * with every key read and serves the values it holds until a new version
+ * is read, so use it with a "versionKey" and invalidate() or clear() it
+ * regularly.
+ *
+ *<code>
+ * use Phalcon\Storage\Adapter\Apcu;
+ * use Phalcon\Storage\Adapter\Memory;
+ * use Phalcon\Storage\Adapter\Redis;
+ * use Phalcon\Storage\Adapter\Tiered;
+ * use Phalcon\Storage\SerializerFactory;
+ *
+ * $serializer = new SerializerFactory();
+ *
+ * $adapter = new Tiered(
+ *     $serializer,
+ *     [
+ *         "adapters"   => [
+ *             new Memory($serializer),
+ *             new Apcu($serializer),
+ *             new Redis($serializer),
+ *         ],
+ *         "lifetimes"  => [5, 60],
+ *         "versionKey" => "tiered-version",
+ *     ]
+ * );
+ *</code>
+ */
+class Tiered extends AbstractAdapter
+{
+    /**
+     * @var array
+     */
+    protected adapters = [];
+
+    /**
+     * Maximum lifetime of the keys in every tier
+     *
+     * @var array
+     */
+    protected lifetimes = [];
+
+    /**
+     * Returned by the tiers for missing keys
+     *
+     * @var object
+     */
+    protected missing;
+
+    /**
+     * @var array
+     */
+    protected options = [];
+
+    /**
+     * Version of the upper tiers
+     *
+     * @var string|null
+     */
+    protected version = null;
+
+    /**
+     * When the version was read from the last tier
+     *
+     * @var int
+     */
+    protected versionCheckedAt = 0;
+
+    /**
+     * Seconds between two reads of the version
+     *
+     * @var int
+     */
+    protected versionInterval = 1;
+
+    /**
+     * Key holding the version of the upper tiers in the last tier
+     *
+     * @var string|null
+     */
+    protected versionKey = null;
+
+    /**
+     * Lifetime of the version key
+     *
+     * @var int
+     */
+    protected versionLifetime = 2592000;
+
+    /**
+     * "through" or "around"
+     *
+     * @var string
+     */
+    protected writeMode = "through";
+
+    /**
+     * Constructor
+     *
+     * @throws Exception
+     */
+    public function __construct(<SerializerFactory> factory = null, array! options = [])
+    {
+        var adapter, adapters, index, lifetime, lifetimes, writeMode;
+
+        let adapters = Arr::get(options, "adapters", []);
+
+        if unlikely typeof adapters != "array" || count(adapters) < 1 {
+            throw new Exception("The 'adapters' must be specified in the options");
+        }
+
+        for adapter in adapters {
+            if unlikely typeof adapter != "object" || !(adapter instanceof AdapterInterface) {
+                throw new Exception(
+                    "The tiers must implement Phalcon\\Storage\\Adapter\\AdapterInterface"
+                );
+            }
+        }
+
+        /**
+         * A value copied to an upper tier is stored for the lifetime of that
+         * tier, whatever the TTL left in the tier it was read from, so every
+         * upper tier needs one
+         */
+        let adapters  = array_values(adapters),
+            lifetimes = Arr::get(options, "lifetimes", []);
+
+        if unlikely typeof lifetimes != "array" {
+            throw new Exception("The 'lifetimes' must be an array");
+        }
+
+        for index, adapter in adapters {
+            if index == count(adapters) - 1 {
+                break;
+            }
+
+            if !fetch lifetime, lifetimes[index] {
+                let lifetime = 0;
+            }
+
+            if unlikely (int) lifetime < 1 {
+                throw new Exception(
+                    "The 'lifetimes' must be set for every tier except the last one"
+                );
+            }
+        }
+
+        let writeMode = Arr::get(options, "writeMode", "through");
+
+        if unlikely writeMode !== "through" && writeMode !== "around" {
+            throw new Exception("The 'writeMode' must be 'through' or 'around'");
+        }
+
+        let this->adapters        = adapters,
+            this->lifetimes       = lifetimes,
+            this->missing         = new \stdClass(),
+            this->options         = options,
+            this->versionInterval = (int) Arr::get(options, "versionInterval", 1),
+            this->versionKey      = Arr::get(options, "versionKey", null),
+            this->versionLifetime = (int) Arr::get(options, "versionLifetime", 2592000),
+            this->writeMode       = writeMode;
+
+        parent::__construct(factory, options);
+    }
+
+    /**
+     * Stores data in the last tier only if the key does not exist there yet
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function add(string! key, var value, var ttl = null) -> bool
+    {
+        var last;
+
+        let last = count(this->adapters) - 1;
+
+        if !this->adapters[last]->add(this->getTierKey(last, key), value, ttl) {
+            return false;
+        }
+
+        this->deleteUpperTiers(last, key);
+
+        return true;
+    }
+
+    /**
+     * Flushes/clears every tier
+     */
+    public function clear() -> bool
+    {
+        var adapter;
+        bool result;
+
+        let result = true;
+
+        for adapter in this->adapters {
+            if !adapter->clear() {
+                let result = false;
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * Decrements a stored number in the last tier and removes it from the
+     * upper tiers
+     *
+     * @param string $key
+     * @param int    $value
+     *
+     * @return bool|int
+     */
+    public function decrement(string! key, int value = 1) -> int | bool
+    {
+        var last;
+
+        let last = count(this->adapters) - 1;
+
+        this->deleteUpperTiers(last, key);
+
+        return this->adapters[last]->decrement(this->getTierKey(last, key), value);
+    }
+
+    /**
+     * Deletes data from every tier
+     *
+     * @param string $key
+     *
+     * @return bool
+     */
+    public function delete(string! key) -> bool
+    {
+        var last;
+
+        let last = count(this->adapters) - 1;
+
+        this->deleteUpperTiers(last, key);
+
+        return this->adapters[last]->delete(this->getTierKey(last, key));
+    }
+
+    /**
+     * Deletes several keys from every tier
+     *
+     * @param array $keys
+     *
+     * @return bool
+     */
+    public function deleteMultiple(array! keys) -> bool
+    {
+        var index;
+        int last;
+
+        let last = count(this->adapters) - 1,
+            index = 0;
+
+        while index < last {
+            this->adapters[index]->deleteMultiple(
+                this->getTierKeys(index, keys)
+            );
+
+            let index++;
+        }
+
+        return this->adapters[last]->deleteMultiple(
+            this->getTierKeys(last, keys)
+        );
+    }
+
+    /**
+     * Reads data from the first tier holding the key, and copies it to the
+     * tiers above it for their lifetime
+     *
+     * @param string $key
+     * @param null   $defaultValue
+     *
+     * @return mixed
+     */
+    public function get(string! key, var defaultValue = null) -> var
+    {
+        var adapter, index, upper, value;
+
+        for index, adapter in this->adapters {
+            let value = adapter->get(
+                this->getTierKey(index, key),
+                this->missing
+            );
+
+            if value !== this->missing {
+                let upper = 0;
+
+                while upper < index {
+                    this->adapters[upper]->set(
+                        this->getTierKey(upper, key),
+                        value,
+                        this->getTierTtl(upper, null)
+                    );
+
+                    let upper++;
+                }
+
+                return value;
+            }
+        }
+
+        return defaultValue;
+    }
+
+    /**
+     * Returns the tiers
+     *
+     * @return array
+     */
+    public function getAdapter() -> var
+    {
+        return this->adapters;
+    }
+
+    /**
+     * Returns the keys of the last tier
+     *
+     * @return array
+     */
+    public function getKeys() -> array
+    {
+        return this->adapters[count(this->adapters) - 1]->getKeys();
+    }
+
+    /**
+     * Reads several keys, asking every tier only for the keys the tiers above
+     * it did not have, and copies them to the upper tiers
+     *
+     * @param array $keys
+     * @param null  $defaultValue
+     *
+     * @return array
+     */
+    public function getMultiple(array! keys, var defaultValue = null) -> array
+    {
+        var adapter, found, index, key, pending, upper, value, values;
+        array results;
+
+        let results = [],
+            pending = array_values(keys);
+
+        for index, adapter in this->adapters {
+            if empty pending {
+                break;
+            }
+
+            let values = adapter->getMultiple(
+                    this->getTierKeys(index, pending),
+                    this->missing
+                ),
+                found = [];
+
+            for key in pending {
+                if !fetch value, values[this->getTierKey(index, key)] {
+                    continue;
+                }
+
+                if value !== this->missing {
+                    let found[key]   = value,
+                        results[key] = value;
+                }
+            }
+
+            if empty found {
+                continue;
+            }
+
+            let upper = 0;
+
+            while upper < index {
+                this->adapters[upper]->setMultiple(
+                    this->getTierValues(upper, found),
+                    this->getTierTtl(upper, null)
+                );
+
+                let upper++;
+            }
+
+            let pending = array_values(
+                array_diff(pending, array_keys(found))
+            );
+        }
+
+        for key in pending {
+            let results[key] = defaultValue;
+        }
+
+        let values = [];
+
+        for key in keys {
+            let values[key] = results[key];
+        }
+
+        return values;
+    }
+
+    /**
+     * Checks if an element exists in any tier
+     *
+     * @param string $key
+     *
+     * @return bool
+     */
+    public function has(string! key) -> bool
+    {
+        var adapter, index;
+
+        for index, adapter in this->adapters {
+            if adapter->has(this->getTierKey(index, key)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Increments a stored number in the last tier and removes it from the
+     * upper tiers
+     *
+     * @param string $key
+     * @param int    $value
+     *
+     * @return bool|int
+     */
+    public function increment(string! key, int value = 1) -> int | bool
+    {
+        var last;
+
+        let last = count(this->adapters) - 1;
+
+        this->deleteUpperTiers(last, key);
+
+        return this->adapters[last]->increment(this->getTierKey(last, key), value);
+    }
+
+    /**
+     * Drops the upper tiers of every server by changing the version stored
+     * in the last tier. Requires the "versionKey" option
+     *
+     * @return bool
+     * @throws Exception
+     */
+    public function invalidate() -> bool
+    {
+        var last, version;
+
+        if unlikely this->versionKey === null {
+            throw new Exception("The 'versionKey' must be specified in the options");
+        }
+
+        let last    = count(this->adapters) - 1,
+            version = bin2hex(random_bytes(8));
+
+        if !this->adapters[last]->set(this->versionKey, version, this->versionLifetime) {
+            return false;
+        }
+
+        let this->version          = version,
+            this->versionCheckedAt = time();
+
+        return true;
+    }
+
+    /**
+     * Stores data in every tier, or in the last one only when the write mode
+     * is "around"
+     *
+     * @param string $key
+     * @param mixed  $value
+     * @param null   $ttl
+     *
+     * @return bool
+     */
+    public function set(string! key, var value, var ttl = null) -> bool
+    {
+        var index, last;
+
+        let last = count(this->adapters) - 1;
+
+        if this->writeMode === "around" {
+            this->deleteUpperTiers(last, key);
+        } else {
+            let index = 0;
+
+            while index < last {
+                this->adapters[index]->set(
+                    this->getTierKey(index, key),
+                    value,
+                    this->getTierTtl(index, ttl)
+                );
+
+                let index++;
+            }
+        }
+
+        return this->adapters[last]->set(
+            this->getTierKey(last, key),
+            value,
+            ttl
+        );
+    }
+
+    /**
+     * Stores several key => value pairs in every tier, or in the last one only
+     * when the write mode is "around"
+     *
+     * @param array $values
+     * @param null  $ttl
+     *
+     * @return bool
+     */
+    public function setMultiple(array! values, var ttl = null) -> bool
+    {
+        var index, last;
+
+        let last = count(this->adapters) - 1,
+            index = 0;
+
+        while index < last {
+            if this->writeMode === "around" {
+                this->adapters[index]->deleteMultiple(
+                    this->getTierKeys(index, array_keys(values))
+                );
+            } else {
+                this->adapters[index]->setMultiple(
+                    this->getTierValues(index, values),
+                    this->getTierTtl(index, ttl)
+                );
+            }
+
+            let index++;
+        }
+
+        return this->adapters[last]->setMultiple(
+            this->getTierValues(last, values),
+            ttl
+        );
+    }
+
+    /**
+     * Deletes a key from the tiers above the one given
+     */
+    protected function deleteUpperTiers(int tier, string! key) -> void
+    {
+        int index = 0;
+
+        while index < tier {
+            this->adapters[index]->delete(
+                this->getTierKey(index, key)
+            );
+
+            let index++;
+        }
+    }
+
+    /**
+     * Returns the key used in a tier: the upper tiers use the version of the
+     * last tier as namespace when a "versionKey" is set
+     */
+    protected function getTierKey(int tier, var key) -> string
+    {
+        let key = this->getPrefixedKey(key);
+
+        if this->versionKey === null || tier == count(this->adapters) - 1 {
+            return key;
+        }
+
+        return "v" . this->getVersion() . "-" . key;
+    }
+
+    /**
+     * Returns the keys used in a tier
+     */
+    protected function getTierKeys(int tier, array! keys) -> array
+    {
+        var key;
+        array results;
+
+        let results = [];
+
+        for key in keys {
+            let results[] = this->getTierKey(tier, key);
+        }
+
+        return results;
+    }
+
+    /**
+     * Returns the TTL for a tier, capped by its lifetime
+     */
+    protected function getTierTtl(int tier, var ttl) -> int
+    {
+        var lifetime;
+
+        let ttl = this->getTtl(ttl);
+
+        if fetch lifetime, this->lifetimes[tier] {
+            if lifetime !== null && (int) lifetime < ttl {
+                return (int) lifetime;
+            }
+        }
+
+        return ttl;
+    }
+
+    /**
+     * Returns key => value pairs with the keys used in a tier
+     */
+    protected function getTierValues(int tier, array! values) -> array
+    {
+        var key, value;
+        array results;
+
+        let results = [];
+
+        for key, value in values {
+            let results[this->getTierKey(tier, key)] = value;
+        }
+
+        return results;
+    }
+
+    /**
+     * Returns the version of the upper tiers, read from the last tier at most
+     * every "versionInterval" seconds. A missing version is created
+     */
+    protected function getVersion() -> string
+    {
+        var last, version;
+
+        if this->version !== null && time() - this->versionCheckedAt < this->versionInterval {
+            return this->version;
+        }
+
+        let last    = this->adapters[count(this->adapters) - 1],
+            version = last->get(this->versionKey);
+
+        if !version {
+            let version = bin2hex(random_bytes(8));
+
+            if !last->add(this->versionKey, version, this->versionLifetime) {
+                let version = last->get(this->versionKey, version);
+            }
+        }
+
+        let this->version          = (string) version,
+            this->versionCheckedAt = time();
+
+        return this->version;
+    }
+}
@@ -44,7 +44,9 @@ class AdapterFactory
             "libmemcached" : "\\Phalcon\\Storage\\Adapter\\Libmemcached",
             "memory"       : "\\Phalcon\\Storage\\Adapter\\Memory",
             "redis"        : "\\Phalcon\\Storage\\Adapter\\Redis",
-            "stream"       : "\\Phalcon\\Storage\\Adapter\\Stream"
+            "shm"          : "\\Phalcon\\Storage\\Adapter\\Shm",
+            "stream"       : "\\Phalcon\\Storage\\Adapter\\Stream",
+            "tiered"       : "\\Phalcon\\Storage\\Adapter\\Tiered"
         ];
 
         let helpers = array_merge(helpers, services);
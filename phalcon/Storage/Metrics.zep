@@ -0,0 +1,297 @@
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Storage;
+
+use Phalcon\Events\EventsAwareInterface;
+use Phalcon\Events\ManagerInterface;
+use Phalcon\Helper\Arr;
+
+/**
+ * Phalcon\Storage\Metrics
+ *
+ * Collects the operations of the storage adapters it is attached to: hits,
+ * misses, sets, deletes, bytes read and written, time spent serializing and
+ * a latency histogram per operation and key prefix.
+ *
+ * The prefix of a key is the part before its first delimiter ("-" by
+ * default). Once "maxPrefixes" prefixes are known, the keys with a new
+ * prefix are counted under "*".
+ *
+ * With an events manager, "storage:afterOperation" is fired after every
+ * operation, with the operation, the key, its prefix, the duration and
+ * whether it was a hit.
+ *
+ *<code>
+ * use Phalcon\Storage\Adapter\Apcu;
+ * use Phalcon\Storage\Metrics;
+ *
+ * $metrics = new Metrics();
+ * $adapter = new Apcu(
+ *     $serializerFactory,
+ *     [
+ *         "metrics" => $metrics,
+ *     ]
+ * );
+ *
+ * $adapter->get("products-12");
+ *
+ * echo json_encode($metrics->getStats());
+ *</code>
+ */
+class Metrics implements EventsAwareInterface
+{
+    /**
+     * Upper bounds of the latency histogram buckets, in seconds
+     *
+     * @var array
+     */
+    protected buckets = [
+        0.0001,
+        0.00025,
+        0.0005,
+        0.001,
+        0.0025,
+        0.005,
+        0.01,
+        0.025,
+        0.05,
+        0.1,
+        0.25,
+        0.5,
+        1.0
+    ];
+
+    /**
+     * @var string
+     */
+    protected delimiter = "-";
+
+    /**
+     * @var <ManagerInterface>
+     */
+    protected eventsManager;
+
+    /**
+     * @var int
+     */
+    protected maxPrefixes = 100;
+
+    /**
+     * Known key prefixes
+     *
+     * @var array
+     */
+    protected prefixes = [];
+
+    /**
+     * @var array
+     */
+    protected stats = [];
+
+    /**
+     * Constructor
+     */
+    public function __construct(array! options = []) -> void
+    {
+        var buckets;
+
+        let buckets = Arr::get(options, "buckets", null);
+
+        if typeof buckets == "array" {
+            sort(buckets);
+
+            let this->buckets = buckets;
+        }
+
+        let this->delimiter   = (string) Arr::get(options, "delimiter", "-"),
+            this->maxPrefixes = (int) Arr::get(options, "maxPrefixes", 100);
+
+        this->reset();
+    }
+
+    /**
+     * Returns the internal event manager
+     */
+    public function getEventsManager() -> <ManagerInterface>
+    {
+        return this->eventsManager;
+    }
+
+    /**
+     * Returns the ratio of the reads that found the key, between 0 and 1
+     */
+    public function getHitRatio() -> float
+    {
+        var total;
+
+        let total = this->stats["hits"] + this->stats["misses"];
+
+        if total == 0 {
+            return 0.0;
+        }
+
+        return this->stats["hits"] / total;
+    }
+
+    /**
+     * Returns the collected metrics. The histogram of an operation and prefix
+     * has a count per bucket of "buckets", followed by the count of the
+     * slower operations
+     *
+     *<code>
+     * [
+     *     "hits"              => 10,
+     *     "misses"            => 2,
+     *     "sets"              => 2,
+     *     "deletes"           => 0,
+     *     "bytesIn"           => 2450,
+     *     "bytesOut"          => 410,
+     *     "serializationTime" => 0.00012,
+     *     "buckets"           => [0.0001, 0.00025, ...],
+     *     "operations"        => [
+     *         "get" => [
+     *             "products" => [
+     *                 "count"     => 12,
+     *                 "time"      => 0.0021,
+     *                 "max"       => 0.0009,
+     *                 "histogram" => [4, 6, 1, 1, 0, ...],
+     *             ],
+     *         ],
+     *     ],
+     * ]
+     *</code>
+     */
+    public function getStats() -> array
+    {
+        return this->stats;
+    }
+
+    /**
+     * Adds an amount to a counter: hits, misses, sets, deletes, bytesIn,
+     * bytesOut or serializationTime
+     */
+    public function increment(string! counter, var amount = 1) -> void
+    {
+        var current;
+
+        if !fetch current, this->stats[counter] {
+            let current = 0;
+        }
+
+        let this->stats[counter] = current + amount;
+    }
+
+    /**
+     * Records an operation on a key. A get (hit true or false) counts as a
+     * hit or a miss, a set or an add as a set and a delete as a delete
+     */
+    public function record(string! operation, string! key, float duration, var hit = null) -> void
+    {
+        var bound, entry, index, position, prefix;
+
+        let prefix = "";
+
+        if this->delimiter !== "" {
+            let position = strpos(key, this->delimiter);
+
+            if position !== false {
+                let prefix = substr(key, 0, position);
+            }
+        }
+
+        if !isset this->prefixes[prefix] {
+            if count(this->prefixes) >= this->maxPrefixes {
+                let prefix = "*";
+            } else {
+                let this->prefixes[prefix] = true;
+            }
+        }
+
+        if isset this->stats["operations"][operation][prefix] {
+            let entry = this->stats["operations"][operation][prefix];
+        } else {
+            let entry = [
+                "count"     : 0,
+                "time"      : 0.0,
+                "max"       : 0.0,
+                "histogram" : array_fill(0, count(this->buckets) + 1, 0)
+            ];
+        }
+
+        let index = count(this->buckets);
+
+        for position, bound in this->buckets {
+            if duration <= bound {
+                let index = position;
+                break;
+            }
+        }
+
+        let entry["count"]            = entry["count"] + 1,
+            entry["time"]             = entry["time"] + duration,
+            entry["max"]              = max(entry["max"], duration),
+            entry["histogram"][index] = entry["histogram"][index] + 1;
+
+        let this->stats["operations"][operation][prefix] = entry;
+
+        if hit === true {
+            this->increment("hits");
+        } elseif hit === false {
+            this->increment("misses");
+        }
+
+        if operation === "set" || operation === "add" {
+            this->increment("sets");
+        } elseif operation === "delete" {
+            this->increment("deletes");
+        }
+
+        if typeof this->eventsManager == "object" {
+            this->eventsManager->fire(
+                "storage:afterOperation",
+                this,
+                [
+                    "operation" : operation,
+                    "key"       : key,
+                    "prefix"    : prefix,
+                    "duration"  : duration,
+                    "hit"       : hit
+                ]
+            );
+        }
+    }
+
+    /**
+     * Clears the collected metrics
+     */
+    public function reset() -> void
+    {
+        let this->prefixes = [],
+            this->stats    = [
+                "hits"              : 0,
+                "misses"            : 0,
+                "sets"              : 0,
+                "deletes"           : 0,
+                "bytesIn"           : 0,
+                "bytesOut"          : 0,
+                "serializationTime" : 0.0,
+                "buckets"           : this->buckets,
+                "operations"        : []
+            ];
+    }
+
+    /**
+     * Sets the events manager
+     */
+    public function setEventsManager(<ManagerInterface> eventsManager) -> void
+    {
+        let this->eventsManager = eventsManager;
+    }
+}
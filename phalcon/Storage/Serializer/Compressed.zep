@@ -0,0 +1,247 @@
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Storage\Serializer;
+
+use Phalcon\Helper\Arr;
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\Serializer\AbstractSerializer;
+use Phalcon\Storage\Serializer\SerializerInterface;
+
+/**
+ * Phalcon\Storage\Serializer\Compressed
+ *
+ * Compresses the output of another serializer when it is bigger than a
+ * threshold. Every payload but numbers starts with one byte naming the
+ * algorithm, or FORMAT_RAW when it is not compressed. Entries stored without
+ * that byte are still read as the wrapped serializer returns them when
+ * their first byte is not a known format.
+ *
+ * The algorithm is zlib, or with "auto" the best available one of zstd, lz4
+ * and zlib.
+ *
+ *<code>
+ * use Phalcon\Storage\Serializer\Compressed;
+ * use Phalcon\Storage\Serializer\Php;
+ *
+ * $serializer = new Compressed(
+ *     new Php(),
+ *     [
+ *         "compression" => "auto",
+ *         "threshold"   => 2048,
+ *     ]
+ * );
+ *</code>
+ */
+class Compressed extends AbstractSerializer
+{
+    const FORMAT_LZ4  = 2;
+    const FORMAT_RAW  = 4;
+    const FORMAT_ZLIB = 1;
+    const FORMAT_ZSTD = 3;
+
+    /**
+     * Algorithm used to compress
+     *
+     * @var string
+     */
+    protected compression = "zlib" { get };
+
+    /**
+     * Compression level, null for the default of the algorithm
+     *
+     * @var int|null
+     */
+    protected level = null;
+
+    /**
+     * Wrapped serializer
+     *
+     * @var <SerializerInterface>
+     */
+    protected serializer;
+
+    /**
+     * Payloads smaller than this are not compressed
+     *
+     * @var int
+     */
+    protected threshold = 2048;
+
+    /**
+     * Constructor
+     *
+     * @throws Exception
+     */
+    public function __construct(<SerializerInterface> serializer, array! options = []) -> void
+    {
+        var compression, level;
+
+        let compression = Arr::get(options, "compression", "zlib"),
+            level       = Arr::get(options, "level", null);
+
+        if compression === "auto" {
+            if function_exists("zstd_compress") {
+                let compression = "zstd";
+            } elseif function_exists("lz4_compress") {
+                let compression = "lz4";
+            } else {
+                let compression = "zlib";
+            }
+        }
+
+        if unlikely compression !== "zlib" && compression !== "lz4" && compression !== "zstd" {
+            throw new Exception("Compression " . compression . " is not supported");
+        }
+
+        if unlikely !function_exists(this->getCompressFunction(compression)) {
+            throw new Exception("The " . compression . " extension is not loaded");
+        }
+
+        let this->compression = compression,
+            this->level       = level === null ? null : (int) level,
+            this->serializer  = serializer,
+            this->threshold   = (int) Arr::get(options, "threshold", 2048);
+
+        parent::__construct();
+    }
+
+    /**
+     * Returns the wrapped serializer
+     */
+    public function getSerializer() -> <SerializerInterface>
+    {
+        return this->serializer;
+    }
+
+    /**
+     * Serializes the data with the wrapped serializer and compresses it when
+     * it is bigger than the threshold and compression saves space. The
+     * payload is prefixed with its format
+     */
+    public function serialize() -> string
+    {
+        var compressed, functionName, payload;
+
+        this->serializer->setData(this->data);
+
+        let payload = this->serializer->serialize();
+
+        /**
+         * Numbers are kept as they are, so the adapters can still increment
+         * and decrement them. They never start with a format byte
+         */
+        if typeof payload != "string" || is_numeric(payload) {
+            return payload;
+        }
+
+        if strlen(payload) < this->threshold {
+            return chr(self::FORMAT_RAW) . payload;
+        }
+
+        let functionName = this->getCompressFunction(this->compression);
+
+        if this->level === null {
+            let compressed = call_user_func(functionName, payload);
+        } else {
+            let compressed = call_user_func(functionName, payload, this->level);
+        }
+
+        if typeof compressed != "string" || strlen(compressed) >= strlen(payload) {
+            return chr(self::FORMAT_RAW) . payload;
+        }
+
+        switch this->compression {
+            case "lz4":
+                return chr(self::FORMAT_LZ4) . compressed;
+
+            case "zstd":
+                return chr(self::FORMAT_ZSTD) . compressed;
+        }
+
+        return chr(self::FORMAT_ZLIB) . compressed;
+    }
+
+    /**
+     * Decompresses the data according to its format header and unserializes
+     * it with the wrapped serializer. Data starting with an unknown format is
+     * passed as is
+     *
+     * @throws Exception
+     */
+    public function unserialize(var data) -> void
+    {
+        var format, payload;
+
+        if typeof data == "string" && data !== "" {
+            let format = ord(data);
+
+            switch format {
+                case self::FORMAT_ZLIB:
+                    let payload = gzuncompress(substr(data, 1));
+                    break;
+
+                case self::FORMAT_LZ4:
+                    let payload = this->decompress("lz4", substr(data, 1));
+                    break;
+
+                case self::FORMAT_ZSTD:
+                    let payload = this->decompress("zstd", substr(data, 1));
+                    break;
+
+                case self::FORMAT_RAW:
+                    let payload = (string) substr(data, 1);
+                    break;
+
+                default:
+                    let payload = data;
+            }
+
+            if unlikely payload === false {
+                throw new Exception("The data could not be decompressed");
+            }
+
+            let data = payload;
+        }
+
+        this->serializer->unserialize(data);
+
+        let this->data = this->serializer->getData();
+    }
+
+    /**
+     * Decompresses data with an algorithm provided by an extension
+     *
+     * @throws Exception
+     */
+    protected function decompress(string! compression, string! data) -> var
+    {
+        var functionName;
+
+        let functionName = compression . "_uncompress";
+
+        if unlikely !function_exists(functionName) {
+            throw new Exception("The " . compression . " extension is not loaded");
+        }
+
+        return call_user_func(functionName, data);
+    }
+
+    /**
+     * Returns the function compressing data with an algorithm
+     */
+    protected function getCompressFunction(string! compression) -> string
+    {
+        if compression === "zlib" {
+            return "gzcompress";
+        }
+
+        return compression . "_compress";
+    }
+}
@@ -10,8 +10,26 @@
 
 namespace Phalcon\Storage;
 
+use Phalcon\Storage\Serializer\Compressed;
 use Phalcon\Storage\Serializer\SerializerInterface;
 
+/**
+ * Phalcon\Storage\SerializerFactory
+ *
+ * Creates the serializers. With the "compression" option every serializer is
+ * wrapped in Phalcon\Storage\Serializer\Compressed, configured with the
+ * "compression", "threshold" and "level" options
+ *
+ *<code>
+ * $factory = new \Phalcon\Storage\SerializerFactory(
+ *     [],
+ *     [
+ *         "compression" => "auto",
+ *         "threshold"   => 4096,
+ *     ]
+ * );
+ *</code>
+ */
 class SerializerFactory
 {
     /**
@@ -19,6 +37,11 @@ class SerializerFactory
      */
     private mapper = [];
 
+    /**
+     * @var array
+     */
+    private options = [];
+
     /**
      * @var array
      */
@@ -28,11 +51,14 @@ class SerializerFactory
      * SerializerFactory constructor.
      *
      * @param array services
+     * @param array options
      */
-    public function __construct(array! services = [])
+    public function __construct(array! services = [], array! options = [])
     {
         var helpers, name, service;
 
+        let this->options = options;
+
         let helpers = [
             "base64"   : "\\Phalcon\\Storage\\Serializer\\Base64",
             "igbinary" : "\\Phalcon\\Storage\\Serializer\\Igbinary",
@@ -50,6 +76,20 @@ class SerializerFactory
         }
     }
 
+    /**
+     * Checks if the serializers created compress their output
+     */
+    public function hasCompression() -> bool
+    {
+        var compression;
+
+        if !fetch compression, this->options["compression"] {
+            return false;
+        }
+
+        return !empty compression;
+    }
+
     /**
      * @param string name
      *
@@ -67,6 +107,13 @@ class SerializerFactory
         if !isset this->services[name] {
             let definition           = this->mapper[name],
                 this->services[name] = new {definition}();
+
+            if this->hasCompression() {
+                let this->services[name] = new Compressed(
+                    this->services[name],
+                    this->options
+                );
+            }
         }
 
         return this->services[name];
@@ -0,0 +1,196 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Benchmark\Volt;
+
+use FilesystemIterator;
+use Phalcon\Di\FactoryDefault;
+use Phalcon\Mvc\View\Engine\Volt;
+use Phalcon\Mvc\View\Simple;
+use RecursiveDirectoryIterator;
+use RecursiveIteratorIterator;
+
+/**
+ * Generates the templates used by the Volt benchmarks in a temporary folder,
+ * so the measured templates are the same on every run
+ */
+abstract class AbstractVoltBench
+{
+    /**
+     * Depth of the extends chain
+     */
+    const EXTENDS_DEPTH = 10;
+
+    /**
+     * @var string
+     */
+    protected $compiledDir;
+
+    /**
+     * @var string
+     */
+    protected $viewsDir;
+
+    public function setUp()
+    {
+        $this->viewsDir    = sys_get_temp_dir() . '/phalcon-benchmark-volt-' . getmypid() . '/views/';
+        $this->compiledDir = dirname($this->viewsDir) . '/compiled/';
+
+        @mkdir($this->viewsDir . 'partials', 0777, true);
+        @mkdir($this->compiledDir, 0777, true);
+
+        $this->writeTemplate('large.volt', $this->getLargeTemplate(500));
+
+        /**
+         * Chain of layouts, each one extending the previous one
+         */
+        $this->writeTemplate(
+            'extends/level0.volt',
+            '<html><head>{% block head %}<title>base</title>{% endblock %}</head>'
+            . '<body>{% block body %}{% endblock %}</body></html>'
+        );
+
+        for ($level = 1; $level < self::EXTENDS_DEPTH; $level++) {
+            $this->writeTemplate(
+                'extends/level' . $level . '.volt',
+                "{% extends 'extends/level" . ($level - 1) . ".volt' %}"
+                . '{% block head %}{{ super() }}<meta name="level" content="' . $level . '">{% endblock %}'
+                . '{% block body %}<div class="level' . $level . '">{{ super() }}{{ title }}</div>{% endblock %}'
+            );
+        }
+
+        $this->writeTemplate(
+            'partials/row.volt',
+            '<tr><td>{{ i }}</td><td>{{ name }}</td></tr>'
+        );
+
+        $this->writeTemplate(
+            'include-static.volt',
+            "<table>{% for i in 1..200 %}{% include 'partials/row.volt' %}{% endfor %}</table>"
+        );
+
+        $this->writeTemplate(
+            'include-partial.volt',
+            "<table>{% for i in 1..200 %}{{ partial('partials/row', ['i': i]) }}{% endfor %}</table>"
+        );
+
+        $this->writeTemplate(
+            'autoescape.volt',
+            '<table>{% for row in rows %}<tr>{% for cell in row %}<td>{{ cell }}</td>{% endfor %}</tr>{% endfor %}</table>'
+        );
+
+        $this->writeTemplate(
+            'macro.volt',
+            "{% macro field(name, value, type = 'text', class = 'form-control') %}"
+            . '<div class="form-group"><label for="{{ name }}">{{ name|capitalize }}</label>'
+            . '<input type="{{ type }}" id="{{ name }}" name="{{ name }}" value="{{ value }}" class="{{ class }}"></div>'
+            . '{% endmacro %}'
+            . '<form>{% for i in 1..150 %}{{ field("field" ~ i, i) }}{% endfor %}</form>'
+        );
+    }
+
+    public function tearDown()
+    {
+        $root = dirname($this->viewsDir);
+
+        $files = new RecursiveIteratorIterator(
+            new RecursiveDirectoryIterator($root, FilesystemIterator::SKIP_DOTS),
+            RecursiveIteratorIterator::CHILD_FIRST
+        );
+
+        foreach ($files as $file) {
+            if ($file->isDir()) {
+                rmdir($file->getPathname());
+            } else {
+                unlink($file->getPathname());
+            }
+        }
+
+        rmdir($root);
+    }
+
+    /**
+     * Returns a template mixing the most common statements and expressions
+     */
+    protected function getLargeTemplate(int $sections): string
+    {
+        $source = '';
+
+        for ($section = 0; $section < $sections; $section++) {
+            $source .= '<section id="s' . $section . '">'
+                . '{% if user.isLoggedIn() and section' . $section . ' is defined %}'
+                . '<h2>{{ section' . $section . '.title|e }}</h2>'
+                . '{% for item in section' . $section . '.items %}'
+                . '<p class="{{ loop.index is odd ? "odd" : "even" }}">{{ item.name|upper }} - {{ item.price|format("%.2f") }}</p>'
+                . '{% else %}<p>Empty</p>{% endfor %}'
+                . '{% set total = total + ' . $section . ' * 2 %}'
+                . '{% elseif user.isGuest() %}{{ link_to("login", "Login") }}'
+                . '{% endif %}</section>' . PHP_EOL;
+        }
+
+        return $source;
+    }
+
+    /**
+     * Returns a Volt engine attached to a simple view. Every set of options
+     * gets its own compiled templates
+     */
+    protected function getVolt(array $options = []): Volt
+    {
+        $container = new FactoryDefault();
+
+        $view = new Simple();
+        $view->setDI($container);
+        $view->setViewsDir($this->viewsDir);
+
+        $compiledDir = $this->compiledDir . md5(serialize($options)) . '/';
+
+        @mkdir($compiledDir, 0777, true);
+
+        $volt = new Volt($view, $container);
+        $volt->setOptions(
+            array_merge(
+                [
+                    'path' => $compiledDir,
+                ],
+                $options
+            )
+        );
+
+        $view->registerEngines(
+            [
+                '.volt' => $volt,
+            ]
+        );
+
+        return $volt;
+    }
+
+    /**
+     * Renders a template and returns its output
+     */
+    protected function render(Volt $volt, string $template, array $params = []): string
+    {
+        ob_start();
+
+        $volt->render($this->viewsDir . $template, $params);
+
+        return ob_get_clean();
+    }
+
+    protected function writeTemplate(string $name, string $source)
+    {
+        @mkdir(dirname($this->viewsDir . $name), 0777, true);
+
+        file_put_contents($this->viewsDir . $name, $source);
+    }
+}
@@ -0,0 +1,70 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Benchmark\Volt;
+
+/**
+ * Cost of Compiler::compile() for templates that are already compiled, with
+ * and without the "stat" checks, and of a full compilation
+ *
+ * @Revs(200)
+ * @Iterations(5)
+ */
+class CompilerBench extends AbstractVoltBench
+{
+    /**
+     * @var string
+     */
+    private $template;
+
+    /**
+     * @var array
+     */
+    private $compilers = [];
+
+    public function setUp()
+    {
+        parent::setUp();
+
+        $this->template = $this->viewsDir . 'extends/level' . (self::EXTENDS_DEPTH - 1) . '.volt';
+
+        foreach (['stat' => ['stat' => true], 'noStat' => ['stat' => false], 'always' => ['always' => true]] as $name => $options) {
+            $this->compilers[$name] = $this->getVolt($options)->getCompiler();
+        }
+    }
+
+    /**
+     * The compiled template is reused, its mtime is compared with the source
+     */
+    public function benchCompileStat()
+    {
+        $this->compilers['stat']->compile($this->template);
+    }
+
+    /**
+     * The compiled template is reused without checking the source
+     */
+    public function benchCompileNoStat()
+    {
+        $this->compilers['noStat']->compile($this->template);
+    }
+
+    /**
+     * Full compilation of the deepest template of the extends chain
+     *
+     * @Revs(20)
+     */
+    public function benchCompileAlwaysDeepExtends()
+    {
+        $this->compilers['always']->compile($this->template);
+    }
+}
@@ -0,0 +1,52 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Benchmark\Volt;
+
+use Phalcon\Mvc\View\Engine\Volt\Compiler;
+
+/**
+ * Scanner, parser and compiler throughput on a large template
+ *
+ * @Revs(20)
+ * @Iterations(5)
+ */
+class ParserBench extends AbstractVoltBench
+{
+    /**
+     * @var string
+     */
+    private $source;
+
+    public function setUp()
+    {
+        parent::setUp();
+
+        $this->source = file_get_contents($this->viewsDir . 'large.volt');
+    }
+
+    /**
+     * Scanner and parser only (phvolt_parse_view)
+     */
+    public function benchParseLargeTemplate()
+    {
+        (new Compiler())->parse($this->source);
+    }
+
+    /**
+     * Parsing and code generation
+     */
+    public function benchCompileLargeTemplate()
+    {
+        (new Compiler())->compileString($this->source);
+    }
+}
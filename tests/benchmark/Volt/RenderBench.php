@@ -0,0 +1,105 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Benchmark\Volt;
+
+use Phalcon\Mvc\View\Engine\Volt;
+
+/**
+ * Rendering of compiled templates. The "Optimized" variants use the
+ * "optimize" compiler option
+ *
+ * @Revs(50)
+ * @Iterations(5)
+ */
+class RenderBench extends AbstractVoltBench
+{
+    /**
+     * @var Volt
+     */
+    private $volt;
+
+    /**
+     * @var Volt
+     */
+    private $voltAutoescape;
+
+    /**
+     * @var Volt
+     */
+    private $voltOptimized;
+
+    /**
+     * @var array
+     */
+    private $rows = [];
+
+    public function setUp()
+    {
+        parent::setUp();
+
+        $this->volt           = $this->getVolt();
+        $this->voltAutoescape = $this->getVolt(['autoescape' => true]);
+        $this->voltOptimized  = $this->getVolt(['autoescape' => true, 'optimize' => true]);
+
+        /**
+         * 2,000 cells
+         */
+        for ($row = 0; $row < 200; $row++) {
+            for ($cell = 0; $cell < 10; $cell++) {
+                $this->rows[$row][] = '<b>' . $row . '&' . $cell . '</b>';
+            }
+        }
+    }
+
+    public function benchDeepExtends()
+    {
+        $this->render(
+            $this->volt,
+            'extends/level' . (self::EXTENDS_DEPTH - 1) . '.volt',
+            ['title' => 'Benchmark']
+        );
+    }
+
+    public function benchIncludeStatic()
+    {
+        $this->render($this->volt, 'include-static.volt', ['name' => 'Phalcon']);
+    }
+
+    /**
+     * @Revs(10)
+     */
+    public function benchIncludePartial()
+    {
+        $this->render($this->volt, 'include-partial.volt', ['name' => 'Phalcon']);
+    }
+
+    public function benchAutoescape()
+    {
+        $this->render($this->voltAutoescape, 'autoescape.volt', ['rows' => $this->rows]);
+    }
+
+    public function benchAutoescapeOptimized()
+    {
+        $this->render($this->voltOptimized, 'autoescape.volt', ['rows' => $this->rows]);
+    }
+
+    public function benchMacroCalls()
+    {
+        $this->render($this->voltAutoescape, 'macro.volt');
+    }
+
+    public function benchMacroCallsOptimized()
+    {
+        $this->render($this->voltOptimized, 'macro.volt');
+    }
+}
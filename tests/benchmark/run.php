@@ -0,0 +1,232 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+/**
+ * Runs the benchmarks of this folder and reports the results as JSON.
+ *
+ * Every class named *Bench is a subject. Its public bench* methods are
+ * measured, after calling setUp() (if present), with the number of
+ * revolutions and iterations set by the @Revs() and @Iterations()
+ * annotations, phpbench style. tearDown() is called once the subject is done.
+ *
+ * Usage:
+ *
+ *   php tests/benchmark/run.php [--filter=<pattern>] [--output=<file.json>]
+ *                               [--compare=<baseline.json>] [--iterations=<n>]
+ *
+ *   # Baseline on master, then compare a branch against it
+ *   php tests/benchmark/run.php --output=master.json
+ *   php tests/benchmark/run.php --compare=master.json
+ */
+
+error_reporting(-1);
+
+ini_set('display_errors', '1');
+date_default_timezone_set('UTC');
+
+if (!extension_loaded('phalcon')) {
+    fwrite(STDERR, "The phalcon extension is required to run the benchmarks" . PHP_EOL);
+    exit(1);
+}
+
+spl_autoload_register(
+    function (string $className) {
+        $prefix = 'Phalcon\\Test\\Benchmark\\';
+
+        if (strpos($className, $prefix) !== 0) {
+            return;
+        }
+
+        $fileName = __DIR__ . '/' . str_replace('\\', '/', substr($className, strlen($prefix))) . '.php';
+
+        if (file_exists($fileName)) {
+            require $fileName;
+        }
+    }
+);
+
+$options = getopt('', ['filter:', 'output:', 'compare:', 'iterations:']);
+
+$filter     = $options['filter'] ?? null;
+$iterations = isset($options['iterations']) ? (int) $options['iterations'] : null;
+
+/**
+ * Reads an annotation (@Name(value)) from a doc comment
+ */
+$annotation = function ($reflection, string $name, int $default): int {
+    $docComment = (string) $reflection->getDocComment();
+
+    if (preg_match('/@' . $name . '\((\d+)\)/', $docComment, $matches)) {
+        return (int) $matches[1];
+    }
+
+    return $default;
+};
+
+/**
+ * Current time in microseconds
+ */
+$now = function (): float {
+    if (function_exists('hrtime')) {
+        return hrtime(true) / 1000;
+    }
+
+    return microtime(true) * 1000000;
+};
+
+$results = [];
+
+$files = new RecursiveIteratorIterator(
+    new RecursiveDirectoryIterator(__DIR__, FilesystemIterator::SKIP_DOTS)
+);
+
+$subjects = [];
+
+foreach ($files as $file) {
+    if (substr($file->getFilename(), -9) !== 'Bench.php') {
+        continue;
+    }
+
+    $relative = substr($file->getPathname(), strlen(__DIR__) + 1, -4);
+
+    $subjects[] = 'Phalcon\\Test\\Benchmark\\' . str_replace('/', '\\', $relative);
+}
+
+sort($subjects);
+
+foreach ($subjects as $className) {
+    $class = new ReflectionClass($className);
+
+    if ($class->isAbstract()) {
+        continue;
+    }
+
+    foreach ($class->getMethods(ReflectionMethod::IS_PUBLIC) as $method) {
+        if (strpos($method->getName(), 'bench') !== 0) {
+            continue;
+        }
+
+        $name = substr($className, strlen('Phalcon\\Test\\Benchmark\\')) . '::' . $method->getName();
+
+        if ($filter !== null && !preg_match('#' . $filter . '#', $name)) {
+            continue;
+        }
+
+        $revs  = $annotation($method, 'Revs', $annotation($class, 'Revs', 100));
+        $count = $iterations ?? $annotation($method, 'Iterations', $annotation($class, 'Iterations', 5));
+
+        $subject = $class->newInstance();
+
+        if (method_exists($subject, 'setUp')) {
+            $subject->setUp();
+        }
+
+        /**
+         * Warm up: compiled templates, opcache, lazy services
+         */
+        $subject->{$method->getName()}();
+
+        $times = [];
+
+        for ($iteration = 0; $iteration < $count; $iteration++) {
+            $start = $now();
+
+            for ($rev = 0; $rev < $revs; $rev++) {
+                $subject->{$method->getName()}();
+            }
+
+            $times[] = ($now() - $start) / $revs;
+        }
+
+        if (method_exists($subject, 'tearDown')) {
+            $subject->tearDown();
+        }
+
+        sort($times);
+
+        $mean     = array_sum($times) / $count;
+        $variance = 0.0;
+
+        foreach ($times as $time) {
+            $variance += ($time - $mean) ** 2;
+        }
+
+        $stdev = sqrt($variance / $count);
+
+        $results[$name] = [
+            'revs'       => $revs,
+            'iterations' => $count,
+            'min'        => round($times[0], 3),
+            'max'        => round($times[$count - 1], 3),
+            'mean'       => round($mean, 3),
+            'median'     => round($times[intdiv($count, 2)], 3),
+            'stdev'      => round($stdev, 3),
+            'rstdev'     => $mean > 0 ? round($stdev / $mean * 100, 2) : 0,
+        ];
+
+        fwrite(
+            STDERR,
+            sprintf("%-60s %12.3f us (±%.2f%%)", $name, $results[$name]['median'], $results[$name]['rstdev']) . PHP_EOL
+        );
+    }
+}
+
+$report = [
+    'time_unit'  => 'microseconds',
+    'php'        => PHP_VERSION,
+    'phalcon'    => Phalcon\Version::get(),
+    'commit'     => trim((string) @shell_exec('git -C ' . escapeshellarg(__DIR__) . ' rev-parse HEAD 2>/dev/null')),
+    'date'       => date('c'),
+    'opcache'    => function_exists('opcache_get_status') && (bool) @opcache_get_status(false),
+    'benchmarks' => $results,
+];
+
+$json = json_encode($report, JSON_PRETTY_PRINT | JSON_UNESCAPED_SLASHES);
+
+if (isset($options['output'])) {
+    file_put_contents($options['output'], $json . PHP_EOL);
+} else {
+    echo $json, PHP_EOL;
+}
+
+/**
+ * Compare the median of every benchmark with a previous report
+ */
+if (isset($options['compare'])) {
+    $baseline = json_decode((string) file_get_contents($options['compare']), true);
+
+    if (!is_array($baseline) || !isset($baseline['benchmarks'])) {
+        fwrite(STDERR, "Invalid baseline report " . $options['compare'] . PHP_EOL);
+        exit(1);
+    }
+
+    fwrite(STDERR, PHP_EOL . sprintf("%-60s %12s %12s %9s", 'benchmark', 'baseline', 'current', 'diff') . PHP_EOL);
+
+    foreach ($results as $name => $result) {
+        if (!isset($baseline['benchmarks'][$name])) {
+            continue;
+        }
+
+        $before = $baseline['benchmarks'][$name]['median'];
+
+        fwrite(
+            STDERR,
+            sprintf(
+                "%-60s %12.3f %12.3f %+8.2f%%",
+                $name,
+                $before,
+                $result['median'],
+                $before > 0 ? ($result['median'] - $before) / $before * 100 : 0
+            ) . PHP_EOL
+        );
+    }
+}
@@ -213,6 +213,13 @@ class DbDescribeCest
             $connection->describeColumns('personas', 'public')
         );
 
+        $schemaColumns = $connection->describeSchemaColumns();
+
+        $I->assertEquals(
+            $expectedDescribe,
+            $schemaColumns['personas']
+        );
+
         /**
          * @todo Check the references (SQL dump file)
          */
@@ -525,6 +532,13 @@ class DbDescribeCest
             $connection->describeColumns('personas', 'main')
         );
 
+        $schemaColumns = $connection->describeSchemaColumns();
+
+        $I->assertEquals(
+            $expectedDescribe,
+            $schemaColumns['personas']
+        );
+
 
 
         // Indexes
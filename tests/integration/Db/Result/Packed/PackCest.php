@@ -0,0 +1,100 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Db\Result\Packed;
+
+use IntegrationTester;
+use Phalcon\Db;
+use Phalcon\Db\Result\Packed;
+
+/**
+ * Class PackCest
+ */
+class PackCest
+{
+    /**
+     * Tests Phalcon\Db\Result\Packed :: pack()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function dbResultPackedPack(IntegrationTester $I)
+    {
+        $I->wantToTest('Db\Result\Packed - pack()');
+
+        $rows = [
+            [
+                'id'      => 1,
+                'name'    => 'Robotina',
+                'price'   => 1.25,
+                'deleted' => null,
+                'active'  => true,
+                'text'    => str_repeat('a', 300),
+                'tags'    => ['one', 'two'],
+            ],
+            [
+                'id'      => -2,
+                'name'    => '',
+                'price'   => 0.0,
+                'deleted' => '2019-01-01',
+                'active'  => false,
+                'text'    => 'short',
+                'tags'    => [],
+            ],
+        ];
+
+        $result = new Packed(
+            Packed::pack($rows)
+        );
+
+        $I->assertEquals(2, $result->numRows());
+
+        $I->assertSame($rows[0], $result->fetch());
+        $I->assertSame($rows[1], $result->fetch());
+        $I->assertFalse($result->fetch());
+
+        $result->dataSeek(1);
+
+        $I->assertSame($rows[1], $result->fetchArray());
+
+        $result->execute();
+
+        $I->assertSame($rows, $result->fetchAll());
+
+        $result->setFetchMode(Db::FETCH_NUM);
+        $result->dataSeek(0);
+
+        $I->assertSame(
+            array_values($rows[0]),
+            $result->fetch()
+        );
+    }
+
+    /**
+     * Tests Phalcon\Db\Result\Packed :: pack() - empty
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function dbResultPackedPackEmpty(IntegrationTester $I)
+    {
+        $I->wantToTest('Db\Result\Packed - pack() - empty');
+
+        $result = new Packed(
+            Packed::pack([])
+        );
+
+        $I->assertEquals(0, $result->numRows());
+        $I->assertFalse($result->fetch());
+        $I->assertEquals([], $result->fetchAll());
+    }
+}
@@ -0,0 +1,127 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Db\Result\Pdo;
+
+use IntegrationTester;
+use Phalcon\Db;
+use Phalcon\Db\Adapter\Pdo\Sqlite;
+use Phalcon\Events\Manager;
+use function getOptionsSqlite;
+
+/**
+ * Class UseBufferCest
+ */
+class UseBufferCest
+{
+    /**
+     * Tests Phalcon\Db\Result\Pdo :: useBuffer()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function dbResultPdoUseBuffer(IntegrationTester $I)
+    {
+        $I->wantToTest('Db\Result\Pdo - useBuffer()');
+
+        $connection = new Sqlite(
+            array_merge(
+                getOptionsSqlite(),
+                [
+                    'resultBuffer' => 1,
+                ]
+            )
+        );
+
+        $queries       = 0;
+        $eventsManager = new Manager();
+        $eventsManager->attach(
+            'db:beforeQuery',
+            function () use (&$queries) {
+                $queries++;
+            }
+        );
+
+        $connection->setEventsManager($eventsManager);
+
+        $result = $connection->query(
+            'SELECT id, name FROM robots ORDER BY id'
+        );
+        $result->setFetchMode(Db::FETCH_ASSOC);
+
+        /**
+         * numRows() reads the rows in the buffer, one in memory and the rest
+         * in the spill stream
+         */
+        $I->assertEquals(3, $result->numRows());
+
+        $I->assertEquals(
+            [
+                'id'   => 1,
+                'name' => 'Robotina',
+            ],
+            $result->fetch()
+        );
+
+        $result->dataSeek(2);
+
+        $I->assertEquals(
+            [
+                'id'   => 3,
+                'name' => 'Terminator',
+            ],
+            $result->fetch()
+        );
+
+        $I->assertFalse(
+            $result->fetch()
+        );
+
+        $result->dataSeek(1);
+
+        $I->assertEquals(
+            [
+                'id'   => 2,
+                'name' => 'Astro Boy',
+            ],
+            $result->fetchArray()
+        );
+
+        $result->execute();
+
+        $I->assertCount(
+            3,
+            $result->fetchAll()
+        );
+
+        /**
+         * Only the original query was sent to the database
+         */
+        $I->assertEquals(1, $queries);
+
+        /**
+         * Changing the fetch mode buffers the rows again with the new mode
+         */
+        $I->assertTrue(
+            $result->setFetchMode(Db::FETCH_NUM)
+        );
+
+        $result->dataSeek(0);
+
+        $I->assertEquals(
+            [1, 'Robotina'],
+            $result->fetch()
+        );
+
+        $I->assertEquals(3, $result->numRows());
+    }
+}
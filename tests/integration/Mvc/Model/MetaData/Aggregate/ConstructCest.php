@@ -0,0 +1,177 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\Model\MetaData\Aggregate;
+
+use function cacheDir;
+use function dataDir;
+use IntegrationTester;
+use Phalcon\Mvc\Model\MetaData\Aggregate;
+use Phalcon\Mvc\Model\MetaDataInterface;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use Phalcon\Test\Models\Robots;
+
+/**
+ * Class ConstructCest
+ */
+class ConstructCest
+{
+    use DiTrait;
+
+    private $data;
+
+    public function _before(IntegrationTester $I)
+    {
+        $this->setNewFactoryDefault();
+        $this->setDiMysql();
+
+        $this->data = require dataDir('fixtures/metadata/robots.php');
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\MetaData\Aggregate :: __construct()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcModelMetadataAggregateConstruct(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\MetaData\Aggregate - __construct()');
+
+        $this->container->setShared(
+            'modelsMetadata',
+            function () {
+                return new Aggregate(
+                    [
+                        'metaDataDir' => cacheDir(),
+                    ]
+                );
+            }
+        );
+
+        /** @var MetaDataInterface $md */
+        $md = $this->container->getShared('modelsMetadata');
+
+        $md->reset();
+        $I->assertTrue($md->isEmpty());
+
+        Robots::findFirst();
+
+        $I->amInPath(cacheDir());
+
+        $I->seeFileFound('metadata.php');
+
+        $data = require cacheDir('metadata.php');
+
+        $I->assertEquals(
+            $this->data['meta-robots-robots'],
+            $data['meta-phalcon\test\models\robots-robots']
+        );
+
+        $I->assertEquals(
+            $this->data['map-robots'],
+            $data['map-phalcon\test\models\robots']
+        );
+
+        $I->assertFalse($md->isEmpty());
+
+        $md->reset();
+        $I->assertTrue($md->isEmpty());
+
+        /**
+         * The meta-data is read back from the aggregated file
+         */
+        $I->assertEquals(
+            $this->data['meta-robots-robots'][0],
+            $md->getAttributes(new Robots())
+        );
+
+        $I->safeDeleteFile('metadata.php');
+        $I->safeDeleteFile('metadata.lock');
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\MetaData\Aggregate :: __construct() - shards
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcModelMetadataAggregateConstructShards(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\MetaData\Aggregate - __construct() - shards');
+
+        $md = new Aggregate(
+            [
+                'metaDataDir' => cacheDir(),
+                'shards'      => 4,
+            ]
+        );
+
+        $md->write('meta-one', ['one']);
+        $md->write('meta-two', ['two']);
+
+        $md = new Aggregate(
+            [
+                'metaDataDir' => cacheDir(),
+                'shards'      => 4,
+            ]
+        );
+
+        $I->assertEquals(['one'], $md->read('meta-one'));
+        $I->assertEquals(['two'], $md->read('meta-two'));
+        $I->assertNull($md->read('meta-three'));
+
+        $I->amInPath(cacheDir());
+
+        for ($index = 0; $index < 4; $index++) {
+            $I->safeDeleteFile('metadata-' . $index . '.php');
+        }
+
+        $I->safeDeleteFile('metadata.lock');
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\MetaData\Aggregate :: write() - merge
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcModelMetadataAggregateWriteMerge(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\MetaData\Aggregate - write() - merge');
+
+        $options = [
+            'metaDataDir' => cacheDir(),
+        ];
+
+        /**
+         * Two instances that loaded the shard before either wrote to it
+         */
+        $first  = new Aggregate($options);
+        $second = new Aggregate($options);
+
+        $I->assertNull($first->read('meta-one'));
+        $I->assertNull($second->read('meta-two'));
+
+        $first->write('meta-one', ['one']);
+        $second->write('meta-two', ['two']);
+
+        $md = new Aggregate($options);
+
+        $I->assertEquals(['one'], $md->read('meta-one'));
+        $I->assertEquals(['two'], $md->read('meta-two'));
+
+        $I->amInPath(cacheDir());
+        $I->safeDeleteFile('metadata.php');
+        $I->safeDeleteFile('metadata.lock');
+    }
+}
@@ -0,0 +1,99 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\Model\MetaData\Memory;
+
+use IntegrationTester;
+use Phalcon\Events\Manager;
+use Phalcon\Mvc\Model\MetaData\Memory;
+use Phalcon\Mvc\Model\MetaDataInterface;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use Phalcon\Test\Models\Parts;
+use Phalcon\Test\Models\Robots;
+use Phalcon\Test\Models\RobotsParts;
+
+/**
+ * Class WarmupCest
+ */
+class WarmupCest
+{
+    use DiTrait;
+
+    public function _before(IntegrationTester $I)
+    {
+        $this->setNewFactoryDefault();
+        $this->setDiMysql();
+        $this->container->setShared(
+            'modelsMetadata',
+            function () {
+                return new Memory();
+            }
+        );
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\MetaData\Memory :: warmup()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcModelMetadataMemoryWarmup(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\MetaData\Memory - warmup()');
+
+        $queries       = 0;
+        $eventsManager = new Manager();
+        $eventsManager->attach(
+            'db:beforeQuery',
+            function () use (&$queries) {
+                $queries++;
+            }
+        );
+
+        $this->container->getShared('db')->setEventsManager($eventsManager);
+
+        /** @var MetaDataInterface $metaData */
+        $metaData = $this->container->getShared('modelsMetadata');
+
+        $metaData->reset();
+        $I->assertTrue($metaData->isEmpty());
+
+        $metaData->warmup(
+            [
+                Robots::class,
+                RobotsParts::class,
+                new Parts(),
+            ]
+        );
+
+        /**
+         * The three tables are described with a single query
+         */
+        $I->assertEquals(1, $queries);
+        $I->assertFalse($metaData->isEmpty());
+
+        $warm = $metaData->readMetaData(new RobotsParts());
+
+        $I->assertEquals(1, $queries);
+
+        /**
+         * The meta-data matches the one built by the introspection of a
+         * single table
+         */
+        $metaData->reset();
+
+        $I->assertEquals(
+            $metaData->readMetaData(new RobotsParts()),
+            $warm
+        );
+    }
+}
@@ -13,12 +13,17 @@ declare(strict_types=1);
 namespace Phalcon\Test\Integration\Mvc\Model\Resultset\Simple;
 
 use IntegrationTester;
+use Phalcon\Mvc\Model;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use Phalcon\Test\Models\Robots;
 
 /**
  * Class SerializeCest
  */
 class SerializeCest
 {
+    use DiTrait;
+
     /**
      * Tests Phalcon\Mvc\Model\Resultset\Simple :: serialize()
      *
@@ -30,4 +35,60 @@ class SerializeCest
         $I->wantToTest('Mvc\Model\Resultset\Simple - serialize()');
         $I->skipTest('Need implementation');
     }
+
+    /**
+     * Tests Phalcon\Mvc\Model\Resultset\Simple :: serialize() - packed
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcModelResultsetSimpleSerializePacked(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\Resultset\Simple - serialize() - packed');
+
+        $this->setNewFactoryDefault();
+        $this->setDiMysql();
+
+        Model::setup(
+            [
+                'resultsetPacking' => true,
+            ]
+        );
+
+        $robots = Robots::find(
+            [
+                'order' => 'id',
+            ]
+        );
+
+        $unserialized = unserialize(
+            serialize($robots)
+        );
+
+        Model::setup(
+            [
+                'resultsetPacking' => false,
+            ]
+        );
+
+        $I->assertCount(
+            count($robots),
+            $unserialized
+        );
+
+        $I->assertEquals(
+            $robots->getLast()->toArray(),
+            $unserialized->getLast()->toArray()
+        );
+
+        $I->assertEquals(
+            $robots->getFirst()->toArray(),
+            $unserialized->getFirst()->toArray()
+        );
+
+        $I->assertEquals(
+            $robots->toArray(),
+            $unserialized->toArray()
+        );
+    }
 }
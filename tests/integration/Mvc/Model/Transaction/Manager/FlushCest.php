@@ -0,0 +1,292 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\Model\Transaction\Manager;
+
+use IntegrationTester;
+use Phalcon\Events\Manager;
+use Phalcon\Mvc\Model;
+use Phalcon\Mvc\Model\Transaction\Exception;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use Phalcon\Test\Models\Parts;
+use Phalcon\Test\Models\RobotsParts;
+
+/**
+ * Class FlushCest
+ */
+class FlushCest
+{
+    use DiTrait;
+
+    public function _before(IntegrationTester $I)
+    {
+        $this->setNewFactoryDefault();
+        $this->setDiMysql();
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\Transaction\Manager :: flush()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-18
+     */
+    public function mvcModelTransactionManagerFlush(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\Transaction\Manager - flush()');
+
+        $tm = $this->container->getShared('transactionManager');
+        $db = $this->container->getShared('db');
+
+        $db->delete('robots_parts', 'parts_id >= 100');
+        $db->delete('parts', 'id >= 100');
+
+        /**
+         * Count the statements sent, by type
+         */
+        $statements    = [];
+        $eventsManager = new Manager();
+        $eventsManager->attach(
+            'db:beforeQuery',
+            function ($event, $connection) use (&$statements) {
+                $type = strtoupper(
+                    strtok(
+                        ltrim($connection->getSQLStatement()),
+                        ' '
+                    )
+                );
+
+                $statements[$type] = ($statements[$type] ?? 0) + 1;
+            }
+        );
+
+        $db->setEventsManager($eventsManager);
+
+        /**
+         * Children are queued first, the parents must be inserted before them
+         */
+        $robotsParts = [];
+        $parts       = [];
+
+        for ($i = 0; $i < 3; $i++) {
+            $robotPart = new RobotsParts();
+
+            $robotPart->robots_id = 1;
+            $robotPart->parts_id  = 100 + $i;
+
+            $tm->persist($robotPart);
+
+            $robotsParts[] = $robotPart;
+        }
+
+        for ($i = 0; $i < 3; $i++) {
+            $part = new Parts();
+
+            $part->id   = 100 + $i;
+            $part->name = 'Flush ' . $i;
+
+            $tm->persist($part);
+
+            $parts[] = $part;
+        }
+
+        $I->assertTrue(
+            $tm->flush()
+        );
+
+        $I->assertFalse(
+            $tm->has()
+        );
+
+        $I->assertEquals(
+            3,
+            Parts::count('id >= 100')
+        );
+
+        foreach ($robotsParts as $robotPart) {
+            $I->assertGreaterThan(0, $robotPart->id);
+
+            $I->assertEquals(
+                Model::DIRTY_STATE_PERSISTENT,
+                $robotPart->getDirtyState()
+            );
+        }
+
+        /**
+         * Updates are coalesced into a single statement
+         */
+        foreach ($parts as $i => $part) {
+            $part->name = 'Flushed ' . $i;
+
+            $tm->persist($part);
+        }
+
+        $statements = [];
+
+        $I->assertTrue(
+            $tm->flush()
+        );
+
+        $I->assertEquals(1, $statements['UPDATE'] ?? 0);
+
+        $I->assertEquals(
+            'Flushed 2',
+            Parts::findFirst(102)->name
+        );
+
+        $I->assertEquals(
+            'Flushed 0',
+            Parts::findFirst(100)->name
+        );
+
+        /**
+         * Deletes run children first, one statement per table
+         */
+        foreach ($parts as $part) {
+            $tm->remove($part);
+        }
+
+        foreach ($robotsParts as $robotPart) {
+            $tm->remove($robotPart);
+        }
+
+        $statements = [];
+
+        $I->assertTrue(
+            $tm->flush()
+        );
+
+        $I->assertEquals(2, $statements['DELETE'] ?? 0);
+
+        $I->assertEquals(
+            0,
+            Parts::count('id >= 100')
+        );
+
+        $I->assertEquals(
+            0,
+            RobotsParts::count('parts_id >= 100')
+        );
+
+        $I->assertEquals(
+            Model::DIRTY_STATE_DETACHED,
+            $parts[0]->getDirtyState()
+        );
+
+        $eventsManager->detachAll('db');
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\Transaction\Manager :: flush() - new parent
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-18
+     */
+    public function mvcModelTransactionManagerFlushNewParent(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\Transaction\Manager - flush() - new parent');
+
+        $tm = $this->container->getShared('transactionManager');
+
+        $part       = new Parts();
+        $part->name = 'Flush parent';
+
+        $robotPart            = new RobotsParts();
+        $robotPart->robots_id = 1;
+        $robotPart->part      = $part;
+
+        /**
+         * The child is queued first, it gets the generated key of its parent
+         */
+        $tm->persist($robotPart);
+        $tm->persist($part);
+
+        $I->assertTrue(
+            $tm->flush()
+        );
+
+        $I->assertGreaterThan(0, $part->id);
+        $I->assertEquals($part->id, $robotPart->parts_id);
+
+        $I->assertEquals(
+            1,
+            RobotsParts::count(
+                [
+                    'parts_id = :id:',
+                    'bind' => [
+                        'id' => $part->id,
+                    ],
+                ]
+            )
+        );
+
+        $tm->remove($robotPart);
+        $tm->remove($part);
+
+        $I->assertTrue(
+            $tm->flush()
+        );
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\Transaction\Manager :: flush() - other
+     * connection
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-18
+     */
+    public function mvcModelTransactionManagerFlushOtherConnection(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\Transaction\Manager - flush() - other connection');
+
+        $tm = $this->container->getShared('transactionManager');
+        $tm->setDbService('dbTwo');
+
+        $part       = new Parts();
+        $part->name = 'Flush other';
+
+        $tm->persist($part);
+
+        $I->expectThrowable(
+            new Exception(
+                "The model 'Phalcon\Test\Models\Parts' is written through the 'db' service, " .
+                "flush() only writes through 'dbTwo'"
+            ),
+            function () use ($tm) {
+                $tm->flush();
+            }
+        );
+
+        $tm->clearPending();
+        $tm->setDbService('db');
+    }
+
+    /**
+     * Tests Phalcon\Mvc\Model\Transaction\Manager :: flush() - empty queue
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-18
+     */
+    public function mvcModelTransactionManagerFlushEmpty(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\Model\Transaction\Manager - flush() - empty');
+
+        $tm = $this->container->getShared('transactionManager');
+
+        $I->assertTrue(
+            $tm->flush()
+        );
+
+        $I->assertFalse(
+            $tm->has()
+        );
+    }
+}
@@ -13,6 +13,7 @@ declare(strict_types=1);
 namespace Phalcon\Test\Integration\Mvc\View\Engine\Volt\Compiler;
 
 use IntegrationTester;
+use Phalcon\Mvc\View\Engine\Volt\Compiler;
 
 /**
  * Class CompileCest
@@ -30,4 +31,71 @@ class CompileCest
         $I->wantToTest('Mvc\View\Engine\Volt\Compiler - compile()');
         $I->skipTest('Need implementation');
     }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt\Compiler :: compile() - lock
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-21
+     */
+    public function mvcViewEngineVoltCompilerCompileLock(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\Engine\Volt\Compiler - compile() - lock');
+
+        $viewFile    = dataDir('fixtures/views/layouts/compiler.volt');
+        $compileFile = $viewFile . '.php';
+
+        $I->safeDeleteFile($compileFile);
+
+        $volt = new Compiler();
+
+        $volt->setOptions(
+            [
+                'always' => true,
+            ]
+        );
+
+        $volt->compile($viewFile);
+
+        $I->assertFileExists($compileFile);
+
+        $I->assertEquals(
+            [],
+            glob($compileFile . '.*.tmp')
+        );
+
+        /**
+         * While another process holds the lock the previous version is used
+         */
+        file_put_contents($compileFile, 'previous');
+
+        $handle = fopen($compileFile . '.lock', 'c');
+        flock($handle, LOCK_EX);
+
+        $I->assertNull(
+            $volt->compile($viewFile)
+        );
+
+        $I->assertEquals(
+            'previous',
+            file_get_contents($compileFile)
+        );
+
+        flock($handle, LOCK_UN);
+        fclose($handle);
+
+        $volt->compile($viewFile);
+
+        $I->assertNotEquals(
+            'previous',
+            file_get_contents($compileFile)
+        );
+
+        /**
+         * The lock file is removed with the lock
+         */
+        $I->assertFileNotExists($compileFile . '.lock');
+
+        $I->safeDeleteFile($compileFile);
+    }
 }
@@ -13,7 +13,11 @@ declare(strict_types=1);
 namespace Phalcon\Test\Integration\Mvc\View\Engine\Volt\Compiler;
 
 use Codeception\Example;
+use function dataDir;
+use function outputDir;
 use IntegrationTester;
+use Phalcon\Di;
+use Phalcon\Escaper;
 use Phalcon\Mvc\View\Engine\Volt\Compiler;
 use Phalcon\Mvc\View\Exception;
 
@@ -45,6 +49,231 @@ class CompileStringCest
         );
     }
 
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt\Compiler :: compileString() - optimize
+     *
+     * @author       Phalcon Team <team@phalconphp.com>
+     * @since        2019-05-23
+     *
+     * @dataProvider getVoltCompileStringOptimize
+     */
+    public function mvcViewEngineVoltCompilerCompileStringOptimize(IntegrationTester $I, Example $example)
+    {
+        $I->wantToTest("Mvc\View\Engine\Volt\Compiler - compileString() - optimize");
+
+        $volt = new Compiler();
+
+        $volt->setOptions(
+            [
+                'optimize' => true,
+            ]
+        );
+
+        $I->assertEquals(
+            $example[1],
+            $volt->compileString($example[0])
+        );
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt\Compiler :: compileString() -
+     * optimize escaping
+     *
+     * @author       Phalcon Team <team@phalconphp.com>
+     * @since        2019-05-25
+     */
+    public function mvcViewEngineVoltCompilerCompileStringOptimizeEscape(IntegrationTester $I)
+    {
+        $I->wantToTest("Mvc\View\Engine\Volt\Compiler - compileString() - optimize escaping");
+
+        $escaper = new Escaper();
+        $escaper->setHtmlQuoteType(ENT_NOQUOTES);
+
+        $container = new Di();
+        $container->setShared('escaper', $escaper);
+
+        $volt = new Compiler();
+        $volt->setDI($container);
+
+        $volt->setOptions(
+            [
+                'autoescape' => true,
+                'optimize'   => true,
+            ]
+        );
+
+        $I->assertEquals(
+            '<?= htmlspecialchars($a, 0, \'utf-8\', true) ?>',
+            $volt->compileString('{{ a }}')
+        );
+
+        $I->assertEquals(
+            '<?= htmlspecialchars(htmlspecialchars($a, 3, \'utf-8\', true), 0, \'utf-8\', true) ?>',
+            $volt->compileString('{{ a|escape_attr }}')
+        );
+
+        $I->assertEquals(
+            '<?= htmlspecialchars(((is_array($a) || is_object($a)) ? count($a) : mb_strlen($a)), 0, \'utf-8\', true) ?>',
+            $volt->compileString('{{ a|length }}')
+        );
+
+        $I->assertEquals(
+            '<?= htmlspecialchars($this->length($a->b), 0, \'utf-8\', true) ?>',
+            $volt->compileString('{{ a.b|length }}')
+        );
+
+        /**
+         * Without the option the escaper service is used
+         */
+        $volt->setOption('optimize', false);
+
+        $I->assertEquals(
+            '<?= $this->escaper->escapeHtml($a) ?>',
+            $volt->compileString('{{ a }}')
+        );
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt\Compiler :: compileString() -
+     * optimize macros
+     *
+     * @author       Phalcon Team <team@phalconphp.com>
+     * @since        2019-05-26
+     */
+    public function mvcViewEngineVoltCompilerCompileStringOptimizeMacro(IntegrationTester $I)
+    {
+        $I->wantToTest("Mvc\View\Engine\Volt\Compiler - compileString() - optimize macros");
+
+        $volt = new Compiler();
+
+        $volt->setOptions(
+            [
+                'optimize' => true,
+            ]
+        );
+
+        $compilation = $volt->compileString(
+            '{% macro m(a, b = 2) %}{{ a ~ b }}{% endmacro %}'
+            . '{{ m(1) }}{{ m(b: 3, a: 4) }}{{ m() }}'
+            . '{% macro n(c = d) %}{{ c }}{% endmacro %}{{ n() }}'
+        );
+
+        $I->assertContains(
+            '<?php $this->macroFunctions[\'m\'] = function($a, $b) { ?><?= $a . $b ?><?php }; ',
+            $compilation
+        );
+        $I->assertContains(
+            'return $this->macroFunctions[\'m\']($a, $b); }; ',
+            $compilation
+        );
+
+        /**
+         * Calls resolved at compile time, the others use callMacro()
+         */
+        $I->assertContains('<?= $this->macroFunctions[\'m\'](1, 2) ?>', $compilation);
+        $I->assertContains('<?= $this->macroFunctions[\'m\'](4, 3) ?>', $compilation);
+        $I->assertContains('<?= $this->callMacro(\'m\', []) ?>', $compilation);
+        $I->assertContains('<?= $this->callMacro(\'n\', []) ?>', $compilation);
+
+        /**
+         * Macros of a previous compilation are not called directly and can
+         * be defined again
+         */
+        $I->assertEquals(
+            '<?= $this->callMacro(\'m\', [1]) ?>',
+            $volt->compileString('{{ m(1) }}')
+        );
+
+        $compilation = $volt->compileString(
+            '{% macro m(a) %}{{ a }}{% endmacro %}{{ m(null) }}'
+        );
+
+        $I->assertContains('<?= $this->macroFunctions[\'m\'](null) ?>', $compilation);
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt\Compiler :: compileString() -
+     * stringCache
+     *
+     * @author       Phalcon Team <team@phalconphp.com>
+     * @since        2019-05-24
+     */
+    public function mvcViewEngineVoltCompilerCompileStringStringCache(IntegrationTester $I)
+    {
+        $I->wantToTest("Mvc\View\Engine\Volt\Compiler - compileString() - stringCache");
+
+        $volt = new Compiler();
+
+        $volt->setOptions(
+            [
+                'stringCache' => outputDir(),
+            ]
+        );
+
+        $compiledPath = $volt->compileStringFile('{{ name }}');
+
+        $I->assertEquals($compiledPath, $volt->getCompiledTemplatePath());
+        $I->assertFileExists($compiledPath);
+        $I->assertEquals('<?= $name ?>', file_get_contents($compiledPath));
+
+        /**
+         * The stored compilation is used, without parsing the source
+         */
+        file_put_contents($compiledPath, '<?= $other ?>');
+
+        $I->assertEquals('<?= $other ?>', $volt->compileString('{{ name }}'));
+        $I->assertEquals($compiledPath, $volt->compileStringFile('{{ name }}'));
+
+        /**
+         * Other options produce other compilations
+         */
+        $volt->setOption('autoescape', true);
+
+        $I->assertEquals(
+            '<?= $this->escaper->escapeHtml($name) ?>',
+            $volt->compileString('{{ name }}')
+        );
+
+        $I->assertNotEquals($compiledPath, $volt->compileStringFile('{{ name }}'));
+
+        $I->safeDeleteFile($compiledPath);
+        $I->safeDeleteFile($volt->getCompiledTemplatePath());
+
+        /**
+         * Templates depending on other templates aren't stored
+         */
+        $volt->setOption('path', outputDir());
+
+        $I->assertNull(
+            $volt->compileStringFile(
+                "{% include '" . dataDir('fixtures/views/precompile/partial.volt') . "' %}"
+            )
+        );
+
+        /**
+         * Their compiled code is kept instead
+         */
+        $I->assertNotNull(
+            $volt->getStringCompilation()
+        );
+
+        /**
+         * The definition of a function is part of the hash, not only its name
+         */
+        $volt->setOption('autoescape', false);
+
+        $volt->addFunction('shout', 'strtoupper');
+        $compiledPath = $volt->compileStringFile('{{ shout(name) }}');
+
+        $volt->addFunction('shout', 'ucfirst');
+
+        $I->assertNotEquals($compiledPath, $volt->compileStringFile('{{ shout(name) }}'));
+        $I->assertEquals('<?= ucfirst($name) ?>', file_get_contents($volt->getCompiledTemplatePath()));
+
+        $I->safeDeleteFile($compiledPath);
+        $I->safeDeleteFile($volt->getCompiledTemplatePath());
+    }
+
     /**
      * Tests Phalcon\Mvc\View\Engine\Volt\Compiler :: compileString() - syntax
      * error
@@ -124,6 +353,7 @@ class CompileStringCest
             //Calling functions
             ['{{ content() }}', '<?= $this->getContent() ?>'],
             ['{{ get_content() }}', '<?= $this->getContent() ?>'],
+            ['{{ flush() }}', '<?php $this->flush(); ?>'],
             ["{{ partial('hello/x') }}", '<?= $this->partial(\'hello/x\') ?>'],
             ['{{ dump(a) }}', '<?= var_dump($a) ?>'],
             ["{{ date('Y-m-d', time()) }}", '<?= date(\'Y-m-d\', time()) ?>'],
@@ -252,15 +482,15 @@ class CompileStringCest
             // Cache statement
             [
                 '{% cache somekey %} hello {% endcache %}',
-                '<?php $_cache[$somekey] = $this->di->get(\'viewCache\'); $_cacheKey[$somekey] = $_cache[$somekey]->start($somekey); if ($_cacheKey[$somekey] === null) { ?> hello <?php $_cache[$somekey]->save($somekey); } else { echo $_cacheKey[$somekey]; } ?>',
+                '<?php if ($this->startCache($somekey)) { ?> hello <?php $this->saveCache(); } ?>',
             ],
             [
                 '{% set lifetime = 500 %}{% cache somekey lifetime %} hello {% endcache %}',
-                '<?php $lifetime = 500; ?><?php $_cache[$somekey] = $this->di->get(\'viewCache\'); $_cacheKey[$somekey] = $_cache[$somekey]->start($somekey, $lifetime); if ($_cacheKey[$somekey] === null) { ?> hello <?php $_cache[$somekey]->save($somekey, null, $lifetime); } else { echo $_cacheKey[$somekey]; } ?>',
+                '<?php $lifetime = 500; ?><?php if ($this->startCache($somekey, $lifetime)) { ?> hello <?php $this->saveCache(); } ?>',
             ],
             [
                 '{% cache somekey 500 %} hello {% endcache %}',
-                '<?php $_cache[$somekey] = $this->di->get(\'viewCache\'); $_cacheKey[$somekey] = $_cache[$somekey]->start($somekey, 500); if ($_cacheKey[$somekey] === null) { ?> hello <?php $_cache[$somekey]->save($somekey, null, 500); } else { echo $_cacheKey[$somekey]; } ?>',
+                '<?php if ($this->startCache($somekey, 500)) { ?> hello <?php $this->saveCache(); } ?>',
             ],
             //Autoescape mode
             [
@@ -273,6 +503,26 @@ class CompileStringCest
     }
 
 
+    private function getVoltCompileStringOptimize(): array
+    {
+        return [
+            ['{{ 1 + 2 * 3 }}', '<?= 7 ?>'],
+            ['{{ (10 - 4) / 3 }}', '<?= 2 ?>'],
+            ['{{ 10 / 0 }}', '<?= 10 / 0 ?>'],
+            ['{{ a + 1 + 2 }}', '<?= $a + 1 + 2 ?>'],
+            ['{{ 1 + 2 + a }}', '<?= 3 + $a ?>'],
+            ['{{ [1, 2 + 3]|length }}', '<?= 2 ?>'],
+            ['{{ "abc" ~ "def" }}', "<?= 'abcdef' ?>"],
+            ['{{ "abc"|upper }}', "<?= 'ABC' ?>"],
+            ['{{ " abc "|trim|length }}', '<?= 3 ?>'],
+            ['{{ a|upper }}', '<?= Phalcon\\Text::upper($a) ?>'],
+            ['{{ "a\\b"|upper }}', '<?= Phalcon\\Text::upper(\'a\\b\') ?>'],
+            ['{% set a = (-5)|abs %}', '<?php $a = 5; ?>'],
+            ['{% for i in 1..3 %}{{ i }}{% endfor %}', "<?php foreach (array (\n  0 => 1,\n  1 => 2,\n  2 => 3,\n) as \$i) { ?><?= \$i ?><?php } ?>"],
+            ['{% for i in 1..1000 %}{% endfor %}', '<?php foreach (range(1, 1000) as $i) { ?><?php } ?>'],
+        ];
+    }
+
     private function getVoltCompileStringErrors(): array
     {
         return [
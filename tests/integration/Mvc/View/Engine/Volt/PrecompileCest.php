@@ -0,0 +1,157 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\View\Engine\Volt;
+
+use IntegrationTester;
+use Phalcon\Mvc\View;
+use Phalcon\Mvc\View\Engine\Volt;
+use Phalcon\Test\Fixtures\Listener\ViewCompileListener;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+
+/**
+ * Class PrecompileCest
+ */
+class PrecompileCest
+{
+    use DiTrait;
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt :: precompile()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcViewEngineVoltPrecompile(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\Engine\Volt - precompile()');
+
+        $this->setNewFactoryDefault();
+
+        $viewsDir     = dataDir('fixtures/views/precompile/');
+        $manifestPath = outputDir('volt-manifest.php');
+
+        $I->safeDeleteFile($manifestPath);
+
+        $view = new View();
+        $view->setViewsDir($viewsDir);
+
+        $volt = new Volt($view, $this->container);
+        $volt->setOptions(
+            [
+                'path'     => outputDir(),
+                'manifest' => $manifestPath,
+            ]
+        );
+
+        $manifest = $volt->precompile();
+
+        $I->assertCount(3, $manifest);
+        $I->assertFileExists($manifestPath);
+
+        $index = $manifest[$viewsDir . 'index.volt'];
+
+        $I->assertFileExists($index['compiled']);
+
+        $I->assertEquals(
+            [
+                $viewsDir . 'layout.volt',
+                $viewsDir . 'partial.volt',
+            ],
+            array_keys($index['dependencies'])
+        );
+
+        /**
+         * Precompiled templates are rendered without compiling them
+         */
+        $eventsManager = $this->newEventsManager();
+        $listener      = new ViewCompileListener();
+        $listener->setTestCase($this, $I);
+        $eventsManager->attach('view:beforeCompile', $listener);
+
+        $volt = new Volt($view, $this->container);
+        $volt->setEventsManager($eventsManager);
+        $volt->setOptions(
+            [
+                'path'     => outputDir(),
+                'manifest' => $manifestPath,
+            ]
+        );
+
+        ob_start();
+        $volt->render($viewsDir . 'index.volt', ['name' => 'Phalcon']);
+        $actual = ob_get_clean();
+
+        $I->assertEquals('<html>Hello Phalcon!</html>', $actual);
+        $I->assertEquals('', $listener->getBefore());
+
+        /**
+         * A changed layout recompiles the templates extending it
+         */
+        $I->assertEquals($manifest, $volt->precompile());
+
+        touch($viewsDir . 'layout.volt', time() + 10);
+        clearstatcache();
+
+        $actual = $volt->precompile();
+
+        $I->assertEquals(
+            time() + 10,
+            $actual[$viewsDir . 'index.volt']['dependencies'][$viewsDir . 'layout.volt'],
+            '',
+            1
+        );
+
+        $I->safeDeleteFile($manifestPath);
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt :: precompile() - base path
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcViewEngineVoltPrecompileBasePath(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\Engine\Volt - precompile() - base path');
+
+        $this->setNewFactoryDefault();
+
+        $manifestPath = outputDir('volt-manifest.php');
+
+        $I->safeDeleteFile($manifestPath);
+
+        $view = new View();
+        $view->setBasePath(dataDir('fixtures/views/'));
+        $view->setViewsDir('precompile/');
+
+        $volt = new Volt($view, $this->container);
+        $volt->setOptions(
+            [
+                'path'     => outputDir(),
+                'manifest' => $manifestPath,
+            ]
+        );
+
+        $manifest = $volt->precompile();
+
+        /**
+         * The keys are the paths render() receives
+         */
+        $I->assertArrayHasKey(
+            dataDir('fixtures/views/precompile/index.volt'),
+            $manifest
+        );
+
+        $I->safeDeleteFile($manifestPath);
+    }
+}
@@ -0,0 +1,144 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\View\Engine\Volt;
+
+use IntegrationTester;
+use Phalcon\Mvc\View;
+use Phalcon\Mvc\View\Engine\Volt;
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\SerializerFactory;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+
+/**
+ * Class StartCacheCest
+ */
+class StartCacheCest
+{
+    use DiTrait;
+
+    /**
+     * @var Memory
+     */
+    private $cache;
+
+    /**
+     * @var Volt
+     */
+    private $volt;
+
+    public function _before(IntegrationTester $I)
+    {
+        $this->newDi();
+
+        $this->cache = new Memory(new SerializerFactory());
+        $this->container->setShared('viewCache', $this->cache);
+
+        $this->volt = new Volt(new View(), $this->container);
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt :: startCache()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function mvcViewEngineVoltStartCache(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\Engine\Volt - startCache()');
+
+        $I->assertEquals('sidebar', $this->render('sidebar', 60, 'sidebar'));
+        $I->assertEquals('sidebar', $this->render('sidebar', 60, 'changed'));
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt :: startCache() - tags
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function mvcViewEngineVoltStartCacheTags(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\Engine\Volt - startCache() - tags');
+
+        $options = [
+            'lifetime' => 60,
+            'tags'     => ['menu'],
+        ];
+
+        $I->assertEquals('menu', $this->render('menu', $options, 'menu'));
+        $I->assertEquals('menu', $this->render('menu', $options, 'changed'));
+
+        $this->volt->invalidateCacheTags(['menu']);
+
+        $I->assertEquals('changed', $this->render('menu', $options, 'changed'));
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\Engine\Volt :: startCache() - stale
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function mvcViewEngineVoltStartCacheStale(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\Engine\Volt - startCache() - stale');
+
+        $options = [
+            'lifetime' => 60,
+            'stale'    => 30,
+        ];
+
+        $this->cache->set(
+            'news',
+            [
+                'content' => 'stale',
+                'expires' => time() - 1,
+                'tags'    => [],
+            ]
+        );
+
+        /**
+         * The first request regenerates the fragment while the others keep
+         * serving the stale copy
+         */
+        ob_start();
+        $I->assertTrue(
+            $this->volt->startCache('news', $options)
+        );
+
+        $I->assertEquals('stale', $this->render('news', $options, 'other'));
+
+        echo 'fresh';
+        $this->volt->saveCache();
+        ob_end_clean();
+
+        $I->assertFalse(
+            $this->cache->has('news-lock')
+        );
+
+        $I->assertEquals('fresh', $this->render('news', $options, 'other'));
+    }
+
+    private function render(string $key, $options, string $content): string
+    {
+        ob_start();
+
+        if ($this->volt->startCache($key, $options)) {
+            echo $content;
+
+            $this->volt->saveCache();
+        }
+
+        return ob_get_clean();
+    }
+}
@@ -17,6 +17,8 @@ use IntegrationTester;
 use Phalcon\Di;
 use Phalcon\Helper\Str;
 use Phalcon\Mvc\View;
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\SerializerFactory;
 
 /**
  * Class ExistsCest
@@ -43,4 +45,54 @@ class ExistsCest
         $I->assertTrue($view->exists('currentrender/yup'));
         $I->assertFalse($view->exists('currentrender/nope'));
     }
+
+    /**
+     * Tests Phalcon\Mvc\View :: exists() - pathCache
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-21
+     */
+    public function mvcViewExistsPathCache(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View - exists() - pathCache');
+
+        $viewsDir = Str::dirSeparator(dataDir('fixtures/views'));
+        $fileName = $viewsDir . 'currentrender/later.phtml';
+        $cache    = new Memory(new SerializerFactory());
+
+        $view = new View(
+            [
+                'pathCache' => $cache,
+            ]
+        );
+        $view->setViewsDir($viewsDir);
+
+        $I->assertTrue($view->exists('currentrender/query'));
+        $I->assertFalse($view->exists('currentrender/later'));
+
+        file_put_contents($fileName, 'later');
+
+        /**
+         * Missing views are cached as well, in memory and in the cache
+         */
+        $I->assertFalse($view->exists('currentrender/later'));
+
+        $view = new View(
+            [
+                'pathCache' => $cache,
+            ]
+        );
+        $view->setViewsDir($viewsDir);
+
+        $I->assertFalse($view->exists('currentrender/later'));
+
+        /**
+         * Other directories use other entries
+         */
+        $view->setViewsDir($viewsDir . 'currentrender/../');
+
+        $I->assertTrue($view->exists('currentrender/later'));
+
+        $I->safeDeleteFile($fileName);
+    }
 }
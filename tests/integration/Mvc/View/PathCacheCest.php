@@ -0,0 +1,172 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\View;
+
+use function dataDir;
+use IntegrationTester;
+use Phalcon\Di;
+use Phalcon\Events\Manager;
+use Phalcon\Helper\Str;
+use Phalcon\Mvc\View;
+use Phalcon\Mvc\View\Engine\Php;
+use Phalcon\Mvc\View\PathCache;
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\Metrics;
+use Phalcon\Storage\SerializerFactory;
+
+/**
+ * Class PathCacheCest
+ */
+class PathCacheCest
+{
+    /**
+     * Tests Phalcon\Mvc\View :: render() - pathCache written once
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-21
+     */
+    public function mvcViewPathCacheRender(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View - render() - pathCache written once');
+
+        $metrics = new Metrics();
+        $cache   = new Memory(
+            new SerializerFactory(),
+            [
+                'metrics' => $metrics,
+            ]
+        );
+
+        $view = new View(
+            [
+                'pathCache' => $cache,
+            ]
+        );
+        $view->setDI(new Di());
+        $view->setViewsDir(Str::dirSeparator(dataDir('fixtures/views')));
+
+        $view->start();
+        $view->setLayout('pick');
+        $view->pick('currentrender/other');
+        $view->render('currentrender', 'another');
+        $view->finish();
+
+        $I->assertEquals(
+            'Well, this is the view content: here.',
+            $view->getContent()
+        );
+
+        /**
+         * All the views, layouts and templates looked up are saved together
+         */
+        $stats = $metrics->getStats();
+
+        $I->assertEquals(1, $stats['sets']);
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View :: partial() - pathCache with a cancelled file
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-21
+     */
+    public function mvcViewPathCacheFallback(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View - partial() - pathCache with a cancelled file');
+
+        $viewsDir = Str::dirSeparator(dataDir('fixtures/views'));
+        $fileName = $viewsDir . 'currentrender/yup.html';
+
+        file_put_contents($fileName, 'html');
+
+        $eventsManager = new Manager();
+        $eventsManager->attach(
+            'view:beforeRenderView',
+            function ($event, $view, $path) {
+                return !Str::endsWith($path, '.phtml');
+            }
+        );
+
+        $view = new View(
+            [
+                'pathCache' => true,
+            ]
+        );
+        $view->setDI(new Di());
+        $view->setViewsDir($viewsDir);
+        $view->setEventsManager($eventsManager);
+        $view->registerEngines(
+            [
+                '.phtml' => new Php($view),
+                '.html'  => new Php($view),
+            ]
+        );
+
+        /**
+         * The next engine having a file is used when the first is cancelled
+         */
+        ob_start();
+        $view->partial('currentrender/yup');
+        $I->assertEquals('html', ob_get_clean());
+
+        ob_start();
+        $view->partial('currentrender/yup');
+        $I->assertEquals('html', ob_get_clean());
+
+        $I->safeDeleteFile($fileName);
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View\PathCache :: save() - merged with the stored files
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-21
+     */
+    public function mvcViewPathCacheSave(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View\PathCache - save() - merged with the stored files');
+
+        $cache  = new Memory(new SerializerFactory());
+        $parts  = ['views/', ['.phtml']];
+        $first  = new PathCache($cache, $parts);
+        $second = new PathCache($cache, $parts);
+
+        $first->set('index', [['.phtml' => 'views/index.phtml']]);
+        $second->set('missing', []);
+
+        $I->assertNull($second->get('index'));
+
+        $first->save();
+        $second->save();
+
+        /**
+         * The files saved by the first cache are kept
+         */
+        $I->assertEquals(
+            [['.phtml' => 'views/index.phtml']],
+            $second->get('index')
+        );
+
+        $third = new PathCache($cache, $parts);
+
+        $I->assertEquals([], $third->get('missing'));
+        $I->assertNull($third->get('other'));
+
+        /**
+         * Other key parts are stored under another key
+         */
+        $other = new PathCache($cache, ['other/', ['.phtml']]);
+
+        $I->assertNull($other->get('index'));
+    }
+}
@@ -0,0 +1,78 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Mvc\View;
+
+use function dataDir;
+use IntegrationTester;
+use Phalcon\Di;
+use Phalcon\Helper\Str;
+use Phalcon\Mvc\View;
+
+/**
+ * Class SetStreamingCest
+ */
+class SetStreamingCest
+{
+    /**
+     * Tests Phalcon\Mvc\View :: setStreaming()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcViewSetStreaming(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View - setStreaming()');
+
+        $view = new View();
+
+        $I->assertFalse($view->isStreaming());
+
+        $view->setStreaming(true);
+
+        $I->assertTrue($view->isStreaming());
+    }
+
+    /**
+     * Tests Phalcon\Mvc\View :: setStreaming() - render
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function mvcViewSetStreamingRender(IntegrationTester $I)
+    {
+        $I->wantToTest('Mvc\View - setStreaming() - render');
+
+        $contents = [];
+
+        foreach ([false, true] as $streaming) {
+            $view = new View();
+            $view->setDI(new Di());
+            $view->setViewsDir(Str::dirSeparator(dataDir('fixtures/views')));
+            $view->setStreaming($streaming);
+            $view->setLayout('currentrender');
+            $view->setTemplateAfter('currentrender-after');
+            $view->setVar('name', 'phalcon');
+
+            $view->start();
+            $view->render('currentrender', 'query');
+            $view->finish();
+
+            $contents[] = $view->getContent();
+
+            $I->assertEquals(0, $view->getCurrentRenderLevel());
+        }
+
+        $I->assertEquals('zuplolphalcon', $contents[0]);
+        $I->assertEquals($contents[0], $contents[1]);
+    }
+}
@@ -0,0 +1,195 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Session\Adapter\Redis;
+
+use IntegrationTester;
+use Phalcon\Session\Adapter\Redis;
+use Phalcon\Session\Exception;
+use Phalcon\Storage\Adapter\Redis as StorageRedis;
+use Phalcon\Storage\AdapterFactory;
+use Phalcon\Storage\SerializerFactory;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use function array_merge;
+use function getOptionsRedis;
+use function ini_get;
+use function ini_set;
+use function uniqid;
+
+class LockingCest
+{
+    use DiTrait;
+
+    public function _before(IntegrationTester $I)
+    {
+        $this->newFactoryDefault();
+    }
+
+    /**
+     * Tests Phalcon\Session\Adapter\Redis :: read() - spin locking
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionAdapterRedisLockingSpin(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Adapter\Redis - read() - spin locking');
+        $first  = $this->newAdapter('spin');
+        $second = $this->newAdapter('spin');
+        $id     = uniqid();
+
+        $first->read($id);
+
+        $I->expectThrowable(
+            new Exception(
+                "The session '" . $id . "' could not be locked within 100ms"
+            ),
+            function () use ($second, $id) {
+                $second->read($id);
+            }
+        );
+
+        $first->write($id, 'first');
+        $first->close();
+
+        /**
+         * The lock is released with the serializer of the connection set
+         */
+        $storage = new StorageRedis(
+            new SerializerFactory(),
+            array_merge(
+                getOptionsRedis(),
+                [
+                    'prefix' => 'sess-reds-',
+                ]
+            )
+        );
+
+        $I->assertFalse($storage->has($id . '.lock'));
+
+        $expected = 'first';
+        $actual   = $second->read($id);
+        $I->assertEquals($expected, $actual);
+
+        $second->destroy($id);
+        $second->close();
+    }
+
+    /**
+     * Tests Phalcon\Session\Adapter\Redis :: write() - optimistic locking
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionAdapterRedisLockingOptimistic(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Adapter\Redis - write() - optimistic locking');
+        $handler = ini_get('session.serialize_handler');
+        ini_set('session.serialize_handler', 'php_serialize');
+
+        $first  = $this->newAdapter('optimistic');
+        $second = $this->newAdapter('optimistic');
+        $spin   = $this->newAdapter('spin');
+        $id     = uniqid();
+
+        $first->write($id, serialize(['cart' => 1, 'user' => 'a']));
+        $first->close();
+
+        /**
+         * Two requests read the same session and change different variables
+         */
+        $first->read($id);
+        $second->read($id);
+
+        $first->write($id, serialize(['cart' => 2, 'user' => 'a']));
+        $second->write($id, serialize(['cart' => 1]));
+
+        $expected = serialize(['cart' => 2]);
+        $actual   = $first->read($id);
+        $I->assertEquals($expected, $actual);
+
+        /**
+         * The write fails when the session stays locked
+         */
+        $spin->read($id);
+
+        $actual = $first->write($id, serialize(['cart' => 3]));
+        $I->assertFalse($actual);
+
+        $spin->close();
+
+        $expected = serialize(['cart' => 2]);
+        $actual   = $second->read($id);
+        $I->assertEquals($expected, $actual);
+
+        $first->destroy($id);
+
+        ini_set('session.serialize_handler', $handler);
+    }
+
+    /**
+     * Tests Phalcon\Session\Adapter\Redis :: __construct() - optimistic
+     * locking serialize handler
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionAdapterRedisLockingOptimisticHandler(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Adapter\Redis - __construct() - optimistic locking serialize handler');
+        $handler = ini_get('session.serialize_handler');
+        ini_set('session.serialize_handler', 'php');
+
+        $I->expectThrowable(
+            new Exception(
+                "The 'optimistic' locking strategy requires " .
+                "session.serialize_handler to be 'php_serialize'"
+            ),
+            function () {
+                $this->newAdapter('optimistic');
+            }
+        );
+
+        $I->assertEquals('php', ini_get('session.serialize_handler'));
+
+        ini_set('session.serialize_handler', $handler);
+    }
+
+    /**
+     * Tests Phalcon\Session\Adapter\Redis :: __construct() - unknown locking
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionAdapterRedisLockingUnknown(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Adapter\Redis - __construct() - unknown locking');
+
+        $I->expectThrowable(
+            new Exception("The locking strategy 'unknown' is not supported"),
+            function () {
+                $this->newAdapter('unknown');
+            }
+        );
+    }
+
+    private function newAdapter(string $locking): Redis
+    {
+        $factory = new AdapterFactory(new SerializerFactory());
+        $options = getOptionsRedis();
+
+        $options['locking']     = $locking;
+        $options['lockTimeout'] = 100;
+
+        return new Redis($factory, $options);
+    }
+}
@@ -0,0 +1,85 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Session\Adapter\Stream;
+
+use function cacheDir;
+use IntegrationTester;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use Phalcon\Test\Fixtures\Traits\SessionTrait;
+use function uniqid;
+
+class UpdateTimestampCest
+{
+    use DiTrait;
+    use SessionTrait;
+
+    public function _before(IntegrationTester $I)
+    {
+        $this->newFactoryDefault();
+    }
+
+    /**
+     * Tests Phalcon\Session\Adapter\Stream :: write() - unchanged
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionAdapterStreamWriteUnchanged(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Adapter\Stream - write() - unchanged');
+        $adapter = $this->getSessionStream();
+        $value   = uniqid();
+        $file    = cacheDir('sessions/test1');
+
+        file_put_contents($file, $value);
+        touch($file, time() - 100);
+
+        $I->assertEquals($value, $adapter->read('test1'));
+
+        /**
+         * An unchanged payload only updates the modification time
+         */
+        $actual = $adapter->write('test1', $value);
+        $I->assertTrue($actual);
+
+        clearstatcache();
+        $I->assertGreaterThan(time() - 100, filemtime($file));
+
+        /**
+         * A changed one is written
+         */
+        $value  = uniqid();
+        $actual = $adapter->write('test1', $value);
+        $I->assertTrue($actual);
+
+        $I->amInPath(cacheDir('sessions'));
+        $I->seeFileFound('test1');
+        $I->seeInThisFile($value);
+        $I->safeDeleteFile($file);
+    }
+
+    /**
+     * Tests Phalcon\Session\Adapter\Stream :: validateId()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionAdapterStreamValidateId(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Adapter\Stream - validateId()');
+        $adapter = $this->getSessionStream();
+
+        $actual = $adapter->validateId('unknown-' . uniqid());
+        $I->assertFalse($actual);
+    }
+}
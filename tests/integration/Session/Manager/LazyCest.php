@@ -0,0 +1,75 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Integration\Session\Manager;
+
+use IntegrationTester;
+use Phalcon\Session\Manager;
+use Phalcon\Test\Fixtures\Traits\DiTrait;
+use Phalcon\Test\Fixtures\Traits\SessionTrait;
+
+class LazyCest
+{
+    use DiTrait;
+    use SessionTrait;
+
+    /**
+     * Tests Phalcon\Session\Manager :: start() - lazy
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-20
+     */
+    public function sessionManagerLazy(IntegrationTester $I)
+    {
+        $I->wantToTest('Session\Manager - start() - lazy');
+        $manager = new Manager(
+            [
+                'lazy' => true,
+            ]
+        );
+        $files   = $this->getSessionStream();
+        $manager->setHandler($files);
+
+        $actual = $manager->start();
+        $I->assertTrue($actual);
+
+        /**
+         * Reading without a session does not start it
+         */
+        $actual = $manager->has('test');
+        $I->assertFalse($actual);
+
+        $expected = 'default';
+        $actual   = $manager->get('test', 'default');
+        $I->assertEquals($expected, $actual);
+
+        $actual = $manager->exists();
+        $I->assertFalse($actual);
+
+        /**
+         * Writing starts it
+         */
+        $manager->set('test', 'myval');
+
+        $actual = $manager->exists();
+        $I->assertTrue($actual);
+
+        $expected = 'myval';
+        $actual   = $manager->get('test');
+        $I->assertEquals($expected, $actual);
+
+        $manager->destroy();
+
+        $actual = $manager->exists();
+        $I->assertFalse($actual);
+    }
+}
@@ -44,7 +44,7 @@ class GetSetCest
         $target = outputDir() . 'phstrm-/te/st/-k/';
         $I->amInPath($target);
         $I->openFile('test-key');
-        $expected = '"ttl":3600,"content":"s:17:\"Phalcon Framework\";';
+        $expected = 's:17:"Phalcon Framework";';
         $I->seeInThisFile($expected);
         $I->safeDeleteFile($target . 'test-key');
     }
@@ -99,7 +99,7 @@ class GetSetCest
         $actual   = $adapter->get('unknown', 'test');
         $I->assertEquals($expected, $actual);
 
-        // Invalid JSON object
+        // Invalid header
         $result = file_put_contents($target . 'test-key', '{');
         $I->assertNotFalse($result);
 
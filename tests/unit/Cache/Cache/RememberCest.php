@@ -0,0 +1,196 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Cache\Cache;
+
+use Phalcon\Cache\AdapterFactory;
+use Phalcon\Cache\Cache;
+use Phalcon\Cache\Exception\InvalidArgumentException;
+use Phalcon\Storage\SerializerFactory;
+use function uniqid;
+use UnitTester;
+
+class RememberCest
+{
+    /**
+     * Tests Phalcon\Cache\Cache :: remember()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-23
+     */
+    public function cacheCacheRemember(UnitTester $I)
+    {
+        $I->wantToTest('Cache\Cache - remember()');
+
+        $serializer = new SerializerFactory();
+        $factory    = new AdapterFactory($serializer);
+        $instance   = $factory->newInstance('memory');
+
+        $adapter = new Cache($instance);
+
+        $key   = uniqid();
+        $calls = 0;
+
+        $callback = function () use (&$calls) {
+            $calls++;
+
+            return 'computed';
+        };
+
+        $actual = $adapter->remember($key, 60, $callback, ['beta' => 0]);
+        $I->assertEquals('computed', $actual);
+
+        $actual = $adapter->remember($key, 60, $callback, ['beta' => 0]);
+        $I->assertEquals('computed', $actual);
+
+        $I->assertEquals(1, $calls);
+
+        /**
+         * The value is stored as it is, its meta data under another key
+         */
+        $I->assertEquals('computed', $adapter->get($key));
+        $I->assertEquals(
+            [$key => 'computed'],
+            $adapter->getMultiple([$key])
+        );
+        $I->assertTrue($adapter->has($key . '-meta'));
+
+        /**
+         * The lock is released
+         */
+        $I->assertFalse(
+            $adapter->has($key . '-lock')
+        );
+
+        /**
+         * Values stored with set() are returned as they are
+         */
+        $adapter->set($key, 'stored');
+
+        $actual = $adapter->remember($key, 60, $callback);
+        $I->assertEquals('stored', $actual);
+        $I->assertEquals(1, $calls);
+
+        /**
+         * Arrays looking like meta data are values too
+         */
+        $key    = uniqid();
+        $stored = [
+            'value'   => 'stored',
+            'delta'   => 1,
+            'expires' => 1,
+        ];
+
+        $adapter->set($key, $stored);
+
+        $actual = $adapter->remember($key, 60, $callback);
+        $I->assertEquals($stored, $actual);
+        $I->assertEquals(1, $calls);
+    }
+
+    /**
+     * Tests Phalcon\Cache\Cache :: remember() - locked
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-23
+     */
+    public function cacheCacheRememberLocked(UnitTester $I)
+    {
+        $I->wantToTest('Cache\Cache - remember() - locked');
+
+        $serializer = new SerializerFactory();
+        $factory    = new AdapterFactory($serializer);
+        $instance   = $factory->newInstance('memory');
+
+        $adapter = new Cache($instance);
+
+        $key = uniqid();
+
+        /**
+         * Expired value kept as stale
+         */
+        $adapter->remember(
+            $key,
+            -1,
+            function () {
+                return 'old';
+            },
+            ['stale' => 60]
+        );
+
+        /**
+         * Another caller is computing the value
+         */
+        $instance->add($key . '-lock', 1);
+
+        $actual = $adapter->remember(
+            $key,
+            60,
+            function () {
+                return 'new';
+            },
+            ['stale' => 60]
+        );
+        $I->assertEquals('old', $actual);
+
+        $instance->delete($key . '-lock');
+
+        $actual = $adapter->remember(
+            $key,
+            60,
+            function () {
+                return 'new';
+            },
+            ['stale' => 60]
+        );
+        $I->assertEquals('new', $actual);
+
+        /**
+         * Nothing to serve: the value is computed after waiting
+         */
+        $adapter->delete($key);
+        $instance->add($key . '-lock', 1);
+
+        $actual = $adapter->remember(
+            $key,
+            60,
+            function () {
+                return 'waited';
+            },
+            ['wait' => 50]
+        );
+        $I->assertEquals('waited', $actual);
+    }
+
+    /**
+     * Tests Phalcon\Cache\Cache :: remember() - exception
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-23
+     */
+    public function cacheCacheRememberException(UnitTester $I)
+    {
+        $I->wantToTest('Cache\Cache - remember() - exception');
+
+        $I->expectThrowable(
+            new InvalidArgumentException('The callback is not callable'),
+            function () {
+                $serializer = new SerializerFactory();
+                $factory    = new AdapterFactory($serializer);
+                $instance   = $factory->newInstance('memory');
+
+                $adapter = new Cache($instance);
+                $adapter->remember('key', 60, 'unknown-function');
+            }
+        );
+    }
+}
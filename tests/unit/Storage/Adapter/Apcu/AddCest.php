@@ -0,0 +1,61 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Apcu;
+
+use Phalcon\Storage\Adapter\Apcu;
+use Phalcon\Storage\SerializerFactory;
+use Phalcon\Test\Fixtures\Traits\ApcuTrait;
+use UnitTester;
+
+class AddCest
+{
+    use ApcuTrait;
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Apcu :: add()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-23
+     */
+    public function storageAdapterApcuAdd(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Apcu - add()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Apcu($serializer);
+
+        $key = 'cache-add';
+        $adapter->delete($key);
+
+        $actual = $adapter->add($key, 'first');
+        $I->assertTrue($actual);
+
+        $actual = $adapter->add($key, 'second');
+        $I->assertFalse($actual);
+
+        $expected = 'first';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+
+        $actual = $adapter->add($key, 'second');
+        $I->assertTrue($actual);
+
+        $expected = 'second';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+    }
+}
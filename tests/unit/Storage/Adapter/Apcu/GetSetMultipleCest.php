@@ -0,0 +1,100 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Apcu;
+
+use Phalcon\Storage\Adapter\Apcu;
+use Phalcon\Storage\SerializerFactory;
+use Phalcon\Test\Fixtures\Traits\ApcuTrait;
+use UnitTester;
+
+class GetSetMultipleCest
+{
+    use ApcuTrait;
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Apcu :: getMultiple()/setMultiple()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function storageAdapterApcuGetSetMultiple(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Apcu - getMultiple()/setMultiple()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Apcu($serializer);
+
+        $actual = $adapter->setMultiple(
+            [
+                'multi-one'   => 'test1',
+                'multi-two'   => ['test' => 2],
+                'multi-three' => 3,
+            ]
+        );
+        $I->assertTrue($actual);
+
+        $expected = [
+            'multi-one'     => 'test1',
+            'multi-two'     => ['test' => 2],
+            'multi-three'   => 3,
+            'multi-unknown' => 'default-unknown',
+        ];
+        $actual   = $adapter->getMultiple(
+            [
+                'multi-one',
+                'multi-two',
+                'multi-three',
+                'multi-unknown',
+            ],
+            'default-unknown'
+        );
+        $I->assertEquals($expected, $actual);
+
+        $actual = $adapter->getMultiple([]);
+        $I->assertEquals([], $actual);
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Apcu :: deleteMultiple()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function storageAdapterApcuDeleteMultiple(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Apcu - deleteMultiple()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Apcu($serializer);
+
+        $adapter->setMultiple(
+            [
+                'multi-one'   => 'test1',
+                'multi-two'   => 'test2',
+                'multi-three' => 'test3',
+            ]
+        );
+
+        $actual = $adapter->deleteMultiple(['multi-one', 'multi-two']);
+        $I->assertTrue($actual);
+
+        $I->assertFalse($adapter->has('multi-one'));
+        $I->assertFalse($adapter->has('multi-two'));
+        $I->assertTrue($adapter->has('multi-three'));
+
+        $actual = $adapter->deleteMultiple(['multi-one', 'multi-three']);
+        $I->assertFalse($actual);
+
+        $I->assertFalse($adapter->has('multi-three'));
+    }
+}
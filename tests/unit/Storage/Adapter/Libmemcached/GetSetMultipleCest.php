@@ -0,0 +1,101 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Libmemcached;
+
+use function getOptionsLibmemcached;
+use Phalcon\Storage\Adapter\Libmemcached;
+use Phalcon\Storage\SerializerFactory;
+use Phalcon\Test\Fixtures\Traits\LibmemcachedTrait;
+use UnitTester;
+
+class GetSetMultipleCest
+{
+    use LibmemcachedTrait;
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Libmemcached :: getMultiple()/setMultiple()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function storageAdapterLibmemcachedGetSetMultiple(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Libmemcached - getMultiple()/setMultiple()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Libmemcached($serializer, getOptionsLibmemcached());
+
+        $actual = $adapter->setMultiple(
+            [
+                'multi-one'   => 'test1',
+                'multi-two'   => ['test' => 2],
+                'multi-three' => 3,
+            ]
+        );
+        $I->assertTrue($actual);
+
+        $expected = [
+            'multi-one'     => 'test1',
+            'multi-two'     => ['test' => 2],
+            'multi-three'   => 3,
+            'multi-unknown' => 'default-unknown',
+        ];
+        $actual   = $adapter->getMultiple(
+            [
+                'multi-one',
+                'multi-two',
+                'multi-three',
+                'multi-unknown',
+            ],
+            'default-unknown'
+        );
+        $I->assertEquals($expected, $actual);
+
+        $actual = $adapter->getMultiple([]);
+        $I->assertEquals([], $actual);
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Libmemcached :: deleteMultiple()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-22
+     */
+    public function storageAdapterLibmemcachedDeleteMultiple(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Libmemcached - deleteMultiple()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Libmemcached($serializer, getOptionsLibmemcached());
+
+        $adapter->setMultiple(
+            [
+                'multi-one'   => 'test1',
+                'multi-two'   => 'test2',
+                'multi-three' => 'test3',
+            ]
+        );
+
+        $actual = $adapter->deleteMultiple(['multi-one', 'multi-two']);
+        $I->assertTrue($actual);
+
+        $I->assertFalse($adapter->has('multi-one'));
+        $I->assertFalse($adapter->has('multi-two'));
+        $I->assertTrue($adapter->has('multi-three'));
+
+        $actual = $adapter->deleteMultiple(['multi-one', 'multi-three']);
+        $I->assertFalse($actual);
+
+        $I->assertFalse($adapter->has('multi-three'));
+    }
+}
@@ -0,0 +1,118 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Memory;
+
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\Metrics;
+use Phalcon\Storage\SerializerFactory;
+use stdClass;
+use UnitTester;
+
+class MetricsCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Memory :: getMetrics()/setMetrics()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageAdapterMemoryGetSetMetrics(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Memory - getMetrics()/setMetrics()');
+
+        $serializer = new SerializerFactory();
+        $metrics    = new Metrics();
+        $adapter    = new Memory($serializer);
+
+        $I->assertNull($adapter->getMetrics());
+
+        $adapter->setMetrics($metrics);
+        $I->assertSame($metrics, $adapter->getMetrics());
+
+        $adapter->setMetrics(null);
+        $I->assertNull($adapter->getMetrics());
+
+        $adapter = new Memory($serializer, ['metrics' => $metrics]);
+        $I->assertSame($metrics, $adapter->getMetrics());
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Memory :: metrics - operations
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageAdapterMemoryMetricsOperations(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Memory - metrics - operations');
+
+        $metrics = new Metrics();
+        $adapter = new Memory(
+            new SerializerFactory(),
+            [
+                'metrics' => $metrics,
+            ]
+        );
+
+        $adapter->set('products-1', 'Phalcon');
+        $adapter->get('products-1');
+        $adapter->get('products-2');
+        $adapter->has('products-1');
+        $adapter->delete('products-1');
+
+        $stats = $metrics->getStats();
+
+        $I->assertEquals(1, $stats['hits']);
+        $I->assertEquals(1, $stats['misses']);
+        $I->assertEquals(1, $stats['sets']);
+        $I->assertEquals(1, $stats['deletes']);
+
+        $serialized = strlen(serialize('Phalcon'));
+        $I->assertEquals($serialized, $stats['bytesOut']);
+        $I->assertEquals($serialized, $stats['bytesIn']);
+        $I->assertGreaterThanOrEqual(0, $stats['serializationTime']);
+
+        foreach (['get' => 2, 'set' => 1, 'has' => 1, 'delete' => 1] as $operation => $count) {
+            $I->assertEquals(
+                $count,
+                $stats['operations'][$operation]['products']['count']
+            );
+        }
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Memory :: metrics - exception
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageAdapterMemoryMetricsException(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Memory - metrics - exception');
+
+        $I->expectThrowable(
+            new Exception(
+                "The 'metrics' option must be an instance of Phalcon\Storage\Metrics"
+            ),
+            function () {
+                $adapter = new Memory(
+                    new SerializerFactory(),
+                    [
+                        'metrics' => new stdClass(),
+                    ]
+                );
+            }
+        );
+    }
+}
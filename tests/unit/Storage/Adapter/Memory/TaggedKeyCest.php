@@ -0,0 +1,64 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Memory;
+
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\SerializerFactory;
+use UnitTester;
+
+class TaggedKeyCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Memory :: getTaggedKey()/invalidateTags()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageAdapterMemoryTaggedKey(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Memory - getTaggedKey()/invalidateTags()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Memory($serializer);
+
+        $I->assertEquals('product', $adapter->getTaggedKey('product', []));
+
+        $product = $adapter->getTaggedKey('product', ['products', 'prices']);
+        $user    = $adapter->getTaggedKey('user', ['users']);
+
+        $I->assertStringStartsWith('product-', $product);
+        $I->assertNotEquals('product', $product);
+
+        /**
+         * Same versions, same key, whatever the order of the tags
+         */
+        $I->assertEquals(
+            $product,
+            $adapter->getTaggedKey('product', ['prices', 'products'])
+        );
+
+        $adapter->set($product, 'product');
+        $adapter->set($user, 'user');
+
+        $actual = $adapter->invalidateTags(['prices']);
+        $I->assertTrue($actual);
+
+        $key = $adapter->getTaggedKey('product', ['products', 'prices']);
+        $I->assertNotEquals($product, $key);
+        $I->assertNull($adapter->get($key));
+
+        $key = $adapter->getTaggedKey('user', ['users']);
+        $I->assertEquals($user, $key);
+        $I->assertEquals('user', $adapter->get($key));
+    }
+}
@@ -0,0 +1,74 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Redis;
+
+use function getOptionsRedis;
+use Phalcon\Storage\Adapter\Redis;
+use Phalcon\Storage\SerializerFactory;
+use Phalcon\Test\Fixtures\Traits\RedisTrait;
+use UnitTester;
+
+class AddCest
+{
+    use RedisTrait;
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Redis :: add()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-23
+     */
+    public function storageAdapterRedisAdd(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Redis - add()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Redis($serializer, getOptionsRedis());
+
+        $key = 'cache-add';
+        $adapter->delete($key);
+
+        $actual = $adapter->add($key, 'first');
+        $I->assertTrue($actual);
+
+        $actual = $adapter->add($key, 'second');
+        $I->assertFalse($actual);
+
+        $expected = 'first';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+
+        $actual = $adapter->add($key, 'second');
+        $I->assertTrue($actual);
+
+        $expected = 'second';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+
+        /**
+         * A TTL of zero stores the key without expiration
+         */
+        $actual = $adapter->add($key, 'third', 0);
+        $I->assertTrue($actual);
+
+        $expected = 'third';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+    }
+}
@@ -84,4 +84,46 @@ class ClearCest
         $actual = $adapter->clear();
         $I->assertTrue($actual);
     }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Redis :: clear() - prefix
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageAdapterRedisClearPrefix(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Redis - clear() - prefix');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Redis(
+            $serializer,
+            array_merge(getOptionsRedis(), ['prefix' => 'ph-clear-'])
+        );
+        $other      = new Redis(
+            $serializer,
+            array_merge(getOptionsRedis(), ['prefix' => 'ph-other-'])
+        );
+
+        $adapter->setMultiple(
+            [
+                'key-1' => 'test',
+                'key-2' => 'test',
+            ]
+        );
+        $other->set('key-1', 'other');
+
+        $actual = $adapter->clear();
+        $I->assertTrue($actual);
+
+        $I->assertFalse($adapter->has('key-1'));
+        $I->assertFalse($adapter->has('key-2'));
+        $I->assertEquals([], $adapter->getKeys());
+
+        $expected = 'other';
+        $actual   = $other->get('key-1');
+        $I->assertEquals($expected, $actual);
+
+        $other->clear();
+    }
 }
@@ -0,0 +1,106 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Shm;
+
+use function outputDir;
+use Phalcon\Storage\Adapter\AdapterInterface;
+use Phalcon\Storage\Adapter\Shm;
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\SerializerFactory;
+use UnitTester;
+
+class ConstructCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: __construct()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmConstruct(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - __construct()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Shm(
+            $serializer,
+            [
+                'file' => outputDir('shm.cache'),
+            ]
+        );
+
+        $class = Shm::class;
+        $I->assertInstanceOf($class, $adapter);
+
+        $class = AdapterInterface::class;
+        $I->assertInstanceOf($class, $adapter);
+
+        $I->assertFileExists(outputDir('shm.cache'));
+
+        $I->assertInternalType('int', $adapter->getAdapter());
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: __construct() - shared
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmConstructShared(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - __construct() - shared');
+
+        $serializer = new SerializerFactory();
+        $options    = [
+            'file' => outputDir('shm.cache'),
+        ];
+
+        $first  = new Shm($serializer, $options);
+        $second = new Shm($serializer, $options);
+
+        $I->assertTrue($first->set('shared', 'Phalcon'));
+        $I->assertEquals('Phalcon', $second->get('shared'));
+
+        $first->delete('shared');
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: __construct() - exception
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmConstructException(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - __construct() - exception');
+
+        $file = outputDir('shm-small.cache');
+
+        $I->expectThrowable(
+            new Exception(
+                "The shared memory file '" . $file . "' could not be opened"
+            ),
+            function () use ($file) {
+                $adapter = new Shm(
+                    new SerializerFactory(),
+                    [
+                        'file' => $file,
+                        'size' => 1024,
+                    ]
+                );
+            }
+        );
+
+        $I->safeDeleteFile($file);
+    }
+}
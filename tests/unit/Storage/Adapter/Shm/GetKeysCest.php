@@ -0,0 +1,65 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Shm;
+
+use function outputDir;
+use Phalcon\Storage\Adapter\Shm;
+use Phalcon\Storage\SerializerFactory;
+use UnitTester;
+
+class GetKeysCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: getKeys()/clear()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmGetKeysClear(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - getKeys()/clear()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Shm($serializer, ['file' => outputDir('shm.cache')]);
+        $other      = new Shm(
+            $serializer,
+            [
+                'file'   => outputDir('shm.cache'),
+                'prefix' => 'other-',
+            ]
+        );
+
+        $adapter->clear();
+        $other->set('key', 'other');
+
+        $adapter->set('key-1', 'test');
+        $adapter->set('key-2', 'test');
+
+        $expected = [
+            'ph-shm-key-1',
+            'ph-shm-key-2',
+        ];
+        $actual   = $adapter->getKeys();
+        sort($actual);
+        $I->assertEquals($expected, $actual);
+
+        /**
+         * Only the keys of the prefix are cleared
+         */
+        $I->assertTrue($adapter->clear());
+        $I->assertEquals([], $adapter->getKeys());
+        $I->assertEquals('other', $other->get('key'));
+
+        $other->clear();
+    }
+}
@@ -0,0 +1,144 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Shm;
+
+use Codeception\Example;
+use function outputDir;
+use Phalcon\Storage\Adapter\Shm;
+use Phalcon\Storage\SerializerFactory;
+use stdClass;
+use UnitTester;
+
+class GetSetCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: get()/set()
+     *
+     * @dataProvider getExamples
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmGetSet(UnitTester $I, Example $example)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - get()/set() - ' . $example[0]);
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Shm($serializer, ['file' => outputDir('shm.cache')]);
+
+        $key = uniqid();
+
+        $result = $adapter->set($key, $example[1]);
+        $I->assertTrue($result);
+
+        $I->assertTrue($adapter->has($key));
+        $I->assertEquals($example[1], $adapter->get($key));
+
+        $I->assertTrue($adapter->delete($key));
+        $I->assertFalse($adapter->has($key));
+        $I->assertEquals('default', $adapter->get($key, 'default'));
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: add()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmAdd(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - add()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Shm($serializer, ['file' => outputDir('shm.cache')]);
+
+        $key = uniqid();
+
+        $I->assertTrue($adapter->add($key, 'first'));
+        $I->assertFalse($adapter->add($key, 'second'));
+        $I->assertEquals('first', $adapter->get($key));
+
+        /**
+         * Expired keys can be added again
+         */
+        $adapter->set($key, 'expired', -10);
+        $I->assertFalse($adapter->has($key));
+        $I->assertTrue($adapter->add($key, 'third'));
+        $I->assertEquals('third', $adapter->get($key));
+
+        $adapter->delete($key);
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: set() - eviction
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmSetEviction(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - set() - eviction');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Shm(
+            $serializer,
+            [
+                'file' => outputDir('shm-eviction.cache'),
+                'size' => 4 * 1024 * 1024,
+            ]
+        );
+
+        /**
+         * Ten times the size of the file
+         */
+        $value = str_repeat('x', 10000);
+        for ($counter = 0; $counter < 4000; $counter++) {
+            $I->assertTrue($adapter->set('key-' . $counter, $value));
+        }
+
+        $I->assertEquals($value, $adapter->get('key-3999'));
+        $I->assertLessThan(4000, count($adapter->getKeys()));
+
+        $I->safeDeleteFile(outputDir('shm-eviction.cache'));
+    }
+
+    private function getExamples(): array
+    {
+        return [
+            [
+                'string',
+                'Phalcon Framework',
+            ],
+            [
+                'integer',
+                123456,
+            ],
+            [
+                'float',
+                123.456,
+            ],
+            [
+                'boolean',
+                true,
+            ],
+            [
+                'array',
+                ['Phalcon', 'Framework'],
+            ],
+            [
+                'object',
+                new stdClass(),
+            ],
+        ];
+    }
+}
@@ -0,0 +1,64 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Shm;
+
+use function outputDir;
+use Phalcon\Storage\Adapter\Shm;
+use Phalcon\Storage\SerializerFactory;
+use UnitTester;
+
+class IncrementCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Shm :: increment()/decrement()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterShmIncrementDecrement(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Shm - increment()/decrement()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Shm($serializer, ['file' => outputDir('shm.cache')]);
+
+        $key    = 'cache-data';
+        $result = $adapter->set($key, 1);
+        $I->assertTrue($result);
+
+        $expected = 2;
+        $actual   = $adapter->increment($key);
+        $I->assertEquals($expected, $actual);
+
+        $expected = 10;
+        $actual   = $adapter->increment($key, 8);
+        $I->assertEquals($expected, $actual);
+
+        $expected = 7;
+        $actual   = $adapter->decrement($key, 3);
+        $I->assertEquals($expected, $actual);
+
+        $actual = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        /**
+         * unknown key and serialized values
+         */
+        $I->assertFalse($adapter->increment('unknown'));
+
+        $adapter->set($key, 'text');
+        $I->assertFalse($adapter->increment($key));
+
+        $adapter->delete($key);
+    }
+}
@@ -0,0 +1,59 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Stream;
+
+use function outputDir;
+use Phalcon\Storage\Adapter\Stream;
+use Phalcon\Storage\SerializerFactory;
+use UnitTester;
+
+class AddCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Stream :: add()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-23
+     */
+    public function storageAdapterStreamAdd(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Stream - add()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Stream($serializer, ['cacheDir' => outputDir()]);
+
+        $key = 'cache-add';
+        $adapter->delete($key);
+
+        $actual = $adapter->add($key, 'first');
+        $I->assertTrue($actual);
+
+        $actual = $adapter->add($key, 'second');
+        $I->assertFalse($actual);
+
+        $expected = 'first';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+
+        $actual = $adapter->add($key, 'second');
+        $I->assertTrue($actual);
+
+        $expected = 'second';
+        $actual   = $adapter->get($key);
+        $I->assertEquals($expected, $actual);
+
+        $adapter->delete($key);
+    }
+}
@@ -57,5 +57,19 @@ class ConstructCest
                 $adapter    = new Stream($serializer);
             }
         );
+
+        $I->expectThrowable(
+            new Exception("The 'format' must be 'binary' or 'php'"),
+            function () {
+                $serializer = new SerializerFactory();
+                $adapter    = new Stream(
+                    $serializer,
+                    [
+                        'cacheDir' => outputDir(),
+                        'format'   => 'json',
+                    ]
+                );
+            }
+        );
     }
 }
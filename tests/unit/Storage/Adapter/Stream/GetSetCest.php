@@ -44,7 +44,7 @@ class GetSetCest
         $target = outputDir() . 'phstrm-/te/st/-k/';
         $I->amInPath($target);
         $I->openFile('test-key');
-        $expected = '"ttl":3600,"content":"s:17:\"Phalcon Framework\";';
+        $expected = 's:17:"Phalcon Framework";';
         $I->seeInThisFile($expected);
         $I->safeDeleteFile($target . 'test-key');
     }
@@ -99,7 +99,7 @@ class GetSetCest
         $actual   = $adapter->get('unknown', 'test');
         $I->assertEquals($expected, $actual);
 
-        // Invalid JSON object
+        // Invalid header
         $result = file_put_contents($target . 'test-key', '{');
         $I->assertNotFalse($result);
 
@@ -120,4 +120,81 @@ class GetSetCest
 
         $I->safeDeleteFile($target . 'test-key');
     }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Stream :: get()/set() - php format
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-25
+     */
+    public function storageAdapterStreamGetSetPhpFormat(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Stream - get()/set() - php format');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Stream(
+            $serializer,
+            [
+                'cacheDir' => outputDir(),
+                'format'   => 'php',
+            ]
+        );
+
+        $data   = [
+            'name'   => 'Phalcon Framework',
+            'active' => false,
+        ];
+        $result = $adapter->set('test-key', $data);
+        $I->assertTrue($result);
+
+        $target = outputDir() . 'phstrm-/te/st/-k/';
+        $I->amInPath($target);
+        $I->openFile('test-key.php');
+        $I->seeInThisFile('<?php return array');
+
+        $actual = $adapter->get('test-key');
+        $I->assertEquals($data, $actual);
+
+        $I->assertTrue($adapter->has('test-key'));
+
+        $adapter->set('test-key', 0);
+
+        $actual = $adapter->get('test-key', 'default');
+        $I->assertSame(0, $actual);
+
+        $actual = $adapter->increment('test-key', 5);
+        $I->assertSame(5, $actual);
+
+        $I->assertFileNotExists($target . 'test-key.php.lock');
+
+        $I->assertEquals(['phstrm-test-key'], $adapter->getKeys());
+
+        /**
+         * Items of the binary format are not run
+         */
+        $binary = new Stream(
+            $serializer,
+            [
+                'cacheDir' => outputDir(),
+            ]
+        );
+
+        $binary->set('test-key', 'binary');
+
+        $I->safeDeleteFile($target . 'test-key.php');
+        $I->writeToFile($target . 'test-key.php', 'PHS1 not a php file');
+
+        ob_start();
+        $actual = $adapter->get('test-key', 'default');
+        $output = ob_get_clean();
+
+        $I->assertEquals('default', $actual);
+        $I->assertEquals('', $output);
+        $I->assertFalse($adapter->has('test-key'));
+
+        $I->assertEquals('binary', $binary->get('test-key'));
+
+        $I->safeDeleteFile($target . 'test-key');
+        $I->safeDeleteFile($target . 'test-key.php');
+    }
 }
@@ -0,0 +1,119 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Tiered;
+
+use Phalcon\Storage\Adapter\AdapterInterface;
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\Adapter\Tiered;
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\SerializerFactory;
+use stdClass;
+use UnitTester;
+
+class ConstructCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Tiered :: __construct()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-24
+     */
+    public function storageAdapterTieredConstruct(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Tiered - __construct()');
+
+        $serializer = new SerializerFactory();
+        $adapter    = new Tiered(
+            $serializer,
+            [
+                'adapters'  => [
+                    new Memory($serializer),
+                    new Memory($serializer),
+                ],
+                'lifetimes' => [5],
+            ]
+        );
+
+        $class = Tiered::class;
+        $I->assertInstanceOf($class, $adapter);
+
+        $class = AdapterInterface::class;
+        $I->assertInstanceOf($class, $adapter);
+
+        $I->assertCount(2, $adapter->getAdapter());
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Tiered :: __construct() - exception
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-24
+     */
+    public function storageAdapterTieredConstructException(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Tiered - __construct() - exception');
+
+        $I->expectThrowable(
+            new Exception("The 'adapters' must be specified in the options"),
+            function () {
+                $adapter = new Tiered(new SerializerFactory());
+            }
+        );
+
+        $I->expectThrowable(
+            new Exception(
+                'The tiers must implement Phalcon\Storage\Adapter\AdapterInterface'
+            ),
+            function () {
+                $adapter = new Tiered(
+                    new SerializerFactory(),
+                    [
+                        'adapters' => [new stdClass()],
+                    ]
+                );
+            }
+        );
+
+        $I->expectThrowable(
+            new Exception("The 'writeMode' must be 'through' or 'around'"),
+            function () {
+                $serializer = new SerializerFactory();
+                $adapter    = new Tiered(
+                    $serializer,
+                    [
+                        'adapters'  => [new Memory($serializer)],
+                        'writeMode' => 'back',
+                    ]
+                );
+            }
+        );
+
+        $I->expectThrowable(
+            new Exception(
+                "The 'lifetimes' must be set for every tier except the last one"
+            ),
+            function () {
+                $serializer = new SerializerFactory();
+                $adapter    = new Tiered(
+                    $serializer,
+                    [
+                        'adapters' => [
+                            new Memory($serializer),
+                            new Memory($serializer),
+                        ],
+                    ]
+                );
+            }
+        );
+    }
+}
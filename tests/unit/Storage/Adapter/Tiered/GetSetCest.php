@@ -0,0 +1,176 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Adapter\Tiered;
+
+use Phalcon\Storage\Adapter\Memory;
+use Phalcon\Storage\Adapter\Tiered;
+use Phalcon\Storage\SerializerFactory;
+use UnitTester;
+
+class GetSetCest
+{
+    /**
+     * Tests Phalcon\Storage\Adapter\Tiered :: get()/set()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-24
+     */
+    public function storageAdapterTieredGetSet(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Tiered - get()/set()');
+
+        $serializer = new SerializerFactory();
+        $local      = new Memory($serializer);
+        $shared     = new Memory($serializer);
+        $adapter    = new Tiered(
+            $serializer,
+            [
+                'adapters'  => [$local, $shared],
+                'lifetimes' => [5],
+            ]
+        );
+
+        $actual = $adapter->set('tiered-key', 'test');
+        $I->assertTrue($actual);
+
+        $I->assertEquals('test', $local->get('tiered-key'));
+        $I->assertEquals('test', $shared->get('tiered-key'));
+
+        /**
+         * Falls through and fills the upper tier
+         */
+        $local->delete('tiered-key');
+
+        $actual = $adapter->get('tiered-key');
+        $I->assertEquals('test', $actual);
+        $I->assertEquals('test', $local->get('tiered-key'));
+
+        $actual = $adapter->get('unknown', 'default');
+        $I->assertEquals('default', $actual);
+
+        $actual = $adapter->delete('tiered-key');
+        $I->assertTrue($actual);
+
+        $I->assertFalse($local->has('tiered-key'));
+        $I->assertFalse($shared->has('tiered-key'));
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Tiered :: get()/set() - write around
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-24
+     */
+    public function storageAdapterTieredGetSetAround(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Tiered - get()/set() - write around');
+
+        $serializer = new SerializerFactory();
+        $local      = new Memory($serializer);
+        $shared     = new Memory($serializer);
+        $adapter    = new Tiered(
+            $serializer,
+            [
+                'adapters'  => [$local, $shared],
+                'lifetimes' => [5],
+                'writeMode' => 'around',
+            ]
+        );
+
+        $local->set('tiered-key', 'old');
+
+        $adapter->set('tiered-key', 'new');
+
+        $I->assertFalse($local->has('tiered-key'));
+        $I->assertEquals('new', $shared->get('tiered-key'));
+
+        $actual = $adapter->get('tiered-key');
+        $I->assertEquals('new', $actual);
+        $I->assertEquals('new', $local->get('tiered-key'));
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Tiered :: getMultiple()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-24
+     */
+    public function storageAdapterTieredGetMultiple(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Tiered - getMultiple()');
+
+        $serializer = new SerializerFactory();
+        $local      = new Memory($serializer);
+        $shared     = new Memory($serializer);
+        $adapter    = new Tiered(
+            $serializer,
+            [
+                'adapters'  => [$local, $shared],
+                'lifetimes' => [5],
+            ]
+        );
+
+        $local->set('one', 'local-one');
+        $shared->set('one', 'shared-one');
+        $shared->set('two', 'shared-two');
+
+        $expected = [
+            'one'   => 'local-one',
+            'two'   => 'shared-two',
+            'three' => 'default',
+        ];
+        $actual   = $adapter->getMultiple(['one', 'two', 'three'], 'default');
+        $I->assertEquals($expected, $actual);
+
+        $I->assertEquals('shared-two', $local->get('two'));
+    }
+
+    /**
+     * Tests Phalcon\Storage\Adapter\Tiered :: invalidate()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-24
+     */
+    public function storageAdapterTieredInvalidate(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Adapter\Tiered - invalidate()');
+
+        $serializer = new SerializerFactory();
+        $local      = new Memory($serializer);
+        $shared     = new Memory($serializer);
+        $adapter    = new Tiered(
+            $serializer,
+            [
+                'adapters'   => [$local, $shared],
+                'lifetimes'  => [5],
+                'versionKey' => 'tiered-version',
+            ]
+        );
+
+        $adapter->set('tiered-key', 'old');
+
+        /**
+         * Changed by another server
+         */
+        $shared->set('tiered-key', 'new');
+
+        $actual = $adapter->get('tiered-key');
+        $I->assertEquals('old', $actual);
+
+        $actual = $adapter->invalidate();
+        $I->assertTrue($actual);
+
+        $actual = $adapter->get('tiered-key');
+        $I->assertEquals('new', $actual);
+    }
+}
@@ -0,0 +1,133 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Metrics;
+
+use Phalcon\Events\Event;
+use Phalcon\Events\Manager;
+use Phalcon\Storage\Metrics;
+use UnitTester;
+
+class RecordCest
+{
+    /**
+     * Tests Phalcon\Storage\Metrics :: record()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageMetricsRecord(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Metrics - record()');
+
+        $metrics = new Metrics(
+            [
+                'buckets' => [0.01, 0.001],
+            ]
+        );
+
+        $metrics->record('get', 'products-1', 0.0005, true);
+        $metrics->record('get', 'products-2', 0.005, false);
+        $metrics->record('get', 'products-3', 2.0, true);
+        $metrics->record('set', 'users-1', 0.0001);
+        $metrics->record('delete', 'users-1', 0.0001);
+
+        $stats = $metrics->getStats();
+
+        $I->assertEquals(2, $stats['hits']);
+        $I->assertEquals(1, $stats['misses']);
+        $I->assertEquals(1, $stats['sets']);
+        $I->assertEquals(1, $stats['deletes']);
+        $I->assertEquals([0.001, 0.01], $stats['buckets']);
+
+        $entry = $stats['operations']['get']['products'];
+        $I->assertEquals(3, $entry['count']);
+        $I->assertEquals(2.0, $entry['max']);
+        $I->assertEquals([1, 1, 1], $entry['histogram']);
+
+        $I->assertEquals(1, $stats['operations']['set']['users']['count']);
+
+        $I->assertEquals(2 / 3, $metrics->getHitRatio());
+
+        $metrics->reset();
+
+        $I->assertEquals([], $metrics->getStats()['operations']);
+        $I->assertEquals(0.0, $metrics->getHitRatio());
+    }
+
+    /**
+     * Tests Phalcon\Storage\Metrics :: record() - maxPrefixes
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageMetricsRecordMaxPrefixes(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Metrics - record() - maxPrefixes');
+
+        $metrics = new Metrics(
+            [
+                'delimiter'   => ':',
+                'maxPrefixes' => 2,
+            ]
+        );
+
+        $metrics->record('get', 'a:1', 0.001, true);
+        $metrics->record('get', 'b:1', 0.001, true);
+        $metrics->record('get', 'c:1', 0.001, true);
+        $metrics->record('get', 'd:1', 0.001, true);
+
+        $expected = ['a', 'b', '*'];
+        $actual   = array_keys($metrics->getStats()['operations']['get']);
+        $I->assertEquals($expected, $actual);
+
+        $I->assertEquals(2, $metrics->getStats()['operations']['get']['*']['count']);
+    }
+
+    /**
+     * Tests Phalcon\Storage\Metrics :: record() - events
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-26
+     */
+    public function storageMetricsRecordEvents(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Metrics - record() - events');
+
+        $recorded = [];
+        $manager  = new Manager();
+        $manager->attach(
+            'storage:afterOperation',
+            function (Event $event, Metrics $metrics, array $data) use (&$recorded) {
+                $recorded[] = $data;
+            }
+        );
+
+        $metrics = new Metrics();
+        $metrics->setEventsManager($manager);
+
+        $I->assertSame($manager, $metrics->getEventsManager());
+
+        $metrics->record('get', 'products-1', 0.5, false);
+
+        $expected = [
+            [
+                'operation' => 'get',
+                'key'       => 'products-1',
+                'prefix'    => 'products',
+                'duration'  => 0.5,
+                'hit'       => false,
+            ],
+        ];
+        $I->assertEquals($expected, $recorded);
+    }
+}
@@ -0,0 +1,178 @@
+<?php
+declare(strict_types=1);
+
+/**
+ * This file is part of the Phalcon Framework.
+ *
+ * (c) Phalcon Team <team@phalconphp.com>
+ *
+ * For the full copyright and license information, please view the LICENSE.txt
+ * file that was distributed with this source code.
+ */
+
+namespace Phalcon\Test\Unit\Storage\Serializer\Compressed;
+
+use Phalcon\Storage\Exception;
+use Phalcon\Storage\Serializer\Compressed;
+use Phalcon\Storage\Serializer\None;
+use Phalcon\Storage\Serializer\Php;
+use Phalcon\Storage\SerializerFactory;
+use function gzuncompress;
+use function serialize;
+use function str_repeat;
+use UnitTester;
+
+class SerializeCest
+{
+    /**
+     * Tests Phalcon\Storage\Serializer\Compressed :: serialize()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-27
+     */
+    public function storageSerializerCompressedSerialize(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Serializer\Compressed - serialize()');
+
+        $serializer = new Compressed(
+            new Php(),
+            [
+                'threshold' => 100,
+            ]
+        );
+
+        $I->assertEquals('zlib', $serializer->getCompression());
+
+        /**
+         * Below the threshold: as the wrapped serializer returns it, with the
+         * raw format
+         */
+        $serializer->setData('Phalcon Framework');
+
+        $expected = "\x04" . serialize('Phalcon Framework');
+        $actual   = $serializer->serialize();
+        $I->assertEquals($expected, $actual);
+
+        $data = str_repeat('Phalcon Framework ', 100);
+
+        $serializer->setData($data);
+
+        $actual = $serializer->serialize();
+        $I->assertEquals("\x01", $actual[0]);
+        $I->assertLessThan(strlen(serialize($data)), strlen($actual));
+        $I->assertEquals(serialize($data), gzuncompress(substr($actual, 1)));
+
+        $serializer->setData(1234);
+
+        $expected = 1234;
+        $actual   = $serializer->serialize();
+        $I->assertEquals($expected, $actual);
+    }
+
+    /**
+     * Tests Phalcon\Storage\Serializer\Compressed :: unserialize()
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-27
+     */
+    public function storageSerializerCompressedUnserialize(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Serializer\Compressed - unserialize()');
+
+        $serializer = new Compressed(
+            new Php(),
+            [
+                'compression' => 'auto',
+                'threshold'   => 100,
+            ]
+        );
+
+        $data = [
+            'html' => str_repeat('<div class="row">Phalcon</div>', 200),
+        ];
+
+        $serializer->setData($data);
+
+        $payload = $serializer->serialize();
+
+        $serializer->setData(null);
+        $serializer->unserialize($payload);
+
+        $actual = $serializer->getData();
+        $I->assertEquals($data, $actual);
+
+        /**
+         * Entries written without compression
+         */
+        $serializer->unserialize(serialize($data));
+
+        $actual = $serializer->getData();
+        $I->assertEquals($data, $actual);
+
+        /**
+         * Small payloads starting with a format byte are kept as they are
+         */
+        $serializer = new Compressed(
+            new None(),
+            [
+                'threshold' => 100,
+            ]
+        );
+
+        $serializer->setData("\x01data");
+
+        $payload = $serializer->serialize();
+
+        $serializer->setData(null);
+        $serializer->unserialize($payload);
+
+        $expected = "\x01data";
+        $actual   = $serializer->getData();
+        $I->assertEquals($expected, $actual);
+    }
+
+    /**
+     * Tests Phalcon\Storage\Serializer\Compressed :: serialize() - factory
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-27
+     */
+    public function storageSerializerCompressedSerializeFactory(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Serializer\Compressed - serialize() - factory');
+
+        $factory = new SerializerFactory();
+        $I->assertFalse($factory->hasCompression());
+        $I->assertInstanceOf(Php::class, $factory->newInstance('php'));
+
+        $factory = new SerializerFactory([], ['compression' => 'zlib']);
+        $I->assertTrue($factory->hasCompression());
+
+        $serializer = $factory->newInstance('php');
+        $I->assertInstanceOf(Compressed::class, $serializer);
+        $I->assertInstanceOf(Php::class, $serializer->getSerializer());
+    }
+
+    /**
+     * Tests Phalcon\Storage\Serializer\Compressed :: __construct() - exception
+     *
+     * @author Phalcon Team <team@phalconphp.com>
+     * @since  2019-05-27
+     */
+    public function storageSerializerCompressedConstructException(UnitTester $I)
+    {
+        $I->wantToTest('Storage\Serializer\Compressed - __construct() - exception');
+
+        $I->expectThrowable(
+            new Exception('Compression brotli is not supported'),
+            function () {
+                $serializer = new Compressed(
+                    new Php(),
+                    [
+                        'compression' => 'brotli',
+                    ]
+                );
+            }
+        );
+    }
+}